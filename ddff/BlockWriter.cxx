@@ -0,0 +1,189 @@
+/* ------------------------------------------------------------------   */
+/*      item            : BlockWriter.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define BlockWriter_cxx
+#include "BlockWriter.hxx"
+#include "DDFFExceptions.hxx"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <errno.h>
+#include <cstring>
+#include <algorithm>
+#include <debug.h>
+
+#define DEBPRINTLEVEL -1
+#include <debprint.h>
+
+DDFF_NS_START
+
+// write a series of vectors completely, resuming after partial writes
+static bool writeAll(int fd, struct iovec* iov, int n, off_t offset)
+{
+  while (n) {
+    ssize_t res = pwritev(fd, iov, n, offset);
+    if (res < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    offset += res;
+    while (n && size_t(res) >= iov->iov_len) {
+      res -= iov->iov_len;
+      iov++; n--;
+    }
+    if (n) {
+      iov->iov_base = reinterpret_cast<char*>(iov->iov_base) + res;
+      iov->iov_len -= res;
+    }
+  }
+  return true;
+}
+
+BlockWriter::BlockWriter(const std::string& fname) :
+  fd(::open(fname.c_str(), O_WRONLY | O_CLOEXEC)),
+  pool(),
+  jobs(),
+  outstanding(0U),
+  stop(false),
+  failed_offset(-1),
+  lock(),
+  work(),
+  done(),
+  writer()
+{
+  if (fd == -1) {
+    /* DUECA ddff.
+
+       Cannot open the ddff file for asynchronous writing. */
+    E_XTR("Cannot open " << fname << " for writing, " << strerror(errno));
+    throw file_write_error();
+  }
+  writer = std::thread(&BlockWriter::run, this);
+}
+
+BlockWriter::~BlockWriter()
+{
+  {
+    std::unique_lock<std::mutex> l(lock);
+    stop = true;
+  }
+  work.notify_one();
+  writer.join();
+  ::close(fd);
+
+  if (failed_offset != -1) {
+    /* DUECA ddff.
+
+       A write to the ddff file failed, and could not be reported
+       earlier. Check disk space and the file system. */
+    E_XTR("Write failure at offset " << failed_offset << " not reported");
+  }
+  for (auto &sz: pool) {
+    for (auto b: sz.second) { delete[] b; }
+  }
+}
+
+void BlockWriter::checkFailure()
+{
+  if (failed_offset != -1) {
+    pos_type off = failed_offset;
+    failed_offset = -1;
+    throw file_write_error(off);
+  }
+}
+
+void BlockWriter::write(pos_type offset, const char* data, size_t size)
+{
+  std::unique_lock<std::mutex> l(lock);
+  checkFailure();
+
+  // get a spare buffer of the right size
+  char* buf;
+  auto &spares = pool[size];
+  if (spares.size()) {
+    buf = spares.back();
+    spares.pop_back();
+  }
+  else {
+    buf = new char[size];
+  }
+  std::memcpy(buf, data, size);
+
+  const bool wake = jobs.empty();
+  jobs.push_back(Job{offset, size, buf});
+  outstanding++;
+  l.unlock();
+
+  if (wake) work.notify_one();
+}
+
+void BlockWriter::drain()
+{
+  std::unique_lock<std::mutex> l(lock);
+  done.wait(l, [this]{ return outstanding == 0U; });
+  checkFailure();
+}
+
+void BlockWriter::run()
+{
+  std::deque<Job> todo;
+  std::vector<struct iovec> iov;
+
+  std::unique_lock<std::mutex> l(lock);
+  while (true) {
+    work.wait(l, [this]{ return stop || !jobs.empty(); });
+    if (jobs.empty()) break;
+
+    // take all current work, write without holding the lock
+    todo.swap(jobs);
+    l.unlock();
+
+    size_t ii = 0;
+    while (ii < todo.size()) {
+
+      // combine jobs for consecutive locations
+      iov.clear();
+      pos_type end = todo[ii].offset;
+      size_t jj = ii;
+      while (jj < todo.size() && todo[jj].offset == end &&
+             iov.size() < IOV_MAX) {
+        iov.push_back(iovec{todo[jj].data, todo[jj].size});
+        end += todo[jj].size;
+        jj++;
+      }
+
+      DEB("BlockWriter, " << iov.size() << " blocks at 0x" << std::hex <<
+          todo[ii].offset << std::dec);
+      if (!writeAll(fd, iov.data(), iov.size(), todo[ii].offset)) {
+        std::unique_lock<std::mutex> f(lock);
+        if (failed_offset == -1) {
+          failed_offset = todo[ii].offset;
+        }
+      }
+      ii = jj;
+    }
+
+    // recycle the buffers, and report completion
+    l.lock();
+    for (const auto &j: todo) {
+      pool[j.size].push_back(j.data);
+    }
+    outstanding -= todo.size();
+    todo.clear();
+    done.notify_all();
+  }
+}
+
+DDFF_NS_END
@@ -0,0 +1,122 @@
+/* ------------------------------------------------------------------   */
+/*      item            : BlockWriter.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Asynchronous writing of ddff file blocks
+        changes         : 261017 first version
+        language        : C++
+        api             : DUECA_API
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#ifndef BlockWriter_hxx
+#define BlockWriter_hxx
+
+#include "ddff_ns.h"
+#include <string>
+#include <deque>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <ios>
+
+DDFF_NS_START
+
+/** Asynchronous writer for the blocks of a ddff file.
+
+    Normally, the FileHandler writes its blocks with its fstream, in
+    the thread that calls FileHandler::processWrites(). When the
+    operating system flushes its page cache, these writes may block
+    for a considerable time. The BlockWriter copies the data into a
+    pool of buffers, and a separate writer thread writes these to
+    file with pwritev, combining writes to consecutive file locations
+    into a single call.
+
+    Writes are performed in the order in which they are given. Before
+    reading back data from the file, call drain().
+
+    Write errors are detected in the writer thread, and reported with
+    a file_write_error exception at the next write() or drain() call.
+*/
+class BlockWriter
+{
+public:
+  /** Position type, as in the FileHandler */
+  typedef std::ios::off_type pos_type;
+
+private:
+  /** A single write job */
+  struct Job {
+    /** Location in the file */
+    pos_type                                          offset;
+    /** Number of bytes */
+    size_t                                            size;
+    /** Copy of the data */
+    char*                                             data;
+  };
+
+  /** File descriptor */
+  int                                                 fd;
+
+  /** Spare buffers, by size */
+  std::map<size_t,std::vector<char*> >                pool;
+
+  /** Jobs waiting for the writer thread */
+  std::deque<Job>                                     jobs;
+
+  /** Number of jobs not yet completed */
+  unsigned                                            outstanding;
+
+  /** Stop flag for the writer thread */
+  bool                                                stop;
+
+  /** Offset of a failed write, -1 if none */
+  pos_type                                            failed_offset;
+
+  /** Protection of jobs, pool and flags */
+  std::mutex                                          lock;
+
+  /** Wakes the writer thread */
+  std::condition_variable                             work;
+
+  /** Signals completion of writes */
+  std::condition_variable                             done;
+
+  /** Writer thread */
+  std::thread                                         writer;
+
+  /** Writer thread function */
+  void run();
+
+  /** Throw if a write failed, lock must be held */
+  void checkFailure();
+
+public:
+  /** Constructor.
+
+      @param fname   Name of the file, which must exist.
+  */
+  BlockWriter(const std::string& fname);
+
+  /** Destructor, completes all writes */
+  ~BlockWriter();
+
+  /** Write data at a given location. The data is copied.
+
+      @param offset  Location in the file.
+      @param data    Data to write.
+      @param size    Number of bytes.
+  */
+  void write(pos_type offset, const char* data, size_t size);
+
+  /** Wait until all given writes are in the file. */
+  void drain();
+};
+
+DDFF_NS_END
+
+#endif
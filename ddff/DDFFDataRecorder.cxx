@@ -37,6 +37,7 @@ DDFFDataRecorder::DDFFDataRecorder() :
   data_class(),
   stretch_offset(ddff::FileHandler::pos_type(0)),
   r_stream(),
+  record_span(0, MAX_TIMETICK),
   record_functor(),
   replay_functor(),
   w_token_ptr(NULL),
@@ -44,6 +45,7 @@ DDFFDataRecorder::DDFFDataRecorder() :
   replay_tick(MAX_TIMETICK),
   replay_span(0),
   replay_start_tick(MAX_TIMETICK),
+  replay_from(0U),
   rit0()
 {
   //
@@ -188,7 +190,7 @@ bool DDFFDataRecorder::isValid()
 	w_token_ptr->getMetaFunctor<ddff::DDFFDCOMetaFunctor>("msgpack");
 
       record_functor.reset(metafunctor.lock()->getReadFunctor
-			   (w_stream, filer->getRunTimeSpec()));
+			   (w_stream, &record_span));
       // reads data, writes channel, does not read the timing information from
       // the data
       replay_functor.reset(metafunctor.lock()->getWriteFunctor(false));
@@ -227,11 +229,14 @@ void DDFFDataRecorder::channelRecord(const DataTimeSpec& ts,
     dirty = true;
 
     // indicate start points, one for each block, for complete sets of
-    // data
-    w_stream->markItemStart();
+    // data, with the tick, relative to the stretch start, for the
+    // time index
+    w_stream->markItemStart(ts.getValidityStart() - record_start_tick);
 
-    // packs the object and the ticks
-    (*record_functor)(writer.getObjectPtr(), ts);
+    // packs the object and the ticks, also relative to the stretch start
+    (*record_functor)(writer.getObjectPtr(),
+                      DataTimeSpec(ts.getValidityStart() - record_start_tick,
+                                   ts.getValidityEnd() - record_start_tick));
 
     // record end tick
     marked_tick = ts.getValidityEnd();
@@ -309,19 +314,44 @@ void DDFFDataRecorder::checkIn(pointer rec, const std::string& entity)
 }
 
 void DDFFDataRecorder::spoolReplay(ddff::FileHandler::pos_type offset,
-                               ddff::FileHandler::pos_type end_offset)
+                                   ddff::FileHandler::pos_type end_offset,
+                                   TimeTickType from_tick)
 {
   r_stream->setReadRange(offset, end_offset);
   replay_start_tick = 0;
   replay_tick = MAX_TIMETICK;
+  replay_from = from_tick;
   DEB("Replay spooling to range 0x" << std::hex << offset
-      << " - 0x" << end_offset << std::dec);
+      << " - 0x" << end_offset << std::dec << " from tick " << from_tick);
 }
 
 void DDFFDataRecorder::startReplay(TimeTickType tick)
 {
-  replay_start_tick = tick;
+  replay_start_tick = tick - replay_from;
   rit0 = r_stream->iterator();
+
+  // the spooled position may be before the replay start, skip that data
+  try {
+    while (replay_from && rit0 != r_stream->end()) {
+      unsigned sz =
+        msgunpack::unstream<ddff::FileStreamRead::Iterator>::unpack_arraysize
+        (rit0, r_stream->end());
+      assert(sz == 3);
+      msgunpack::msg_unpack(rit0, r_stream->end(), replay_tick);
+      msgunpack::msg_unpack(rit0, r_stream->end(), replay_span);
+      if (replay_tick >= replay_from) {
+        replay_tick += replay_start_tick;
+        break;
+      }
+      msgunpack::msg_skip(rit0, r_stream->end());
+      replay_tick = MAX_TIMETICK;
+    }
+  }
+  catch (const std::exception& e) {
+    DEB("Replay, could not skip to tick " << replay_from);
+    replay_tick = MAX_TIMETICK;
+  }
+
   if (replay_functor) { replay_functor->setIterator(rit0); }
   DEB("Replay start planned for time " << tick);
 }
@@ -151,6 +151,11 @@ private:
   /** Functor - if applicable, for recording/reading written data */
   boost::scoped_ptr<ddff::DDFFDCOReadFunctor>   record_functor;
 
+  /** Span given to the record functor. Ticks are passed to the
+      functor relative to the stretch start, so it packs the same
+      relative ticks as the record call does. */
+  DataTimeSpec                                  record_span;
+
   /** Functor - if applicable, for re-writing the data */
   boost::scoped_ptr<ddff::DDFFDCOWriteFunctor>  replay_functor;
 
@@ -169,6 +174,9 @@ private:
   /** Value used for replay timing */
   TimeTickType                                  replay_start_tick;
 
+  /** Recorded time tick from which replay starts */
+  TimeTickType                                  replay_from;
+
   /** Iterator for reading the data */
   ddff::FileStreamRead::Iterator                rit0;
 
@@ -334,8 +342,8 @@ public:
       dirty = true;
 
       // indicate start points, one for each block, for complete sets of
-      // data
-      w_stream->markItemStart();
+      // data, with the tick for the time index
+      w_stream->markItemStart(ts.getValidityStart() - record_start_tick);
 
       // packing object
       msgpack::packer<ddff::FileStreamWrite> pk(*w_stream);
@@ -423,9 +431,11 @@ public:
 
       @param offset     Location in file where data starts
       @param end_offset Location in file where data ends.
+      @param from_tick  Recorded time tick from which to replay.
    */
   void spoolReplay(ddff::FileHandler::pos_type offset,
-                   ddff::FileHandler::pos_type end_offset) final;
+                   ddff::FileHandler::pos_type end_offset,
+                   TimeTickType from_tick = 0U) final;
 
 
 private:
@@ -23,6 +23,12 @@ file_read_error::file_read_error(unsigned long offset) :
   snprintf(str, sizeof(str), "Read error with offset %lu", offset);
 }
 
+file_write_error::file_write_error(unsigned long offset) :
+  std::exception()
+{
+  snprintf(str, sizeof(str), "Write error with offset %lu", offset);
+}
+
 block_crc_error::block_crc_error(uint64_t offset, uint32_t size) :
   std::exception()
 {
@@ -36,6 +36,20 @@ public:
   file_read_error(unsigned long offset=0);
 };
 
+/** Exception information */
+class file_write_error: public std::exception
+{
+  /** Error string */
+  char str[64];
+
+public:
+  /** Re-implementation of std:exception what. */
+  const char* what() const throw() {return str; }
+
+  /** Constructor */
+  file_write_error(unsigned long offset=0);
+};
+
 /** Exception information */
 class block_crc_error: public std::exception
 {
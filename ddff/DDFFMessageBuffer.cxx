@@ -38,7 +38,9 @@ DDFFMessageBuffer::DDFFMessageBuffer(size_t size, size_t offset) :
   fill(0U),
   object_offset(0U),
   stream_id(0xffffffff),
+  item_tick(0xffffffff),
   buffer(new char[capacity]),
+  storage(buffer),
   creation_id(creation_count++)
 {
   DEB("DDFFMessageBuffer, creating id=" << creation_id << " size " << size);
@@ -53,6 +55,8 @@ DDFFMessageBuffer& DDFFMessageBuffer::operator=(const DDFFMessageBuffer& o)
     this->fill = o.fill;
     this->object_offset = o.object_offset;
     this->stream_id = o.stream_id;
+    this->item_tick = o.item_tick;
+    this->buffer = this->storage;
     std::copy(o.buffer, o.buffer + o.fill, this->buffer);
   }
 
@@ -65,11 +69,13 @@ void  DDFFMessageBuffer::reset()
   this->fill = 0;
   this->object_offset = 0;
   this->stream_id = 0xffffffff;
+  this->item_tick = 0xffffffff;
+  this->buffer = this->storage;
 }
 
 DDFFMessageBuffer::~DDFFMessageBuffer()
 {
-  delete [] buffer;
+  delete [] storage;
   DEB("DDFFMessageBuffer, deleting id=" << creation_id);
 }
 
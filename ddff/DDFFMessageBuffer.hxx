@@ -45,9 +45,16 @@ struct DDFFMessageBuffer
   /** Stream ID for this buffer */
   uint32_t stream_id;
 
-  /** Buffer itself */
+  /** Time tick of the object at object_offset, if given, for time
+      indexing of the data */
+  uint32_t item_tick;
+
+  /** Buffer itself, or a block of memory-mapped file data */
   char *buffer;
 
+  /** Own memory for the buffer */
+  char *storage;
+
   /** A count, identifying each buffer, for debug purposes */
   static unsigned creation_count;
 
@@ -88,6 +95,17 @@ public:
   /** Get the current data pointer */
   inline const char* current() { return &buffer[object_offset]; }
 
+  /** Use read-only, memory-mapped file data instead of own memory.
+      The mapped data must have the buffer's capacity, and may not be
+      written. */
+  inline void mapTo(const char* data) { buffer = const_cast<char*>(data); }
+
+  /** Return to using the buffer's own memory */
+  inline void unmap() { buffer = storage; }
+
+  /** Check whether the buffer refers to mapped file data */
+  inline bool isMapped() const { return buffer != storage; }
+
 private:
   /** Copy constructor */
   DDFFMessageBuffer(const DDFFMessageBuffer& o);
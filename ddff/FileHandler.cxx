@@ -16,7 +16,15 @@
 #include "FileHandler.hxx"
 #include "DDFFExceptions.hxx"
 #include "ControlBlock.hxx"
+#include "BlockWriter.hxx"
 #include <boost/filesystem.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <cstring>
 #include <debug.h>
 
 #define DEBPRINTLEVEL -1
@@ -33,7 +41,11 @@ FileHandler::FileHandler(const std::string& fname, Mode mode,
   offset(0),
   file(),
   open_mode(Mode::New),  // re-written at the open call
-  file_existing(false)
+  file_existing(false),
+  block_writer(),
+  mapping{NULL, 0U, 0U},
+  mapped_reading(false),
+  sequential_reading(false)
 {
   this->open(fname, mode, blocksize);
 }
@@ -46,7 +58,11 @@ FileHandler::FileHandler() :
   offset(0),
   file(),
   open_mode(Mode::New),
-  file_existing(false)
+  file_existing(false),
+  block_writer(),
+  mapping{NULL, 0U, 0U},
+  mapped_reading(false),
+  sequential_reading(false)
 {
   //
 }
@@ -83,7 +99,9 @@ FileHandler::~FileHandler()
 {
   syncToFile(false);
 
-  // close the file
+  // complete any asynchronous writing, close the file
+  block_writer.reset();
+  unmapFile();
   file.close();
 }
 
@@ -92,6 +110,118 @@ bool FileHandler::isComplete() const
   return filename.size() > 0;
 }
 
+void FileHandler::setAsyncWriting(bool async)
+{
+  if (async && !block_writer) {
+    if (open_mode == Mode::Read) {
+      throw(file_readonly_no_write());
+    }
+
+    // all previous data must be out of the fstream buffer
+    file.flush();
+    block_writer.reset(new BlockWriter(filename));
+  }
+  else if (!async && block_writer) {
+    block_writer.reset();
+  }
+}
+
+void FileHandler::setMappedReading(bool mapped, bool sequential)
+{
+  mapped_reading = mapped;
+  sequential_reading = sequential;
+}
+
+void FileHandler::unmapFile()
+{
+  if (mapping.data) {
+    ::munmap(mapping.data, mapping.reserved);
+  }
+  mapping = FileMapping{NULL, 0U, 0U};
+}
+
+/** Address range reserved for mapping a file */
+static const size_t map_reserve =
+  sizeof(void*) > 4U ? size_t(1) << 38 : size_t(1) << 29;
+
+const char* FileHandler::mappedBlock(pos_type at, size_t size)
+{
+  if (size_t(at) + size > mapping.size) {
+
+    // map the part of the file added since the previous call
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      /* DUECA ddff.
+
+         Cannot open the ddff file for mapping, data is read with
+         normal file access. */
+      W_XTR("Cannot open " << filename << " for mapping, " <<
+            strerror(errno));
+      mapped_reading = false;
+      return NULL;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == -1 || size_t(at) + size > size_t(st.st_size)) {
+      ::close(fd);
+      return NULL;
+    }
+
+    // reserve an address range, once
+    if (mapping.data == NULL) {
+      void* range = ::mmap(NULL, map_reserve, PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                           -1, 0);
+      if (range != MAP_FAILED) {
+        mapping = FileMapping{reinterpret_cast<char*>(range), 0U,
+                              map_reserve};
+      }
+    }
+
+    // start at the page holding the current end, replacing that page
+    static const size_t pagesize = sysconf(_SC_PAGESIZE);
+    const size_t from = mapping.size - mapping.size % pagesize;
+    void* data = MAP_FAILED;
+    if (mapping.data && size_t(st.st_size) <= mapping.reserved) {
+      data = ::mmap(mapping.data + from, st.st_size - from, PROT_READ,
+                    MAP_SHARED | MAP_FIXED, fd, from);
+    }
+    ::close(fd);
+    if (data == MAP_FAILED) {
+      /* DUECA ddff.
+
+         Cannot map the ddff file, data is read with normal file
+         access. */
+      W_XTR("Cannot map " << filename << ", " << strerror(errno));
+      mapped_reading = false;
+      return NULL;
+    }
+    if (sequential_reading) {
+      ::madvise(data, st.st_size - from, MADV_SEQUENTIAL);
+    }
+    DEB("Mapped " << filename << " size " << st.st_size);
+    mapping.size = st.st_size;
+  }
+  return mapping.data + at;
+}
+
+void FileHandler::writeData(pos_type at, const char* data, size_t size)
+{
+  if (block_writer) {
+    block_writer->write(at, data, size);
+  }
+  else {
+    file.seekp(at, std::ios::beg);
+    file.write(data, size);
+  }
+}
+
+void FileHandler::drainWrites()
+{
+  if (block_writer) {
+    block_writer->drain();
+  }
+}
+
 void FileHandler::syncToFile(bool intermediate)
 {
   DEB("FileHandler, syncing, im=" << intermediate);
@@ -138,6 +268,7 @@ FileStreamWrite::pointer FileHandler::attachWrite(unsigned sid, size_t bufsize)
        (this, streams.size(), bufsize ? bufsize : blocksize));
   }
   else {
+    drainWrites();
     streams[sid].setWriter(this, sid, bufsize, file);
   }
 
@@ -169,6 +300,8 @@ FileStreamRead::pointer FileHandler::createRead(unsigned stream_id,
 
 void FileHandler::checkIndices(pos_type offset)
 {
+  drainWrites();
+
   // run through the file, analysing the block information
   // read the first job
   file.seekg(offset, std::ios::beg);
@@ -237,10 +370,8 @@ unsigned FileHandler::processWrites()
       write_jobs.front()->getBufferToWrite();
 
     // only if re-writing a buffer
-    if (write_jobs.front()->shiftOffset(file)) {
-
-      // where is the file now??
-      pos_type tmpoffset = file.tellg();
+    pos_type tmpoffset;
+    if (write_jobs.front()->shiftOffset(tmpoffset)) {
 
 #if DEBPRINTLEVEL >= 0
       ControlBlockRead head(*buffer, tmpoffset);
@@ -254,7 +385,7 @@ unsigned FileHandler::processWrites()
 #endif
 
       // write the data at the new offset
-      file.write(buffer->data(), buffer->capacity);
+      writeData(tmpoffset, buffer->data(), buffer->capacity);
 
       // callback the client with information on the location/buffer
       bufferWriteInformation(tmpoffset, buffer);
@@ -264,9 +395,6 @@ unsigned FileHandler::processWrites()
       if (buffer->partial()) {
         write_jobs.front()->recordOffsetForRewrite(tmpoffset);
       }
-
-      // reset to the stream_idal end of the file
-      file.seekg(offset, std::ios::beg);
     }
     else {
 
@@ -282,7 +410,7 @@ unsigned FileHandler::processWrites()
 #endif
 
       // simply write at the end of the file
-      file.write(buffer->data(), buffer->capacity);
+      writeData(offset, buffer->data(), buffer->capacity);
 
       // callback the client with information on the location/buffer
       bufferWriteInformation(offset, buffer);
@@ -296,9 +424,15 @@ unsigned FileHandler::processWrites()
       assert(streams.size() > buffer->stream_id);
       streams[buffer->stream_id].blockWritten(offset);
 
-      // writes the offset index, if this had a previous block, and records
-      // the current offset index for the stream
-      write_jobs.front()->blockWritten(offset, file);
+      // records the current offset index for the stream, and if this
+      // had a previous block, write the link to this block there
+      pos_type previous = write_jobs.front()->blockWritten(offset);
+      if (previous != pos_type(-1)) {
+        char link[8];
+        AmorphStore tmp(link, sizeof(link));
+        tmp.packData(int64_t(offset));
+        writeData(previous, link, sizeof(link));
+      }
 
       // now step to the next write spot
       offset += buffer->capacity;
@@ -309,7 +443,9 @@ unsigned FileHandler::processWrites()
     write_jobs.pop();
     nwrites++;
   }
-  file.flush();
+  if (!block_writer) {
+    file.flush();
+  }
   return nwrites;
 }
 
@@ -326,6 +462,12 @@ void FileHandler::requestLoad(FileStreamRead::pointer fsr, pos_type offset,
 
 void FileHandler::runLoads()
 {
+  // written data must be in the file
+  if (read_jobs.notEmpty()) {
+    drainWrites();
+    if (mapped_reading) { file.flush(); }
+  }
+
   // try to clear the errors
   file.clear();
   
@@ -339,13 +481,21 @@ void FileHandler::runLoads()
     DEB("Loading for stream " << job.data().reader->getStreamId()
         << " at 0x" <<   std::hex << offset << std::dec);
 
-    file.seekg(offset, std::ios::beg);
-
-    // get a buffer to fill, and read from file
+    // get a buffer to fill, and read from file, or point it to the
+    // mapped file data
     AQMTMessageBufferAlloc::element_ptr buffer =
       job.data().reader->getBufferToLoad();
     assert(buffer->data.capacity > 0);
-    file.read(buffer->data.data(), buffer->data.capacity);
+    const char* block = mapped_reading ?
+      mappedBlock(offset, buffer->data.capacity) : NULL;
+    if (block) {
+      buffer->data.mapTo(block);
+    }
+    else {
+      buffer->data.unmap();
+      file.seekg(offset, std::ios::beg);
+      file.read(buffer->data.data(), buffer->data.capacity);
+    }
 
     // decode the control block, throws if checksum wrong, sets the buffer
     ControlBlockRead hdata(buffer->data, job.data().offset);
@@ -367,6 +517,18 @@ void FileHandler::runLoads()
       throw file_wrong_streamid();
     }
 
+    // hint for the stream's next block
+    if (block && hdata.next_offset > pos_type(offset) &&
+        size_t(hdata.next_offset) + buffer->data.capacity <=
+        mapping.size) {
+      static const uintptr_t pagemask = ~uintptr_t(sysconf(_SC_PAGESIZE) - 1);
+      char* start = mapping.data + hdata.next_offset;
+      char* pstart = reinterpret_cast<char*>
+        (reinterpret_cast<uintptr_t>(start) & pagemask);
+      ::madvise(pstart, start - pstart + buffer->data.capacity,
+                MADV_WILLNEED);
+    }
+
     // return the results
     job.data().reader->appendBuffer
       (buffer, offset, hdata.next_offset, hdata.block_num, job.data().cycle);
@@ -25,11 +25,13 @@
 #include <boost/smart_ptr/intrusive_ref_counter.hpp>
 #include <list>
 #include <vector>
+#include <memory>
 
 DDFF_NS_START
 
 class FileStreamWrite;
 class FileStreamRead;
+class BlockWriter;
 
 /** Object to open and manage a logging file, low-level API.
 
@@ -97,6 +99,25 @@ class FileStreamRead;
     can be defined by the application. This should enable partial
     recovery of data in the case of data corruption.
 
+    ## Asynchronous writing
+
+    With setAsyncWriting(), block writes are handed to a BlockWriter,
+    which writes the data in a separate thread. processWrites() then
+    no longer blocks on the file system.
+
+    ## Memory-mapped reading
+
+    With setMappedReading(), runLoads() no longer copies blocks into
+    the read buffers; the buffers then point into a read-only mapping
+    of the file, and the FileStreamRead iterators run over the file
+    data in place. The checksum test still touches the complete block
+    in runLoads(), so page faults occur there and not in the iterator.
+    Each loaded block is followed by an madvise "willneed" hint for
+    the stream's next block. The file is mapped into a reserved
+    address range, and when the file grows the added part is mapped
+    behind the existing part. Data obtained from mapped buffers is
+    only valid as long as the FileHandler exists.
+
  */
 class FileHandler: public boost::intrusive_ref_counter<ddff::FileHandler>
 {
@@ -211,6 +232,43 @@ protected:
 
   /** Is this a new file ?*/
   bool                                                file_existing;
+
+  /** Asynchronous writer, if used */
+  std::unique_ptr<BlockWriter>                        block_writer;
+
+  /** Write data to the file, directly or through the block writer */
+  void writeData(pos_type at, const char* data, size_t size);
+
+  /** Complete asynchronous writes, before reading from the file */
+  void drainWrites();
+
+  /** A read-only mapping of the file, in a reserved address range */
+  struct FileMapping {
+    /** Start of the mapped data, NULL if not mapped */
+    char*                                             data;
+    /** Mapped size of the file */
+    size_t                                            size;
+    /** Size of the reserved address range */
+    size_t                                            reserved;
+  };
+
+  /** Mapping of the file. When the file grows, the added part is
+      mapped behind the existing part, in the same address range, so
+      loaded buffers remain valid. */
+  FileMapping                                         mapping;
+
+  /** Read blocks through the file mapping */
+  bool                                                mapped_reading;
+
+  /** Advise sequential access for the mapping */
+  bool                                                sequential_reading;
+
+  /** Return the mapped data for a block, or NULL if it is not in the
+      file (yet) */
+  const char* mappedBlock(pos_type at, size_t size);
+
+  /** Remove the file mapping */
+  void unmapFile();
 public:
 
   /** Constructor for an object managing a ddff log file
@@ -286,6 +344,26 @@ public:
   /** return the blocksize used in this file */
   inline unsigned getBlockSize() const { return blocksize; }
 
+  /** Write blocks asynchronously, in a separate writer thread.
+
+      @param async   If true, start asynchronous writing, if false,
+                     complete pending writes and write blocks directly
+                     again. */
+  void setAsyncWriting(bool async);
+
+  /** Read blocks from a memory mapping of the file, instead of
+      copying these into the read buffers.
+
+      @param mapped     If true, use the mapping for subsequent
+                        loads.
+      @param sequential Hint that the file is mostly read from start
+                        to end, as in offline analysis. */
+  void setMappedReading(bool mapped, bool sequential=false);
+
+  /** Size of the file part mapped for reading, 0 if no blocks were
+      read through a mapping */
+  inline size_t getMappedSize() const { return mapping.size; }
+
 private:
   /** Calls for fileStreamWrite */
   friend class FileStreamWrite;
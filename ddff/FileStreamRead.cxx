@@ -330,6 +330,7 @@ void FileStreamRead::resetRead()
   end_offset = std::numeric_limits<pos_type>::max();
   while(buffers.notEmpty()) { buffers.pop(); }
   while(indices.notEmpty()) { indices.pop(); }
+  first_buffer_load = true;
   DEB("FileStreamRead reset " << getStreamId());
 }
 
@@ -342,6 +343,9 @@ void FileStreamRead::setReadRange(pos_type offset, pos_type end_off)
   while(buffers.notEmpty()) { buffers.pop(); }
   while(indices.notEmpty()) { indices.pop(); }
 
+  // the first buffer of the new range needs the object offset adjusted
+  first_buffer_load = true;
+
   // load the given offset into the indices
   pos_type rounded_offset = offset - offset % buffers.allocator.bufsize;
   DEB("After read range set, streamid=" << this->getStreamId() <<
@@ -66,22 +66,17 @@ void FileStreamWrite::initBuffers(size_t bufsize)
   // data, and reset to the proper state
 }
 
-void FileStreamWrite::blockWritten(pos_type offset, std::fstream &file)
+FileStreamWrite::pos_type FileStreamWrite::blockWritten(pos_type offset)
 {
   linked_to_file = true;
-  if (previousblock_offset != -1L) {
+  pos_type previous = previousblock_offset;
+  if (previous != -1L) {
     DEB("FileStreamWrite stream=" << getStreamId() << " linking block at 0x"
                                   << std::hex << previousblock_offset
                                   << " to 0x" << offset << std::dec);
-    pos_type tmpoffset = file.tellg();
-    file.seekg(previousblock_offset, std::ios::beg);
-    char data[8];
-    AmorphStore tmp(data, sizeof(data));
-    tmp.packData(int64_t(offset));
-    file.write(data, sizeof(data));
-    file.seekg(tmpoffset, std::ios::beg);
   }
   previousblock_offset = offset;
+  return previous;
 }
 
 FileStreamWrite::~FileStreamWrite()
@@ -249,7 +244,7 @@ void FileStreamWrite::writingComplete()
   buffers.pop();
 }
 
-bool FileStreamWrite::shiftOffset(std::fstream &file)
+bool FileStreamWrite::shiftOffset(pos_type &offset)
 {
   if (partialblock_offset == pos_type(-1)) {
     return false;
@@ -258,7 +253,7 @@ bool FileStreamWrite::shiftOffset(std::fstream &file)
   DEB1("FileStreamWrite, shiftoffset to 0x" << std::hex << partialblock_offset
                                             << std::dec << " stream "
                                             << stream_id);
-  file.seekg(partialblock_offset, std::ios::beg);
+  offset = partialblock_offset;
   partialblock_offset = pos_type(-1);
   return true;
 }
@@ -284,9 +279,19 @@ bool FileStreamWrite::markItemStart()
   DEB1("FileStreamWrite, marking start of an object, stream="
        << stream_id << " at " << current_buffer->data.fill);
   current_buffer->data.object_offset = current_buffer->data.fill;
+  current_buffer->data.item_tick = MAX_TIMETICK;
   return true;
 }
 
+bool FileStreamWrite::markItemStart(TimeTickType tick)
+{
+  if (markItemStart()) {
+    current_buffer->data.item_tick = tick;
+    return true;
+  }
+  return false;
+}
+
 void FileStreamWrite::recordOffsetForRewrite(uint64_t offset)
 {
   assert(partialblock_offset == pos_type(-1));
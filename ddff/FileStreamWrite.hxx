@@ -158,8 +158,12 @@ private:
   /** Initialise the write buffers */
   void initBuffers(size_t bufsize);
 
-  /** writing callback */
-  void blockWritten(pos_type offset, std::fstream& fl);
+  /** writing callback
+
+      @param offset   Location where the block has been written
+      @returns        Location of the previous block of the stream, which
+                      needs a link to this block, or -1 if none. */
+  pos_type blockWritten(pos_type offset);
 
   /** Remember the offset for an incomplete, and later to complete, block.
 
@@ -170,16 +174,15 @@ private:
    */
   void recordOffsetForRewrite(uint64_t offset);
 
-  /** Shift the writing pointer in the file.
+  /** Get the writing location for a re-written block.
 
       If a replacement for an incomplete block is complete, this call
-      uses the remembered offset from recordOffsetForRewrite to reset
-      the file pointer.
+      returns the remembered offset from recordOffsetForRewrite.
 
-      @param file     File to modify with seekg
-      @returns        True if modifying file pointer
+      @param offset   Location of the block to re-write
+      @returns        True if the block is to be re-written
   */
-  bool shiftOffset(std::fstream& file);
+  bool shiftOffset(pos_type& offset);
 
   /** read the data for the last buffer on a file */
   DDFFMessageBuffer::value_type *accessBuffer(pos_type offset,
@@ -264,6 +267,19 @@ public:
   bool markItemStart(TimeTickType& start_stretch,
                      const DataTimeSpec& ts);
 
+  /** Mark a start point for the next item to write, and remember its
+      time tick.
+
+      When this is the first marked item in the buffer, the tick is
+      passed with the buffer to FileHandler::bufferWriteInformation,
+      which can use it to build a time index of the stream.
+
+      @param  tick           Time tick, as stored with the item.
+      @returns true if this was the first marked item in the buffer,
+      false if a previously marked item is present
+  */
+  bool markItemStart(TimeTickType tick);
+
   /** "stream" interface for msgpack
 
       @param data      Data to be written
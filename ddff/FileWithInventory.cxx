@@ -86,7 +86,12 @@ void FileWithInventory::open(const std::string& fname, Mode mode,
   FileHandler::open(fname, mode, blocksize);
 
   // create the write streams for entry information
-  w_inventory = attachWrite(0, blocksize);
+  if (mode != Mode::Read) {
+    w_inventory = attachWrite(0, blocksize);
+  }
+  else {
+    dirty = false;
+  }
 }
 
 void FileWithInventory::loadInventory()
@@ -122,7 +127,8 @@ FileWithInventory::~FileWithInventory()
 
 bool FileWithInventory::isComplete() const
 {
-  return bool(w_inventory) && FileHandler::isComplete();
+  return (bool(w_inventory) || open_mode == Mode::Read) &&
+    FileHandler::isComplete();
 }
 
 FileWithInventory::Entry::
@@ -95,7 +95,8 @@ public:
 
       @param fname       File to open
       @param mode        Open mode
-      @param blocksize   Default blocksize for new write streams
+      @param blocksize   Default blocksize for new write streams.
+                         In Read mode, no inventory writer is created.
    */
   void open(const std::string& fname, Mode mode=Mode::Truncate,
             unsigned blocksize=4096U);
@@ -154,6 +155,9 @@ public:
                                             const std::string& label,
                                             size_t bufsize=0);
 
+  /** Access the inventory entries */
+  inline const std::vector<Entry>& getEntries() const { return entries; }
+
   /** Access a stream based on the key given to a write stream
       @param key     Identifying key.
       @param label   Additional label to store.
@@ -14,7 +14,9 @@
 #define FileWithSegments_cxx
 #include "FileWithSegments.hxx"
 #include "DDFFExceptions.hxx"
+#include "ControlBlock.hxx"
 #include <limits>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <msgpack.hpp>
@@ -38,6 +40,21 @@ MSGPACK_API_VERSION_NAMESPACE(v1)
     /// @endcond
   namespace adaptor {
 
+  template <> struct pack<dueca::ddff::FileWithSegments::TimeIndex>
+  {
+    template <typename Stream>
+    msgpack::packer<Stream> &
+    operator()(msgpack::packer<Stream> &o,
+               const dueca::ddff::FileWithSegments::TimeIndex &t) const
+    {
+      o.pack_array(3);
+      o.pack(t.tick);
+      o.pack(t.offset);
+      o.pack(t.inblock_offset);
+      return o;
+    }
+  };
+
   template <> struct pack<dueca::ddff::FileWithSegments::Tag>
   {
     template <typename Stream>
@@ -45,7 +62,7 @@ MSGPACK_API_VERSION_NAMESPACE(v1)
     operator()(msgpack::packer<Stream> &o,
                const dueca::ddff::FileWithSegments::Tag &t) const
     {
-      o.pack_array(8);
+      o.pack_array(9);
       o.pack(t.offset); // 1, offset vector
       o.pack(t.inblock_offset); // in-block offset vector
       o.pack(t.cycle);  // 2, cycle for the stretch
@@ -54,6 +71,7 @@ MSGPACK_API_VERSION_NAMESPACE(v1)
       o.pack(dueca::timePointToString(t.time));  // 5, wall clock
       o.pack(t.label);  // 6, label
       o.pack(t.inco_name); // 7 matching inco
+      o.pack(t.time_index); // 8 time index per stream
       return o;
     }
   };
@@ -63,12 +81,23 @@ MSGPACK_API_VERSION_NAMESPACE(v1)
 } // namespace msgpack
 
 MSGPACKUS_NS_START;
+template <typename S>
+inline void msg_unpack(S &i0, const S &iend,
+                       dueca::ddff::FileWithSegments::TimeIndex &e)
+{
+  uint32_t len = unstream<S>::unpack_arraysize(i0, iend);
+  assert(len == 3);
+  msg_unpack(i0, iend, e.tick);
+  msg_unpack(i0, iend, e.offset);
+  msg_unpack(i0, iend, e.inblock_offset);
+}
+
 template <typename S>
 inline void msg_unpack(S &i0, const S &iend,
                        dueca::ddff::FileWithSegments::Tag &e)
 {
   uint32_t len = unstream<S>::unpack_arraysize(i0, iend);
-  assert(len == 8);
+  assert(len == 8 || len == 9);
   msg_unpack(i0, iend, e.offset);
   msg_unpack(i0, iend, e.inblock_offset);
   msg_unpack(i0, iend, e.cycle);
@@ -79,6 +108,15 @@ inline void msg_unpack(S &i0, const S &iend,
   e.time = dueca::timePointFromString(tstring);
   msg_unpack(i0, iend, e.label);
   msg_unpack(i0, iend, e.inco_name);
+
+  // older files have no time index
+  e.time_index.clear();
+  if (len == 9) {
+    e.time_index.resize(unstream<S>::unpack_arraysize(i0, iend));
+    for (auto &ti: e.time_index) {
+      msg_unpack(i0, iend, ti);
+    }
+  }
 }
 
 MSGPACKUS_NS_END;
@@ -93,9 +131,33 @@ FileWithSegments::Tag::Tag() :
   index1(0),
   time(),
   label(),
-  inco_name()
+  inco_name(),
+  time_index()
 {}
 
+void FileWithSegments::TimeIndex::add(TimeTickType t, int64_t off,
+                                      int32_t inblock)
+{
+  // re-written partial block
+  if (offset.size() && offset.back() == off) return;
+
+  // the first block may carry an item from the previous stretch
+  while (tick.size() && tick.back() > t) {
+    tick.pop_back();
+    offset.pop_back();
+    inblock_offset.pop_back();
+  }
+  tick.push_back(t);
+  offset.push_back(off);
+  inblock_offset.push_back(inblock);
+}
+
+int FileWithSegments::TimeIndex::find(TimeTickType t) const
+{
+  auto it = std::upper_bound(tick.begin(), tick.end(), t);
+  return int(it - tick.begin()) - 1;
+}
+
 FileWithSegments::FileWithSegments(const std::string &entity) :
   entity(entity),
   g_recorders("segmentedfile", false),
@@ -148,6 +210,10 @@ bool FileWithSegments::openFile(const std::string &filename,
 #endif
     );
 
+    // replay data is read in place from a mapping of the file; replay
+    // runs forward through the stretches
+    setMappedReading(true, true);
+
     // this opens the file and inventory
     FileWithInventory::open(filename, Mode::Append, blocksize);
   }
@@ -189,6 +255,12 @@ bool FileWithSegments::openFile(const std::string &filename,
 
     // release the inventory stream reader
     requestFileStreamReadRelease(stream1);
+
+    // files from older versions have no time index
+    if (std::any_of(tags.begin(), tags.end(), [](const Tag &t) {
+          return t.time_index.size() != t.offset.size(); })) {
+      rebuildTimeIndex();
+    }
   }
 
   return true;
@@ -286,6 +358,9 @@ void FileWithSegments::startStretch(
   }
   ts_switch.validity_start = tick;
   ts_switch.validity_end = MAX_TIMETICK;
+
+  // fresh time index for the new stretch
+  next_tag.time_index.assign(next_tag.offset.size(), TimeIndex());
 }
 
 void FileWithSegments::bufferWriteInformation(
@@ -298,6 +373,14 @@ void FileWithSegments::bufferWriteInformation(
     next_tag.offset[buffer->stream_id - 2] = offset;
     next_tag.inblock_offset[buffer->stream_id - 2] = buffer->object_offset;
   }
+
+  // blocks with a marked and timed item go into the time index
+  if (buffer->object_offset && buffer->stream_id >= 2 &&
+      buffer->item_tick != MAX_TIMETICK &&
+      buffer->stream_id - 2U < next_tag.time_index.size()) {
+    next_tag.time_index[buffer->stream_id - 2].add
+      (buffer->item_tick, offset, buffer->object_offset);
+  }
 }
 
 bool FileWithSegments::completeStretch(TimeTickType tick)
@@ -370,7 +453,7 @@ bool FileWithSegments::completeStretch(TimeTickType tick)
   return true;
 }
 
-void FileWithSegments::spoolForReplay(unsigned cycle)
+void FileWithSegments::spoolForReplay(unsigned cycle, TimeTickType from_tick)
 {
   // verify that this replay cycle is available
   if (cycle >= tags.size()) {
@@ -390,13 +473,23 @@ void FileWithSegments::spoolForReplay(unsigned cycle)
       throw tag_information_not_matching_recorders(entity.c_str(), cycle);
     }
 
-    // reset all recorders to their respective offset
+    // reset all recorders to their respective offset, or to the
+    // index point for the starting tick
     unsigned idx = 0;
     for (auto &recorder : myRecorders()) {
-      recorder->spoolReplay(tag0->offset[idx],
+      pos_type offset = tag0->offset[idx];
+      if (from_tick && idx < tag0->time_index.size()) {
+        const TimeIndex &ti = tag0->time_index[idx];
+        int ii = ti.find(from_tick);
+        if (ii >= 0) {
+          offset = ti.offset[ii] + ti.inblock_offset[ii];
+        }
+      }
+      recorder->spoolReplay(offset,
                             (tag1 != NULL)
                               ? tag1->offset[idx]
-                              : std::numeric_limits<pos_type>::max());
+                              : std::numeric_limits<pos_type>::max(),
+                            from_tick);
       idx++;
     }
   }
@@ -404,6 +497,80 @@ void FileWithSegments::spoolForReplay(unsigned cycle)
   runLoads();
 }
 
+void FileWithSegments::rebuildTimeIndex()
+{
+  drainWrites();
+
+  // collect the blocks with an item start, and the item tick, per stream
+  std::vector<std::map<pos_type,std::pair<TimeTickType,int32_t> > >
+    blocks(streams.size());
+  std::vector<char> item(16);
+  char header[control_block_size];
+  pos_type offset = 0;
+  file.clear();
+  file.seekg(offset, std::ios::beg);
+  file.read(header, control_block_size);
+  while (file.good() && !file.eof()) {
+    ControlBlockRead hdata(header);
+
+    // a zero block size means a damaged or incomplete file, stop here
+    if (hdata.block_size == 0) {
+      break;
+    }
+    if (hdata.stream_id >= 2 && hdata.stream_id < streams.size() &&
+        hdata.object_offset >= control_block_size &&
+        hdata.object_offset < hdata.block_fill) {
+
+      // decode the item header, array with tick, span and data. Skip
+      // the block if this runs into the next block
+      size_t nbytes = std::min(item.size(),
+                               size_t(hdata.block_fill - hdata.object_offset));
+      file.seekg(offset + hdata.object_offset, std::ios::beg);
+      file.read(item.data(), nbytes);
+      try {
+        std::vector<char>::const_iterator i0 = item.begin();
+        std::vector<char>::const_iterator iend = item.begin() + nbytes;
+        msgunpack::unstream<std::vector<char>::const_iterator>::
+          unpack_arraysize(i0, iend);
+        TimeTickType tick;
+        msgunpack::msg_unpack(i0, iend, tick);
+        blocks[hdata.stream_id][offset] =
+          std::make_pair(tick, int32_t(hdata.object_offset));
+      }
+      catch (const std::exception &e) {
+        DEB("Time index, cannot decode item at 0x" << std::hex <<
+            offset + hdata.object_offset << std::dec);
+      }
+    }
+    offset += hdata.block_size;
+    file.seekg(offset, std::ios::beg);
+    file.read(header, control_block_size);
+  }
+  file.clear();
+  file.seekg(0, std::ios::beg);
+
+  // distribute over the tags, the data for each stretch runs until the
+  // start of the next stretch
+  for (unsigned cycle = 0; cycle < tags.size(); cycle++) {
+    Tag &tag = tags[cycle];
+    tag.time_index.assign(tag.offset.size(), TimeIndex());
+    for (unsigned idx = 0; idx < tag.offset.size(); idx++) {
+      if (idx + 2U >= blocks.size() || tag.offset[idx] == 0) continue;
+      const auto &sblocks = blocks[idx + 2U];
+      pos_type end_offset = (cycle + 1U < tags.size() &&
+                             idx < tags[cycle + 1U].offset.size() &&
+                             tags[cycle + 1U].offset[idx] != 0) ?
+        tags[cycle + 1U].offset[idx] : std::numeric_limits<pos_type>::max();
+      for (auto bl = sblocks.lower_bound(tag.offset[idx]);
+           bl != sblocks.end() && bl->first < end_offset; bl++) {
+        tag.time_index[idx].add(bl->second.first, bl->first,
+                                bl->second.second);
+      }
+    }
+  }
+  DEB("Re-built time index for " << tags.size() << " tags");
+}
+
 void FileWithSegments::replayLoad()
 {
   for (auto &rdr : streams) {
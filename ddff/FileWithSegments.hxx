@@ -73,6 +73,9 @@ typedef std::list<SegmentedRecorderBase*> recorderlist_t;
       - string with a name for an initial condition/state, if applicable
       - string with a label
       - float granule, value of a time tick, to check for timing compatibility
+      - array with a sparse time index for each of the streams, see
+        TimeIndex. Files written by older versions lack this; the
+        index is then re-built from the data when the file is opened.
 
     - Further streams, as defined in the stream #0 inventory.
  */
@@ -109,6 +112,36 @@ protected:
   static filermap_t known_filers;
 
 public:
+  /** Sparse time index for a stream in a recording stretch.
+
+      For each block with the start of an item in the stretch, the
+      index holds the time tick of the item, as stored with the item
+      data, and the location of the item in the file. Ticks are
+      non-decreasing, so a start point can be found with a binary
+      search. Written as a msgpack array of three arrays.
+  */
+  struct TimeIndex
+  {
+    /** Time tick of the first item in a block */
+    std::vector<TimeTickType> tick;
+
+    /** Offset of the block */
+    std::vector<int64_t> offset;
+
+    /** Offset of the item in the block */
+    std::vector<int32_t> inblock_offset;
+
+    /** Add an index point. A repeated block (re-written partial
+        block) is ignored, and earlier points with a later tick,
+        carried over from a previous stretch, are removed. */
+    void add(TimeTickType t, int64_t off, int32_t inblock);
+
+    /** Find the last index point with a tick at or before t.
+
+        @returns  Index of the point, or -1 if there is none. */
+    int find(TimeTickType t) const;
+  };
+
   /** Tag data on entry contents */
   struct Tag
   {
@@ -141,6 +174,9 @@ public:
     /** Time granule value when recording, to understand the indexes */
     float granule;
 
+    /** Time index, for each stream */
+    std::vector<TimeIndex> time_index;
+
     /** Constructor */
     Tag();
   };
@@ -242,7 +278,8 @@ public:
       conditions may be retrieved and played back. The cycle argument
       indicates the current use of the file, if larger than 0, the
       specified number of cycles must already be present in the
-      existing file.
+      existing file. The data of an existing file is read in place,
+      from a mapping of the file, with sequential access advice.
 
       @param filename    Filename for the new data.
       @param filebasis   Filename with existing data.
@@ -288,10 +325,19 @@ public:
   */
   bool completeStretch(TimeTickType tick);
 
-  /** Spool/prepare linked recorders to a replay point */
-  void spoolForReplay(unsigned cycle);
+  /** Spool/prepare linked recorders to a replay point.
+
+      @param cycle       Recording cycle/dataset.
+      @param from_tick   Time tick in the recording, where replay is
+                         to start. Like the ticks stored with the
+                         recorded data, it is relative to the start of
+                         the stretch. The recorders are spooled to this
+                         point with the time index.
+  */
+  void spoolForReplay(unsigned cycle, TimeTickType from_tick = 0U);
 
-  /** Indicate start time tick for replay */
+  /** Indicate start time tick for replay. The data at the from_tick
+      given in spoolForReplay will be replayed at this tick. */
   void startTickReplay(TimeTickType tick);
 
   /** Set the name and inco for the upcoming recording. */
@@ -313,6 +359,10 @@ protected:
    */
   void bufferWriteInformation(pos_type offset,
                               DDFFMessageBuffer::ptr_type buffer) final;
+
+  /** Re-build the time index of the tags from the file data, for
+      files from older versions */
+  void rebuildTimeIndex();
 };
 
 /** Exception, failure to get indices??
@@ -27,7 +27,8 @@ SegmentedRecorderBase::SegmentedRecorderBase() :
 SegmentedRecorderBase::~SegmentedRecorderBase() {}
 
 void SegmentedRecorderBase::spoolReplay(ddff::FileHandler::pos_type offset,
-                                        ddff::FileHandler::pos_type end_offset)
+                                        ddff::FileHandler::pos_type end_offset,
+                                        TimeTickType from_tick)
 {
   throw replay_not_implemented();
 }
@@ -29,7 +29,9 @@ protected:
   /** Remember to where data was written/handled */
   TimeTickType marked_tick;
 
-  /** Control indicating the start of a recording stretch */
+  /** Control indicating the start of a recording stretch. Ticks
+      stored with the data and in the time index are relative to
+      this start. */
   TimeTickType record_start_tick;
 
   /** Flag to remember data written during a stretch of recording */
@@ -80,9 +82,14 @@ public:
 
       @param offset     Location in file where data starts
       @param end_offset Location in file where data ends.
+      @param from_tick  Time tick, relative to the stretch start as
+                        stored with the data, from which replay is to
+                        start. Data at offset may be
+                        earlier, and is skipped.
    */
   virtual void spoolReplay(ddff::FileHandler::pos_type offset,
-                           ddff::FileHandler::pos_type end_offset);
+                           ddff::FileHandler::pos_type end_offset,
+                           TimeTickType from_tick = 0U);
 
     /** Starting a new replay; provide offset for the replayed data */
   virtual void startReplay(TimeTickType tick);
@@ -28,6 +28,8 @@ class DDFFTag:
             time -- wall time string
             name -- name of the period
             inco -- initial condition matching the period
+            time_index -- optional, per stream [ticks, block offsets,
+                          in-block offsets] of the sparse time index
         """
         (
             self.offset,
@@ -38,7 +40,8 @@ class DDFFTag:
             self.time,
             self.name,
             self.inco,
-        ) = args
+        ) = args[:8]
+        self.time_index = args[8] if len(args) > 8 else None
 
     def __str__(self):
         return (
@@ -67,7 +70,7 @@ class DDFFTagIndex:
         self.tagdict = dict()
         for st in self.base:
             t = DDFFTag(*st)
-            self.tagdict[st[-2]] = t
+            self.tagdict[t.name] = t
             self.taglist.append(t)
 
     def offsets(self, period: int | str = 0):
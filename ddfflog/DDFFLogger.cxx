@@ -85,6 +85,12 @@ const ParameterTable *DDFFLogger::getMyParameterTable()
       new VarProbe<_ThisModule_, bool>(&_ThisModule_::immediate_start),
       "Immediately start the logging module, do not wait for DUECA control." },
 
+    { "async-write",
+      new VarProbe<_ThisModule_, bool>(&_ThisModule_::async_write),
+      "Write file blocks in a separate writer thread, so the logging\n"
+      "activity does not wait when the operating system flushes data to\n"
+      "disk. Default off." },
+
     { "reduction",
       new MemberCall<_ThisModule_, TimeSpec>(&_ThisModule_::setReduction),
       "Reduce the logging data rate according to the given time\n"
@@ -143,6 +149,7 @@ DDFFLogger::DDFFLogger(Entity *e, const char *part, const PrioritySpec &ps) :
   lftemplate("datalog-%Y%m%d_%H%M%S.ddff"),
   always_logging(false),
   immediate_start(false),
+  async_write(false),
   prepared(false),
   inholdcurrent(true),
   loggingactive(false),
@@ -192,6 +199,7 @@ bool DDFFLogger::complete()
       FormatTime(boost::posix_time::second_clock::universal_time());
     hfile = std::shared_ptr<FileWithSegments>(
       new FileWithSegments(current_filename, FileHandler::Mode::New));
+    hfile->setAsyncWriting(async_write);
 
     sendStatus(string("opened log file ") + current_filename, false,
                SimTime::getTimeTick());
@@ -613,6 +621,7 @@ void DDFFLogger::doCalculation(const TimeSpec &ts)
       try {
         // create the file
         nfile.reset(new FileWithSegments(filename, FileHandler::Mode::New));
+        nfile->setAsyncWriting(async_write);
 
         // if there is no prefix, create a default epoch
         if (cnf.data().prefix.size() == 0) {
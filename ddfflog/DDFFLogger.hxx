@@ -87,6 +87,9 @@ private: // simulation data
   // start immediately
   bool immediate_start;
 
+  // write file blocks in a separate thread
+  bool async_write;
+
   // remember preparation for immediate start
   bool prepared;
 
@@ -0,0 +1,201 @@
+/* ------------------------------------------------------------------   */
+/*      item            : DDFFToHDF5.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define DDFFToHDF5_cxx
+#include "DDFFToHDF5.hxx"
+#include <ddff/FileStreamRead.hxx>
+#include <ddff/DDFFDCOMetaFunctor.hxx>
+#include <ddff/DDFFExceptions.hxx>
+#include <HDF5DCOMetaFunctor.hxx>
+#include <HDF5ChunkWriter.hxx>
+#include <dueca/DataClassRegistry.hxx>
+#include <dueca/DataSetConverter.hxx>
+#include <dueca/TimeSpec.hxx>
+#include <dueca/msgpack-unstream-iter.hxx>
+#include <rapidjson/document.h>
+#include <H5Cpp.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#define DEBPRINTLEVEL -1
+#include <debprint.h>
+
+DDFF_NS_START;
+
+USING_DUECA_NS;
+using hdf5log::HDF5ChunkWriter;
+using hdf5log::HDF5DCOMetaFunctor;
+using hdf5log::HDF5DCOWriteFunctor;
+
+DDFFToHDF5::StreamResult::StreamResult(const std::string& key) :
+  key(key),
+  dataclass(),
+  nrows(0U),
+  error()
+{ }
+
+DDFFToHDF5::DDFFToHDF5(const std::string& infile, size_t chunksize,
+                       bool compress, unsigned nthreads) :
+  infile(infile),
+  entries(),
+  chunksize(chunksize),
+  compress(compress),
+  nthreads(nthreads)
+{
+  FileWithInventory file(infile, FileHandler::Mode::Read);
+  entries = file.getEntries();
+}
+
+DDFFToHDF5::~DDFFToHDF5()
+{
+  //
+}
+
+std::vector<DDFFToHDF5::StreamResult>
+DDFFToHDF5::convert(const std::string& outfile,
+                    const std::vector<std::string>& keys) const
+{
+  // select the streams to convert
+  std::vector<const FileWithInventory::Entry*> todo;
+  if (keys.empty()) {
+    for (const auto &e: entries) { todo.push_back(&e); }
+  }
+  else {
+    for (const auto &k: keys) {
+      auto e = std::find_if(entries.begin(), entries.end(),
+                            [&k](const FileWithInventory::Entry& e)
+                            { return e.key == k; });
+      if (e == entries.end()) { throw entry_notfound(); }
+      todo.push_back(&(*e));
+    }
+  }
+
+  std::vector<StreamResult> results;
+  for (const auto e: todo) { results.emplace_back(e->key); }
+
+  std::shared_ptr<H5::H5File> hfile(new H5::H5File(outfile, H5F_ACC_TRUNC));
+  {
+    // the chunk writer completes all writes before the file is closed
+    HDF5ChunkWriter writer;
+
+    // each thread takes the next unconverted stream
+    std::atomic<unsigned> next(0U);
+    auto work = [&]() {
+      for (unsigned ii = next++; ii < todo.size(); ii = next++) {
+        convertStream(results[ii], *todo[ii], hfile, &writer);
+      }
+    };
+
+    unsigned nt = nthreads ? nthreads :
+      std::max(1U, std::thread::hardware_concurrency());
+    nt = std::min(nt, unsigned(todo.size()));
+    std::vector<std::thread> threads;
+    for (unsigned ii = nt; ii--; ) { threads.emplace_back(work); }
+    for (auto &t: threads) { t.join(); }
+  }
+
+  return results;
+}
+
+void DDFFToHDF5::convertStream(StreamResult& res,
+                               const FileWithInventory::Entry& entry,
+                               std::weak_ptr<H5::H5File> hfile,
+                               HDF5ChunkWriter* writer) const
+{
+  // the data class is given in the JSON description in the label
+  rapidjson::Document doc;
+  doc.Parse(entry.label.c_str());
+  if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("class") ||
+      !doc["class"].IsString()) {
+    res.error = std::string("no data class description in label");
+    return;
+  }
+  res.dataclass = doc["class"].GetString();
+  if (!DataClassRegistry::single().isRegistered(res.dataclass)) {
+    res.error = std::string("data class ") + res.dataclass +
+      std::string(" not available");
+    return;
+  }
+
+  void* object = NULL;
+  const DataSetConverter* converter = NULL;
+  try {
+    std::weak_ptr<DDFFDCOMetaFunctor> ddffmeta =
+      std::dynamic_pointer_cast<DDFFDCOMetaFunctor>
+      (DataClassRegistry::single().getMetaFunctor
+       (res.dataclass, "msgpack").lock());
+    std::weak_ptr<HDF5DCOMetaFunctor> hdf5meta =
+      std::dynamic_pointer_cast<HDF5DCOMetaFunctor>
+      (DataClassRegistry::single().getMetaFunctor
+       (res.dataclass, "hdf5").lock());
+    if (ddffmeta.expired() || hdf5meta.expired()) {
+      throw FunctorTypeMismatch();
+    }
+
+    // separate file handler for each stream, reading from a mapping
+    FileWithInventory::pointer file
+      (new FileWithInventory(infile, FileHandler::Mode::Read));
+    file->setMappedReading(true, true);
+    FileStreamRead::pointer rstream = file->findNamedRead(entry.key, 8U);
+    file->runLoads();
+
+    // functor unpacking the msgpack data into an object
+    std::unique_ptr<DDFFDCOWriteFunctor> unpack
+      (ddffmeta.lock()->getWriteFunctor(false));
+    converter = DataClassRegistry::single().getConverter(res.dataclass);
+    object = converter->clone(NULL);
+
+    // functor writing the object to HDF5, all time is converted; the
+    // stream goes in a group directly under the root
+    const DataTimeSpec all_time(0, MAX_TIMETICK);
+    const std::string path = entry.key.size() && entry.key[0] == '/' ?
+      entry.key : std::string("/") + entry.key;
+    std::unique_ptr<HDF5DCOWriteFunctor> write;
+    {
+      HDF5ChunkWriter::library_lock_t l = HDF5ChunkWriter::libraryLock();
+      write.reset(hdf5meta.lock()->getWriteFunctor
+                  (hfile, path, chunksize, std::string(), &all_time,
+                   compress));
+      write->setAsyncWriter(writer);
+    }
+
+    // each item is an array with tick, span and object
+    FileStreamRead::Iterator it = rstream->iterator();
+    unpack->setIterator(it);
+    TimeTickType tick, span;
+    while (it != rstream->end()) {
+      uint32_t sz = msgunpack::unstream<FileStreamRead::Iterator>::
+        unpack_arraysize(it, rstream->end());
+      if (sz != 3) { throw ddff_file_format_error(); }
+      msgunpack::msg_unpack(it, rstream->end(), tick);
+      msgunpack::msg_unpack(it, rstream->end(), span);
+      (*unpack)(object);
+      (*write)(object, DataTimeSpec(tick, tick + span));
+      res.nrows++;
+    }
+    DEB("Converted stream " << entry.key << ", " << res.nrows << " rows");
+
+    // remaining chunks are handed to the writer
+    HDF5ChunkWriter::library_lock_t l = HDF5ChunkWriter::libraryLock();
+    write.reset();
+  }
+  catch (const std::exception& e) {
+    res.error = e.what();
+  }
+  catch (const H5::Exception& e) {
+    res.error = e.getDetailMsg();
+  }
+  if (object) { converter->delData(object); }
+}
+
+DDFF_NS_END;
@@ -0,0 +1,125 @@
+/* ------------------------------------------------------------------   */
+/*      item            : DDFFToHDF5.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Parallel conversion of DDFF log files to HDF5
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#ifndef DDFFToHDF5_hxx
+#define DDFFToHDF5_hxx
+
+#include "ddff_ns.h"
+#include <ddff/FileWithInventory.hxx>
+#include <HdfLogNamespace.hxx>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace H5 { class H5File; }
+
+STARTHDF5LOG;
+class HDF5ChunkWriter;
+ENDHDF5LOG;
+
+DDFF_NS_START;
+
+/** Conversion of DDFF log files to HDF5.
+
+    The streams in a DDFF file written by the DDFFLogger are
+    converted to the column-wise layout also produced by the
+    HDF5Logger and the Python ddff-convert script:
+
+    @code
+    <key>/tick            - DUECA time tick of each data point
+    <key>/data/<member>   - datasets for all data members
+    @endcode
+
+    Contrary to the Python script, the data is decoded by the DCO
+    class' own "msgpack" functors, and written by its "hdf5"
+    functors, so the data classes in the file need to be available
+    in the executable, with these options. Each stream is converted
+    in a separate thread, with its own file handler and a read-only
+    mapping of the file. Rows are collected in chunk buffers, which
+    are compressed and written by a single HDF5ChunkWriter thread.
+*/
+class DDFFToHDF5
+{
+public:
+  /** Conversion result for a single stream */
+  struct StreamResult
+  {
+    /** Key of the stream, also used as path in the HDF5 file */
+    std::string                      key;
+    /** Data class of the stream */
+    std::string                      dataclass;
+    /** Number of converted data points */
+    size_t                           nrows;
+    /** Error message, empty if successful */
+    std::string                      error;
+
+    /** Constructor */
+    StreamResult(const std::string& key = std::string());
+  };
+
+private:
+  /** Name of the DDFF file */
+  std::string                        infile;
+
+  /** Inventory of the file */
+  std::vector<FileWithInventory::Entry> entries;
+
+  /** Chunk size for the HDF5 datasets */
+  size_t                             chunksize;
+
+  /** Compress the HDF5 datasets */
+  bool                               compress;
+
+  /** Number of conversion threads, 0 for the number of cores */
+  unsigned                           nthreads;
+
+  /** Convert a single stream, runs in a conversion thread */
+  void convertStream(StreamResult& res,
+                     const FileWithInventory::Entry& entry,
+                     std::weak_ptr<H5::H5File> hfile,
+                     hdf5log::HDF5ChunkWriter* writer) const;
+
+public:
+  /** Constructor. Opens the file and reads the inventory.
+
+      @param infile    DDFF file, with inventory.
+      @param chunksize Chunk size of the HDF5 datasets.
+      @param compress  Compress the HDF5 datasets.
+      @param nthreads  Maximum number of conversion threads, 0 to
+                       use the number of hardware threads.
+  */
+  DDFFToHDF5(const std::string& infile, size_t chunksize = 500U,
+             bool compress = false, unsigned nthreads = 0U);
+
+  /** Destructor */
+  ~DDFFToHDF5();
+
+  /** Access the inventory of the file */
+  inline const std::vector<FileWithInventory::Entry>& getEntries() const
+  { return entries; }
+
+  /** Convert the streams to an HDF5 file.
+
+      @param outfile   Name of the HDF5 file, an existing file is
+                       overwritten.
+      @param keys      Keys of the streams to convert, if empty, all
+                       streams in the inventory are converted.
+      @returns         Conversion results, one for each stream.
+  */
+  std::vector<StreamResult> convert(const std::string& outfile,
+                                    const std::vector<std::string>& keys =
+                                    std::vector<std::string>()) const;
+};
+
+DDFF_NS_END;
+
+#endif
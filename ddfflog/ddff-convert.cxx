@@ -0,0 +1,138 @@
+/* ------------------------------------------------------------------   */
+/*      item            : ddff-convert.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     : Command-line conversion of DDFF logs to HDF5
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#include "DDFFToHDF5.hxx"
+#include <H5Cpp.h>
+#include <getopt.h>
+#include <dlfcn.h>
+#include <chrono>
+#include <iostream>
+#include <cstdlib>
+
+USING_DDFF_NS;
+
+static void usage(const char* name)
+{
+  std::cerr
+    << "Usage: " << name << " [options] file.ddff\n"
+    << "Convert the streams in a DDFF log file to HDF5, in parallel\n\n"
+    << "  -o, --outfile FILE   output file, default from input name\n"
+    << "  -s, --stream KEY     convert only this stream, may be repeated\n"
+    << "  -c, --chunksize N    HDF5 chunk size, default 500\n"
+    << "  -z, --compress       compress the HDF5 datasets\n"
+    << "  -j, --jobs N         maximum number of threads, default all cores\n"
+    << "  -l, --load LIB       load a shared library with the data classes\n"
+    << "  -i, --inventory      only print the inventory\n"
+    << "  -h, --help           this message\n\n"
+    << "The data classes need the \"msgpack\" and \"hdf5\" options, and\n"
+    << "must be linked in, or loaded from a shared library.\n";
+}
+
+int main(int argc, char** argv)
+{
+  static const struct option options[] = {
+    { "outfile",   required_argument, NULL, 'o' },
+    { "stream",    required_argument, NULL, 's' },
+    { "chunksize", required_argument, NULL, 'c' },
+    { "compress",  no_argument,       NULL, 'z' },
+    { "jobs",      required_argument, NULL, 'j' },
+    { "load",      required_argument, NULL, 'l' },
+    { "inventory", no_argument,       NULL, 'i' },
+    { "help",      no_argument,       NULL, 'h' },
+    { NULL,        0,                 NULL, 0 }
+  };
+
+  std::string outfile;
+  std::vector<std::string> keys;
+  size_t chunksize = 500U;
+  bool compress = false;
+  unsigned jobs = 0U;
+  bool inventory = false;
+
+  int opt;
+  while ((opt = getopt_long(argc, argv, "o:s:c:zj:l:ih", options, NULL))
+         != -1) {
+    switch (opt) {
+    case 'o': outfile = optarg; break;
+    case 's': keys.push_back(optarg); break;
+    case 'c': chunksize = std::strtoul(optarg, NULL, 10); break;
+    case 'z': compress = true; break;
+    case 'j': jobs = std::strtoul(optarg, NULL, 10); break;
+    case 'l':
+      // DCO classes register themselves when the library is loaded
+      if (dlopen(optarg, RTLD_NOW | RTLD_GLOBAL) == NULL) {
+        std::cerr << "Cannot load " << optarg << ": " << dlerror()
+                  << std::endl;
+        return 1;
+      }
+      break;
+    case 'i': inventory = true; break;
+    case 'h': usage(argv[0]); return 0;
+    default: usage(argv[0]); return 1;
+    }
+  }
+  if (optind + 1 != argc || chunksize == 0U) {
+    usage(argv[0]);
+    return 1;
+  }
+  const std::string infile(argv[optind]);
+
+  // output file name from the input name, in the current folder
+  if (outfile.empty()) {
+    outfile = infile.substr(infile.rfind('/') + 1);
+    if (outfile.size() > 5 &&
+        outfile.compare(outfile.size() - 5, 5, ".ddff") == 0) {
+      outfile.resize(outfile.size() - 5);
+    }
+    outfile += ".hdf5";
+  }
+
+  try {
+    DDFFToHDF5 converter(infile, chunksize, compress, jobs);
+
+    if (inventory) {
+      for (const auto &e: converter.getEntries()) {
+        std::cout << e.id << " " << e.key << " " << e.label << std::endl;
+      }
+      return 0;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto results = converter.convert(outfile, keys);
+    std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+
+    int nfail = 0;
+    for (const auto &r: results) {
+      if (r.error.size()) {
+        std::cerr << "Stream " << r.key << " (" << r.dataclass
+                  << "): " << r.error << std::endl;
+        nfail++;
+      }
+      else {
+        std::cout << r.key << " (" << r.dataclass << "): "
+                  << r.nrows << " rows" << std::endl;
+      }
+    }
+    std::cout << "Converted " << results.size() - nfail << " of "
+              << results.size() << " streams to " << outfile << " in "
+              << dt.count() << "s" << std::endl;
+    return nfail ? 2 : 0;
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Cannot convert " << infile << ": " << e.what() << std::endl;
+  }
+  catch (const H5::Exception& e) {
+    std::cerr << "Cannot create " << outfile << ": " << e.getDetailMsg()
+              << std::endl;
+  }
+  return 1;
+}
@@ -0,0 +1,104 @@
+/* ------------------------------------------------------------------   */
+/*      item            : ActivityHeap.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Binary heap for ordering scheduled activities
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <dueca_ns.h>
+
+DUECA_NS_START
+
+/** Binary heap, alternative to the ordered list of ActivityItem
+    objects in an ActivityManager.
+
+    Insertion in the ordered list walks back from the tail, which
+    costs O(n) when many activities are queued. The heap has O(log n)
+    insertion and removal. Items that compare equal are returned in
+    the order they were inserted, so the result is identical to that
+    of the ordered list.
+
+    The heap is not thread-safe; like the ordered list, it is filled
+    and emptied by the thread of the ActivityManager.
+
+    @tparam T    Item type, normally a pointer.
+    @tparam Less Comparison, Less()(a, b) is true when a is less
+                 important than b.
+*/
+template<typename T, typename Less>
+class ActivityHeap
+{
+  /** Heap element, item with insertion sequence number */
+  struct Element
+  {
+    /** The item itself */
+    T             item;
+
+    /** Insertion sequence, for ordering equally important items */
+    uint32_t      seq;
+  };
+
+  /** Comparison of elements, equal items are ordered by insertion */
+  struct ElementLess
+  {
+    /** Item comparison */
+    Less          less;
+
+    /** Returns true if a should come after b */
+    inline bool operator() (const Element& a, const Element& b) const
+    {
+      if (less(a.item, b.item)) return true;
+      if (less(b.item, a.item)) return false;
+      return int32_t(a.seq - b.seq) > 0;
+    }
+  };
+
+  /** Storage for the heap */
+  std::vector<Element>  heap;
+
+  /** Next insertion sequence number */
+  uint32_t              seq;
+
+public:
+  /** Constructor.
+      @param expected   Expected maximum size, space is reserved. */
+  ActivityHeap(size_t expected = 256) :
+    heap(),
+    seq(0U)
+  { heap.reserve(expected); }
+
+  /** Add an item */
+  inline void push(const T& item)
+  {
+    heap.push_back(Element{item, seq++});
+    std::push_heap(heap.begin(), heap.end(), ElementLess());
+  }
+
+  /** Remove and return the most important item. The heap must not be
+      empty. */
+  inline T pop()
+  {
+    std::pop_heap(heap.begin(), heap.end(), ElementLess());
+    T res = heap.back().item;
+    heap.pop_back();
+    return res;
+  }
+
+  /** Check whether there are items in the heap */
+  inline bool empty() const { return heap.empty(); }
+
+  /** Number of items in the heap */
+  inline size_t size() const { return heap.size(); }
+};
+
+DUECA_NS_END
@@ -26,6 +26,8 @@
 #include "ActivityLog.hxx"
 #include "Arena.hxx"
 #include "Su.hxx"
+#include "EventCount.hxx"
+#include "LogRing.hxx"
 #include <dueca-conf.h>
 #include "ChannelReadToken.hxx"
 #include "ChannelWriteToken.hxx"
@@ -166,12 +168,31 @@ unsigned ActivityManager::prio0_overruns = 0;
 
 typedef void* (* voidfunc)(void*);
 
+/** State of a thread that runs activities for an ActivityManager. */
+struct ActivityWorker
+{
+  /** The manager this thread works for */
+  ActivityManager*            manager;
+
+  /** Item currently or last invoked by this thread */
+  ActivityItem*               to_do;
+
+  /** With multiple threads, true while to_do is being invoked */
+  bool                        busy;
+
+  /** Set of levels triggered during the execution of an activity */
+  std::bitset<MAX_MANAGERS>   triggeredlevels;
+};
+
 
 class ActivityManagerData
 {
   /** Thread id. */
   pthread_t despatcher_thread;
 
+  /** Ids of additional threads */
+  std::vector<pthread_t> helper_threads;
+
   inline const char* printmode(int mode)
   {
     static char unknown[16];
@@ -207,9 +228,24 @@ public:
     pthread_attr_destroy(&thread_attrib);
   }
 
+  void helper(voidfunc func, void* arg, int prio)
+  {
+    DEB("creating additional thread for mgr" << prio);
+    pthread_t helper_thread;
+    if (pthread_create(&helper_thread, NULL, func, arg)) {
+      perror("Activitymanager failed to start additional thread");
+      ::exit(1);
+    }
+    helper_threads.push_back(helper_thread);
+  }
+
   void join(int prio)
   {
     pthread_join(despatcher_thread, NULL);
+    for (auto &t: helper_threads) {
+      pthread_join(t, NULL);
+    }
+    helper_threads.clear();
   }
 
   void priority(int sched_mode, int sched_prio, int prio)
@@ -217,7 +253,7 @@ public:
     DEB("entered thread for mgr " << prio);
     int mode = 0;
     struct sched_param schedpar; memset(&schedpar, 0, sizeof(schedpar));
-    pthread_getschedparam(despatcher_thread, &mode, &schedpar);
+    pthread_getschedparam(pthread_self(), &mode, &schedpar);
 
     // first check and fix
     if (sched_mode != SCHED_OTHER && sched_mode != mode) {
@@ -229,7 +265,7 @@ public:
             printmode(sched_mode) << " prio " << sched_prio);
       struct sched_param schedpar; memset(&schedpar, 0, sizeof(schedpar));
       schedpar.sched_priority = sched_prio;
-      if (pthread_setschedparam(despatcher_thread, sched_mode, &schedpar)) {
+      if (pthread_setschedparam(pthread_self(), sched_mode, &schedpar)) {
         /* DUECA timing.
 
            Cannot adjust the scheduling priority. If you are deploying
@@ -241,7 +277,7 @@ public:
       }
     }
 
-    pthread_getschedparam(despatcher_thread, &mode, &schedpar);
+    pthread_getschedparam(pthread_self(), &mode, &schedpar);
     if (mode != sched_mode) {
       /* DUECA activity.
 
@@ -276,13 +312,16 @@ public:
   {
     sched_param schedpar;
     schedpar.sched_priority = 0;
-    pthread_setschedparam(despatcher_thread, SCHED_OTHER, &schedpar);
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &schedpar);
   }
 };
 
 ThreadSpecific ActivityManager::ts;
 
-ActivityManager::ActivityManager(int level, int sched_mode, int sched_prio) :
+ActivityManager::ActivityManager(int level, int sched_mode, int sched_prio,
+                                 bool heap_scheduling,
+                                 bool lockfree_wake, unsigned wake_spin,
+                                 unsigned workers) :
   NamedObject(NameSet("dueca", "ActivityManager",
                       level + 1000 *
                       ObjectManager::single()->getLocation())),
@@ -295,6 +334,8 @@ ActivityManager::ActivityManager(int level, int sched_mode, int sched_prio) :
   head(new ActivityItem(NULL, TimeSpec(0,0))),
   tail(new ActivityItem(NULL, TimeSpec(0,0))),
 #endif
+  use_heap(heap_scheduling && level > 0),
+  heap(EXPECTED_QUEUE_SIZE),
   prio(level),
   qsize(0),
   user_id(geteuid()),
@@ -302,17 +343,16 @@ ActivityManager::ActivityManager(int level, int sched_mode, int sched_prio) :
   sched_mode(sched_mode),
   sched_prio(sched_prio),
   queue_condition((vstring("ActivityManager ") + makeRope(level)).c_str()),
+  wake_count((lockfree_wake && level > 0 && workers <= 1) ?
+             new EventCount() : NULL),
+  wake_spin(wake_spin),
   running(false),
   dummy_graphics_update(NULL),
-
-  // always have a (dummy) activity in to_do
-#ifdef AM_PLACEMENT
-  to_do(new(arena) ActivityItem(NULL, TimeSpec(0,0))),
-#else
-  to_do(new ActivityItem(NULL, TimeSpec(0,0))),
-#endif
+  nworkers((level > 0 && workers > 1) ? workers : 1),
+  workers(new ActivityWorker[nworkers]),
+  nbusy(0),
+  held(),
   triggerq(),
-  triggeredlevels(0),
   current_log(NULL),
   log_start(0),
   log_end(0),
@@ -331,6 +371,21 @@ ActivityManager::ActivityManager(int level, int sched_mode, int sched_prio) :
   }
 
   head->initialConnect(tail);
+
+  // always have a (dummy) activity in to_do
+  for (unsigned ii = 0; ii < nworkers; ii++) {
+    this->workers[ii].manager = this;
+#ifdef AM_PLACEMENT
+    this->workers[ii].to_do = new(arena) ActivityItem(NULL, TimeSpec(0,0));
+#else
+    this->workers[ii].to_do = new ActivityItem(NULL, TimeSpec(0,0));
+#endif
+    this->workers[ii].busy = false;
+    this->workers[ii].triggeredlevels = 0;
+  }
+  if (nworkers > 1) {
+    held.reserve(nworkers);
+  }
 }
 
 
@@ -381,7 +436,8 @@ void ActivityManager::completeCreation()
 
 ActivityManager::~ActivityManager()
 {
-  // nothing else
+  delete wake_count;
+  delete[] workers;
 }
 
 
@@ -389,33 +445,34 @@ ActivityManager::~ActivityManager()
 // NOTE SYNCHRO: real-time equivalent is loopDoActivities
 void ActivityManager::doActivities()
 {
-  // store a reference to this manager in the thread pointer. Is used
-  // for logging
-  ts.setPtr(this);
+  // store a reference to this manager's thread state in the thread
+  // pointer. Is used for logging
+  ActivityWorker& w = workers[0];
+  ts.setPtr(&w);
   running = false;
 
   // only called single-thread, no: queue_condition.enterTest();
-  while (head->getNext() != tail) {
+  while (!queueEmpty()) {
 
     // the current todo has been handled or was a dummy; remove
 #ifdef AM_PLACEMENT
-    to_do->~ActivityItem();
-    arena->free(to_do);
+    w.to_do->~ActivityItem();
+    arena->free(w.to_do);
 #else
-    delete to_do;
+    delete w.to_do;
 #endif
     // get the next thing on the list
-    to_do = head->popAfter();
+    w.to_do = popItem();
     qsize--;
 
     // only called single-thread, no: queue_condition.leaveTest();
 
     // execute the activity, mutex unlocked, so new things may be
     // scheduled in the meantime
-    DEB1("Start activity by " << to_do->getOwner() << " prio=" << prio);
-    doLog(ActivityBit::Start);
-    to_do->despatch();
-    DEB1("Completed activity by " << to_do->getOwner() << " prio=" << prio);
+    DEB1("Start activity by " << w.to_do->getOwner() << " prio=" << prio);
+    doLog(w, ActivityBit::Start);
+    w.to_do->despatch();
+    DEB1("Completed activity by " << w.to_do->getOwner() << " prio=" << prio);
 
     // monitor the levels that were triggered, and if needed,
     // activate the other managers
@@ -426,13 +483,14 @@ void ActivityManager::doActivities()
 
   // queue or list is now empty, unlock again
   // only called single-thread, no: queue_condition.leaveTest();
-  doLog(ActivityBit::Suspend);   // note doLog may not be within test
+  doLog(w, ActivityBit::Suspend);   // note doLog may not be within test
 }
 
 void ActivityManager::doActivities0()
 {
   // store the thread pointer
-  ts.setPtr(this);
+  ActivityWorker& w = workers[0];
+  ts.setPtr(&w);
   running = true;
 
   // propagate triggers, we might have had a waking attempt while
@@ -448,9 +506,9 @@ void ActivityManager::doActivities0()
   // empty. If so, lock, check again, and suspend
   while (tick < timeforgraphics) {
 
-    if (head->getNext() == tail && !triggerq.notEmpty()) {
+    if (queueEmpty() && !triggerq.notEmpty()) {
 
-      doLog(ActivityBit::Suspend, true);
+      doLog(w, ActivityBit::Suspend, true);
 
       // there is nothing on the queue. Wait for the first thing to come
       // in. Test again, since the logging above may have sent off a
@@ -468,29 +526,29 @@ void ActivityManager::doActivities0()
     getRealTime();                       // updates tick's value
     exittick = tick + prio0_maxticks;
 
-    while (head->getNext() != tail && exittick >= tick) {
+    while (!queueEmpty() && exittick >= tick) {
 
       // the current todo has been handled or was a dummy; remove
 #ifdef AM_PLACEMENT
-      to_do->~ActivityItem();
-      arena->free(to_do);
+      w.to_do->~ActivityItem();
+      arena->free(w.to_do);
 #else
-      delete to_do;
+      delete w.to_do;
 #endif
       // get the next thing on the list
-      to_do = head->popAfter();
+      w.to_do = popItem();
       qsize--;
 
-      DEB1("Start activity by " << to_do->getOwner() << " prio=" << prio);
-      doLog(ActivityBit::Start);         // updates tick's value
+      DEB1("Start activity by " << w.to_do->getOwner() << " prio=" << prio);
+      doLog(w, ActivityBit::Start);
 
-      to_do->despatch();
+      w.to_do->despatch();
 
-      DEB1("Completed activity by " << to_do->getOwner() <<
+      DEB1("Completed activity by " << w.to_do->getOwner() <<
             " prio=" << prio);
 
       // wake all other managers that have received trigger atoms
-      wakeOthers();
+      wakeOthers(w);
 
       // propagate my own trigger atoms
       propagateTriggers();
@@ -535,17 +593,17 @@ void ActivityManager::doActivities0()
   // doing graphics update; assign a default activity to to_do,
   // because this is what will be logged in error cases
 #ifdef AM_PLACEMENT
-  to_do->~ActivityItem();
-  arena->free(to_do);
-  to_do = new(arena) ActivityItem(dummy_graphics_update,
-                                  TimeSpec(SimTime::getTimeTick()));
+  w.to_do->~ActivityItem();
+  arena->free(w.to_do);
+  w.to_do = new(arena) ActivityItem(dummy_graphics_update,
+                                    TimeSpec(SimTime::getTimeTick()));
 #else
-  delete to_do;
-  to_do = new ActivityItem(dummy_graphics_update,
-                           TimeSpec(SimTime::getTimeTick()));
+  delete w.to_do;
+  w.to_do = new ActivityItem(dummy_graphics_update,
+                             TimeSpec(SimTime::getTimeTick()));
 #endif
 
-  doLog(ActivityBit::Graphics);
+  doLog(w, ActivityBit::Graphics);
   // note doLog may not be entered with queue_condition acquired
 }
 
@@ -562,17 +620,17 @@ void ActivityManager::scheduleAll()
 
 /* Test all managers for having received TriggerAtoms from this
    thread, and if so, call their wake-up */
-void ActivityManager::wakeOthers()
+void ActivityManager::wakeOthers(ActivityWorker& w)
 {
-  //if (triggeredlevels.any()) {
-  //  DEB("waking ActivityManager: " << triggeredlevels);
+  //if (w.triggeredlevels.any()) {
+  //  DEB("waking ActivityManager: " << w.triggeredlevels);
   //}
   for (int ii = max_prio+1; ii--; ) {
-    if (triggeredlevels.test(ii) && ii != prio) {
+    if (w.triggeredlevels.test(ii) && ii != prio) {
       CSE.wakeActivityManager(ii);
     }
   }
-  triggeredlevels = 0;
+  w.triggeredlevels = 0;
 }
 
 void ActivityManager::wakeThis()
@@ -581,6 +639,13 @@ void ActivityManager::wakeThis()
   if (!triggerq.notEmpty()) return;
 
   DEB("ActivityManager waking prio=" << prio);
+
+  // lock-free variant, only a system call when the thread is parked
+  if (wake_count) {
+    wake_count->notify();
+    return;
+  }
+
   // else trigger
   queue_condition.enterTest();
   queue_condition.signal();
@@ -603,7 +668,7 @@ bool ActivityManager::propagateTriggers()
   //    << " atoms, got " << qsize - oldact << " activities");
 
   // return true if there is something scheduled here
-  return (head->getNext() != tail);
+  return !queueEmpty();
 }
 
 void ActivityManager::addAtom(TriggerTarget* target, unsigned id,
@@ -619,12 +684,15 @@ void ActivityManager::addAtom(TriggerTarget* target, unsigned id,
 }
 
 
-inline void ActivityManager::doLog(ActivityBit::ActivityBitType what_to_log,
+inline void ActivityManager::doLog(ActivityWorker& w,
+                                   ActivityBit::ActivityBitType what_to_log,
                                    bool in_lock)
 {
-  // figure out the time. This updates the member variables tick and
-  // frac_in_tick
-  getRealTime();
+  // figure out the time. With multiple threads, the manager's tick
+  // and fraction cannot be used
+  TimeTickType tick;
+  uint16_t fraction;
+  getRealTime(tick, fraction);
 
   // quick return for not logging.
   // log_end primarily switches logging on
@@ -640,11 +708,16 @@ inline void ActivityManager::doLog(ActivityBit::ActivityBitType what_to_log,
   current_log->appendActivityBit
     (new ActivityBit(tick-log_start, fraction,
                      what_to_log,
-                     to_do->getDescriptionId(),
-                     to_do->getTimeSpec()));
+                     w.to_do->getDescriptionId(),
+                     w.to_do->getTimeSpec()));
 }
 
 void ActivityManager::getRealTime()
+{
+  getRealTime(tick, fraction);
+}
+
+void ActivityManager::getRealTime(TimeTickType& tick, uint16_t& fraction) const
 {
   // calculate how many usecs have passed
   int64_t offset_usecs = Ticker::single()->getUsecsSinceTick(log_start);
@@ -661,37 +734,57 @@ void ActivityManager::triggeredLevels(const std::bitset<MAX_MANAGERS>& levels)
 {
   union {
     void *vpointer;
-    ActivityManager* manager;
+    ActivityWorker* worker;
   } join;
   join.vpointer = ts.ptr();
   if (join.vpointer == NULL) return;
-  join.manager->triggeredlevels |= levels;
+  join.worker->triggeredlevels |= levels;
 }
 
 ActivityContext ActivityManager::getActivityContext()
 {
   union {
     void *vpointer;
-    ActivityManager* manager;
+    ActivityWorker* worker;
   } join;
   join.vpointer = ts.ptr();
   if (join.vpointer) {
-    return ActivityContext(join.manager->prio,
-                           join.manager->to_do->getDescriptionId());
+    return ActivityContext(join.worker->manager->prio,
+                           join.worker->to_do->getDescriptionId());
   }
   return ActivityContext(0xff, 0);
 }
 
+ActivityWorker& ActivityManager::currentWorker()
+{
+  ActivityWorker* w = reinterpret_cast<ActivityWorker*>(ts.ptr());
+  if (w != NULL && w->manager == this) return *w;
+  return workers[0];
+}
+
 void ActivityManager::logBlockingWait()
 {
+  ActivityWorker& w = currentWorker();
+
+  // with multiple threads, the log and the queue are shared
+  if (nworkers > 1 && running) {
+    queue_condition.enterTest();
+    doLog(w, ActivityBit::Block);
+    propagateTriggers();
+    if (!queueEmpty()) queue_condition.signal();
+    queue_condition.leaveTest();
+    wakeOthers(w);
+    return;
+  }
+
   // logs a blocking wait. Does not check for end of the log.
-  doLog(ActivityBit::Block);
+  doLog(w, ActivityBit::Block);
 
   // note that this is not only for logging now. Need to process any
   // activations!
   if (running) {
     propagateTriggers(); // process my own
-    wakeOthers();        // and let others
+    wakeOthers(w);       // and let others
   }
   else {
     scheduleAll();
@@ -700,7 +793,13 @@ void ActivityManager::logBlockingWait()
 
 void ActivityManager::logBlockingWaitOver()
 {
-  doLog(ActivityBit::Continue);
+  if (nworkers > 1 && running) {
+    queue_condition.enterTest();
+    doLog(currentWorker(), ActivityBit::Continue);
+    queue_condition.leaveTest();
+    return;
+  }
+  doLog(currentWorker(), ActivityBit::Continue);
 }
 
 // NOTE: logging scheduling actions will be done in the (near)
@@ -714,9 +813,18 @@ void ActivityManager::logBlockingWaitOver()
 // NOTE SYNCHRO: non-real-time equivalent is doActivities
 void ActivityManager::loopDoActivities()
 {
+  // multiple threads use a different loop
+  if (nworkers > 1) {
+    loopDoActivitiesShared(workers[0]);
+    return;
+  }
+
+  // set a thread-specific pointer to this manager's thread state.
+  ActivityWorker& w = workers[0];
+  ts.setPtr(&w);
 
-  // set a thread-specific pointer to this manager.
-  ts.setPtr(this);
+  // ring for deferred log messages, not allocated in the loop
+  LogRing::prepare();
 
   // get the correct scheduler and priority set up
   my.priority(sched_mode, sched_prio, prio);
@@ -726,26 +834,31 @@ void ActivityManager::loopDoActivities()
 
   while (running) {
 
-    // lock the mutex, see if there is something on the queue, and
-    // wait for new data if necessary
-
+    if (wake_count) {
 
-    queue_condition.enterTest();
-    while(head->getNext() == tail && running) {
-      doLog(ActivityBit::Suspend, true);
-
-      // there is nothing on the queue. Wait for the first thing to come
-      // in. Test again, since the logging above may have sent off a
-      // log that will need to be processed (Actually, as far as I can
-      // tell, in non-0 activity managers the sending of the log will *not*
-      // trigger new scheduling. However, as this is sufficiently deep
-      // to escape attention when the processing of channel writes
-      // changes, it is best kept in until scheduling is done in a
-      // lock-free fashion).
-      queue_condition.wait();
-      propagateTriggers();
+      // same as below, without the mutex
+      waitLockFree();
+    }
+    else {
+      // lock the mutex, see if there is something on the queue, and
+      // wait for new data if necessary
+      queue_condition.enterTest();
+      while(queueEmpty() && running) {
+        doLog(w, ActivityBit::Suspend, true);
+
+        // there is nothing on the queue. Wait for the first thing to come
+        // in. Test again, since the logging above may have sent off a
+        // log that will need to be processed (Actually, as far as I can
+        // tell, in non-0 activity managers the sending of the log will *not*
+        // trigger new scheduling. However, as this is sufficiently deep
+        // to escape attention when the processing of channel writes
+        // changes, it is best kept in until scheduling is done in a
+        // lock-free fashion).
+        queue_condition.wait();
+        propagateTriggers();
+      }
+      queue_condition.leaveTest();
     }
-    queue_condition.leaveTest();
 
     if (running) {
       // at this point, we are sure that there is something on the queue
@@ -753,28 +866,29 @@ void ActivityManager::loopDoActivities()
       // next item, and unlock the guard, so new items can be put
       // in.
 #ifdef AM_PLACEMENT
-      to_do->~ActivityItem();
-      arena->free(to_do);
+      w.to_do->~ActivityItem();
+      arena->free(w.to_do);
 #else
-      delete to_do;
+      delete w.to_do;
 #endif
-      to_do = head->popAfter();
+      w.to_do = popItem();
       qsize--;
 
       // if required, log the action
-      DEB1("Start activity by " << to_do->getOwner() << " prio=" << prio);
-      doLog(ActivityBit::Start);
+      DEB1("Start activity by " << w.to_do->getOwner() << " prio=" << prio);
+      doLog(w, ActivityBit::Start);
 
       // despatch the item
-      to_do->despatch();
+      w.to_do->despatch();
 
       // process triggeratoms for others
-      wakeOthers();
+      wakeOthers(w);
 
       // and possibly fill my list of activities again
       propagateTriggers();
 
-      DEB1("Completed activity by " << to_do->getOwner() << " prio=" << prio);
+      DEB1("Completed activity by " << w.to_do->getOwner() <<
+           " prio=" << prio);
     }
   }
   /* DUECA activity.
@@ -786,12 +900,158 @@ void ActivityManager::loopDoActivities()
   my.noPriority();
 }
 
+bool ActivityManager::activityBusy(unsigned int activity_id) const
+{
+  for (unsigned ii = nworkers; ii--; ) {
+    if (workers[ii].busy &&
+        workers[ii].to_do->getDescriptionId() == activity_id) return true;
+  }
+  return false;
+}
+
+ActivityItem* ActivityManager::takeItem()
+{
+  // first the items that were held back; when an activity is no
+  // longer running, its oldest held item comes first
+  for (auto ii = held.begin(); ii != held.end(); ii++) {
+    if (!activityBusy((*ii)->getDescriptionId())) {
+      ActivityItem* item = *ii;
+      held.erase(ii);
+      return item;
+    }
+  }
+
+  // then the queue; hold back items for activities that are running,
+  // or that have older items held back
+  while (!queueEmpty()) {
+    ActivityItem* item = popItem();
+    qsize--;
+    bool hold = activityBusy(item->getDescriptionId());
+    for (auto ii = held.begin(); !hold && ii != held.end(); ii++) {
+      hold = (*ii)->getDescriptionId() == item->getDescriptionId();
+    }
+    if (!hold) return item;
+    held.push_back(item);
+  }
+  return NULL;
+}
+
+// runs in each of the threads of a manager with multiple threads; the
+// queue, the held items and the log are guarded by queue_condition
+void ActivityManager::loopDoActivitiesShared(ActivityWorker& w)
+{
+  ts.setPtr(&w);
+  LogRing::prepare();
+  my.priority(sched_mode, sched_prio, prio);
+
+  queue_condition.enterTest();
+  propagateTriggers();
+
+  while (running) {
+
+    ActivityItem* item = takeItem();
+    if (item == NULL) {
+
+      // the last thread to become idle logs the suspend
+      if (nbusy == 0) {
+        doLog(w, ActivityBit::Suspend, true);
+      }
+      if (!triggerq.notEmpty()) {
+        queue_condition.wait();
+      }
+      propagateTriggers();
+      continue;
+    }
+
+    // replace the previous item
+#ifdef AM_PLACEMENT
+    w.to_do->~ActivityItem();
+    arena->free(w.to_do);
+#else
+    delete w.to_do;
+#endif
+    w.to_do = item;
+    w.busy = true;
+    nbusy++;
+
+    // if there is more work, pass the wake-up on to an idle thread
+    if (!queueEmpty() || held.size()) {
+      queue_condition.signal();
+    }
+    DEB1("Start activity by " << w.to_do->getOwner() << " prio=" << prio);
+    doLog(w, ActivityBit::Start, true);
+    queue_condition.leaveTest();
+
+    // despatch the item, other threads may schedule and take items
+    w.to_do->despatch();
+
+    // process triggeratoms for others
+    wakeOthers(w);
+
+    // the activity may now run again in any thread, and possibly fill
+    // the list of activities again
+    queue_condition.enterTest();
+    w.busy = false;
+    nbusy--;
+    propagateTriggers();
+    DEB1("Completed activity by " << w.to_do->getOwner() <<
+         " prio=" << prio);
+  }
+
+  // pass the stop on to the other threads
+  queue_condition.signal();
+  queue_condition.leaveTest();
+
+  /* DUECA activity.
+
+     Information that a thread of an activity manager is ending
+     multi-threaded running.
+  */
+  I_ACT("ActivityManager " << prio << " thread " << (&w - workers) <<
+        " leaving multi-thread loop");
+  my.noPriority();
+}
+
+void ActivityManager::waitLockFree()
+{
+  ActivityWorker& w = workers[0];
+  while (queueEmpty() && running) {
+    doLog(w, ActivityBit::Suspend);
+
+    // triggering commonly follows shortly, poll a little before
+    // giving up the processor
+    for (unsigned ii = wake_spin; ii-- && !triggerq.notEmpty(); ) {
+      cpuRelax();
+    }
+
+    // announce the wait, check again, and park. A notify after
+    // prepareWait prevents the parking
+    if (!triggerq.notEmpty()) {
+      uint32_t key = wake_count->prepareWait();
+      if (triggerq.notEmpty() || !running) {
+        wake_count->cancelWait();
+      }
+      else {
+        wake_count->wait(key);
+      }
+    }
+    propagateTriggers();
+  }
+}
+
 static void* ActivityManager_loopDoActivities(void *arg)
 {
   static_cast<ActivityManager*>(arg)->loopDoActivities();
   return NULL;
 }
 
+static void* ActivityManager_loopDoActivitiesShared(void *arg)
+{
+  ActivityWorker* w = static_cast<ActivityWorker*>(arg);
+  w->manager->loopDoActivitiesShared(*w);
+  return NULL;
+}
+
 void ActivityManager::kick()
 {
   // am not always locking here, because I don't want the risk of blocking
@@ -800,25 +1060,24 @@ void ActivityManager::kick()
   // keep the interface from freezing in the absence of other
   // activities in no 0 thread
   //  if (head->getNext() == tail) {
+    if (wake_count) {
+      wake_count->notify();
+      return;
+    }
     queue_condition.enterTest();
     queue_condition.signal();
     queue_condition.leaveTest();
     //  }
 }
 
-void ActivityManager::schedule(Activity* activity,
-                               const DataTimeSpec& model_time)
+void ActivityManager::insertItem(ActivityItem* item)
 {
-  // queue_condition.enterTest();
-  DEB1("Scheduling activity for " << activity->getOwner());
-  // create the activity item
-#ifdef AM_PLACEMENT
-  ActivityItem* item = new(arena) ActivityItem(activity, model_time);
-#else
-  ActivityItem* item = new ActivityItem(activity, model_time);
-#endif
+  if (use_heap) {
 
-  if (prio) {
+    // the heap keeps the same ordering as the list below
+    heap.push(item);
+  }
+  else if (prio) {
 
     // find out where it belongs in the ordered list
     ActivityItem *tmp = tail->getPrevious();
@@ -833,6 +1092,20 @@ void ActivityManager::schedule(Activity* activity,
   }
 
   qsize++;
+}
+
+void ActivityManager::schedule(Activity* activity,
+                               const DataTimeSpec& model_time)
+{
+  // queue_condition.enterTest();
+  DEB1("Scheduling activity for " << activity->getOwner());
+  // create the activity item
+#ifdef AM_PLACEMENT
+  ActivityItem* item = new(arena) ActivityItem(activity, model_time);
+#else
+  ActivityItem* item = new ActivityItem(activity, model_time);
+#endif
+  insertItem(item);
   // adjust count of queue size. Signal the thread if there was
   // nothing in the queue before (i.e. it was suspended and has to
   // start again)
@@ -847,6 +1120,7 @@ void ActivityManager::schedule(Activity* activity,
 #endif
   if (qsize > EXCESSIVE_QUEUE_SIZE) {
     DEB1("ActivityManager " << prio << " queue size " << qsize);
+    ActivityItem* to_do = workers[0].to_do;
     if ((qsize - EXCESSIVE_QUEUE_SIZE) % 100 == 0) {
       if (to_do->isEmpty()) {
         /* DUECA activity.
@@ -879,25 +1153,30 @@ void ActivityManager::schedule(Activity* activity,
 
 void ActivityManager::reportCurrent()
 {
-  if (to_do->isEmpty()) {
-    /* DUECA activity.
+  for (unsigned ii = 0; ii < nworkers; ii++) {
+    ActivityItem* to_do = workers[ii].to_do;
+    if (to_do->isEmpty()) {
+      /* DUECA activity.
 
-       Inform that no activities have been run by this
-       ActivityManager. This is commonly done after a user interrupt,
-       it may give information on run problems.
-    */
-    W_ACT("ActivityManager " << prio << " has not yet run");
-  }
-  else {
-    /* DUECA activity.
+         Inform that no activities have been run by this
+         ActivityManager. This is commonly done after a user interrupt,
+         it may give information on run problems.
+      */
+      W_ACT("ActivityManager " << prio << " thread " << ii <<
+            " has not yet run");
+    }
+    else {
+      /* DUECA activity.
 
-       Report on the current activities by this ActivityManager. This
-       is commonly done after a user interrupt, it may give
-       information on run problems.
-    */
-    W_ACT("ActivityManager " << prio << " queue size " << qsize <<
-          " last activity " << to_do->getOwner() <<'/' <<
-          to_do->getName() << ' ' << to_do->getTimeSpec());
+         Report on the current activities by this ActivityManager. This
+         is commonly done after a user interrupt, it may give
+         information on run problems.
+      */
+      W_ACT("ActivityManager " << prio << " thread " << ii <<
+            " queue size " << qsize <<
+            " last activity " << to_do->getOwner() <<'/' <<
+            to_do->getName() << ' ' << to_do->getTimeSpec());
+    }
   }
 }
 
@@ -910,6 +1189,15 @@ void ActivityManager::startDoActivities()
   running = true;
   my.thread(ActivityManager_loopDoActivities, this, prio,
             sched_mode, sched_prio);
+  if (nworkers > 1) {
+    /* DUECA activity.
+
+       Information on the additional threads of an ActivityManager. */
+    I_ACT("ActivityManager " << prio << " using " << nworkers << " threads");
+    for (unsigned ii = 1; ii < nworkers; ii++) {
+      my.helper(ActivityManager_loopDoActivitiesShared, &workers[ii], prio);
+    }
+  }
 }
 
 void ActivityManager::stopDoActivities()
@@ -923,6 +1211,9 @@ void ActivityManager::stopDoActivities()
   running = false;
   queue_condition.signal();
   queue_condition.leaveTest();
+  if (wake_count) {
+    wake_count->notify();
+  }
 
   my.join(prio);
 
@@ -950,15 +1241,21 @@ void ActivityManager::triggerNewLog(const TimeSpec& time)
 
     // check that the tick has progressed, so logging has stopped
     if (tick > log_end) {
-      if (current_log && log_response->isValid()) {
+
+      // with multiple threads, others may still be logging
+      if (nworkers > 1) queue_condition.enterTest();
+      ActivityLog* log = log_response->isValid() ? current_log : NULL;
+      if (log) current_log = NULL;
+      if (nworkers > 1) queue_condition.leaveTest();
+
+      if (log) {
         /* DUECA activity.
 
            Inform on log sending and on how many actions are reported.
         */
         I_ACT("ActivityManager " << prio << " sending log # bits " <<
-              current_log->no_of_bits);
-        wrapSendEvent(*log_response, current_log, time.getValidityStart());
-        current_log = NULL;
+              log->no_of_bits);
+        wrapSendEvent(*log_response, log, time.getValidityStart());
       }
     }
     else {
@@ -985,7 +1282,7 @@ void ActivityManager::triggerNewLog(const TimeSpec& time)
   }
 
   // install a new log.
-  current_log = new ActivityLog
+  ActivityLog* log = new ActivityLog
     (NodeManager::single()->getThisNodeNo(), prio,
      req.data().start, fraction_to_usecs,
      new ActivityBit(0, 0, ActivityBit::LogStart, 0, time));
@@ -996,11 +1293,15 @@ void ActivityManager::triggerNewLog(const TimeSpec& time)
   I_ACT("ActivityManager " << prio << " new log starting " <<
         req.data().start);
 
+  if (nworkers > 1) queue_condition.enterTest();
+  current_log = log;
+
   // update log_start
   log_start = req.data().start;
 
   // updating log_end means that logging will start
   log_end = req.data().start + req.data().span;
+  if (nworkers > 1) queue_condition.leaveTest();
 }
 
 DUECA_NS_END
@@ -26,6 +26,8 @@
 #include "ActivityContext.hxx"
 #include "TriggerAtom.hxx"
 #include "AsyncQueueMT.hxx"
+#include "ActivityHeap.hxx"
+#include <vector>
 #include <dueca_ns.h>
 
 #define AM_PLACEMENT
@@ -40,6 +42,8 @@ class Arena;
 struct ActivityLog;
 class TickerTimeInfo;
 class Activity;
+class EventCount;
+struct ActivityWorker;
 
 /** As a helper, need a definition for SCHED_RTAI and SCHED_XENO */
 #define SCHED_RTAI 0x1000
@@ -176,6 +180,15 @@ public:
   { return reinterpret_cast<void*>(o); }
 };
 
+/** Comparison of ActivityItem pointers, for ordering in an
+    ActivityHeap. */
+struct ActivityItemPtrLess
+{
+  /** Returns true if a is less important than b */
+  inline bool operator() (const ActivityItem* a, const ActivityItem* b) const
+  { return *a < *b; }
+};
+
 /** Private class for implementation-dependent data */
 class ActivityManagerData;
 
@@ -185,7 +198,14 @@ class ActivityManagerData;
     After the initial start of DUECA, thread-of-control is given to
     the ActivityManager objects in a node. Usually there are multiple
     ActivityManager objects, each handling the Activities with a
-    certain priority level in its own thread. */
+    certain priority level in its own thread.
+
+    A priority level above 0 may also be given multiple threads. These
+    threads take their work from the same queue of scheduled
+    activities, in the same order as a single thread would. Different
+    activities then run in parallel, but the activations of a single
+    Activity never run at the same time, and are run in the order in
+    which they were scheduled. */
 class ActivityManager: public NamedObject
 {
   /** Implementation-dependent data */
@@ -209,6 +229,14 @@ class ActivityManager: public NamedObject
   /** Pointer to the last Activityitem in the list of ActivityItems. */
   ActivityItem *tail;
 
+  /** If true, scheduled ActivityItems are ordered in a binary heap
+      instead of the list. Only used for priority levels > 0, level 0
+      works first-come, first-served. */
+  bool use_heap;
+
+  /** Heap with ActivityItems, used when use_heap is set. */
+  ActivityHeap<ActivityItem*,ActivityItemPtrLess> heap;
+
   /** Priority/level of this ActivityManager */
   int prio;
 
@@ -232,6 +260,14 @@ class ActivityManager: public NamedObject
       condition and associated mutex. */
   Condition queue_condition;
 
+  /** Optional lock-free wake-up, replaces the queue_condition for
+      priority levels > 0. NULL when not used. */
+  EventCount* wake_count;
+
+  /** Number of polls of the trigger queue before parking, when using
+      the lock-free wake-up. */
+  unsigned wake_spin;
+
   /** Flag to keep (or not) running */
   bool running;
 
@@ -242,16 +278,24 @@ class ActivityManager: public NamedObject
   /// The copy constructor is not implemented.
   ActivityManager(const ActivityManager&);
 
-  /// This is a pointer to currently invoked ActivityItem
-  ActivityItem* to_do;
+  /** Number of threads despatching activities */
+  unsigned nworkers;
+
+  /** State of each despatching thread, the first one is the
+      manager's own thread. Each keeps the ActivityItem it works on. */
+  ActivityWorker* workers;
+
+  /** With multiple threads, number of threads running an activity */
+  unsigned nbusy;
+
+  /** With multiple threads, items taken from the queue while their
+      activity was running in another thread, in the order taken. */
+  std::vector<ActivityItem*> held;
 
   /** A list of triggering atoms that need to be processed after
       completing an activity */
   AsyncQueueMT<TriggerAtom>   triggerq;
 
-  /** Set of levels triggered during the execution of an activity */
-  std::bitset<MAX_MANAGERS>   triggeredlevels;
-
 public:
 
   /** Constructor.
@@ -259,8 +303,23 @@ public:
       \param level       Level of the activity manager
       \param sched_mode  POSIX scheduling mode
       \param sched_prio  POSIX scheduling priority or nice level.
+      \param heap_scheduling If true, and level > 0, order the
+                         scheduled activities in a binary heap rather
+                         than in an ordered list.
+      \param lockfree_wake If true, and level > 0, wake the manager
+                         through an EventCount instead of the
+                         condition, so triggering threads do not need
+                         to take a mutex.
+      \param wake_spin   With lockfree_wake, number of times to poll
+                         for new triggers before parking the thread.
+      \param workers     Number of threads running activities, only
+                         used when level > 0. With more than one
+                         thread, lockfree_wake is not used.
   */
-  ActivityManager(int level, int sched_mode, int sched_prio);
+  ActivityManager(int level, int sched_mode, int sched_prio,
+                  bool heap_scheduling = false,
+                  bool lockfree_wake = false, unsigned wake_spin = 0,
+                  unsigned workers = 1);
 
   /** Construction of the ActivityManager (and many other basic
       objects in DUECA) has to be done in two steps, this is the
@@ -295,6 +354,13 @@ public:
       available, and waits/blocks when no activities are available. */
   void loopDoActivities();
 
+  /** Despatch loop for a manager with multiple threads. Each thread,
+      including the manager's own, runs this loop, and takes the next
+      activity that is not already running in another thread.
+
+      \param w          State of the calling thread. */
+  void loopDoActivitiesShared(ActivityWorker& w);
+
 private:
   /** Start a thread for the ActivityManager and handle activities.
 
@@ -309,6 +375,27 @@ private:
   void stopDoActivities();
 
 private:
+  /** Check whether there are no scheduled activities. */
+  inline bool queueEmpty() const
+  { return use_heap ? heap.empty() : head->getNext() == tail; }
+
+  /** Remove and return the next scheduled activity. */
+  inline ActivityItem* popItem()
+  { return use_heap ? heap.pop() : head->popAfter(); }
+
+  /** Place an item in the list or heap, according to its importance. */
+  void insertItem(ActivityItem* item);
+
+  /** With multiple threads, check whether an activity is running. */
+  bool activityBusy(unsigned int activity_id) const;
+
+  /** With multiple threads, take the next item that can be run now,
+      or NULL if there is none. */
+  ActivityItem* takeItem();
+
+  /** State of the calling thread, when it is one of this manager's
+      threads, otherwise the state of the manager's own thread. */
+  ActivityWorker& currentWorker();
   /** schedule an activity for despatching later. */
   void schedule(Activity* activity, const DataTimeSpec& model_time);
 
@@ -412,19 +499,27 @@ private:
       \param in_lock0      Flag to indicate that the action is within
                            the locked section of manager 0. This needs
                            to be considered when sending off a log. */
-  inline void doLog(ActivityBit::ActivityBitType what_to_log,
+  inline void doLog(ActivityWorker& w,
+                    ActivityBit::ActivityBitType what_to_log,
                     bool in_lock0 = false);
 
   /** Auxiliary function that gets the time info right now. */
   void getRealTime();
 
+  /** Get the time info right now, without updating the manager's
+      tick and fraction.
+      \param tick        Resulting time tick.
+      \param fraction    Resulting fraction of the tick. */
+  void getRealTime(TimeTickType& tick, uint16_t& fraction) const;
+
   /** check whether the triggering needs to be done. Non-realtime
       version, for single thread running. */
   void scheduleAll();
 
   /** Check whether waking of others needs to be done. Realtime,
-      multithread version */
-  void wakeOthers();
+      multithread version
+      \param w          State of the calling thread. */
+  void wakeOthers(ActivityWorker& w);
 
   /** Check whether waking of others needs to be done. Realtime,
       multithread version */
@@ -433,6 +528,10 @@ private:
   /** Calculate my triggering / scheduling */
   bool propagateTriggers();
 
+  /** Wait for new work with the lock-free wake-up; spin briefly, then
+      park on the EventCount. */
+  void waitLockFree();
+
 public:
 
   /** Define a triggering action. Later the triggering will be
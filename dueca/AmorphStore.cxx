@@ -351,6 +351,14 @@ void AmorphStore::packData(const bool& b)
   index++;
 }
 
+char* AmorphStore::claimRoom(const unsigned size)
+{
+  internalCheckForRoom(size);
+  char* res = &(stor[index]);
+  index += size;
+  return res;
+}
+
 void AmorphStore::packData(const vstring& str)
 {
   union {
@@ -525,6 +533,14 @@ void AmorphReStore::unPackData(float &f)
 }
 
 
+const char* AmorphReStore::claimData(const unsigned size)
+{
+  checkDataAvailable(size);
+  const char* res = &(stor[index]);
+  index += size;
+  return res;
+}
+
 void AmorphReStore::unPackData(double &d)
 {
   checkDataAvailable(sizeof(d));
@@ -337,6 +337,14 @@ public:
       again. */
   void packData(const char* c, const unsigned length);
 
+  /** Claim a block of a fixed size in the store, for packing data
+      directly into the block; see packfixed.
+      \param  size                Size of the block, in bytes.
+      \returns                    Start of the block.
+      \throws AmorphStoreBoundary exception indicated that the store
+                                  is full. */
+  char* claimRoom(const unsigned size);
+
   /** Print to stream, just for debugging purposed. */
   ostream& print(ostream& o) const;
 };
@@ -500,6 +508,13 @@ private:
   inline void checkDataAvailable(const unsigned size);
 
 public:
+  /** Take a block of a fixed size from the store, for unpacking
+      data directly from the block; see unpackfixed.
+      \param  size                Size of the block, in bytes.
+      \returns                    Start of the block.
+      \throws AmorphReStoreEmpty  when not enough data is available. */
+  const char* claimData(const unsigned size);
+
   /// Unpack a float
   void unPackData(float &f);
   /// Unpack a double
@@ -99,7 +99,12 @@ struct Channel
                           objects. With differential packing, an
                           object in a channel is compared to the
                           preceding object, and only elements that
-                          differ are packed. */
+                          differ are packed. A full pack is sent at
+                          the start, after gaps, on request of a
+                          receiving end that misses the preceding
+                          data, and periodically when the
+                          Environment's "full-pack-interval" is
+                          set. */
     OnlyFullPacking  /**< Only use full packing. This is more
                           appropriate for channel entries with small
                           object, or when you expect that all or most
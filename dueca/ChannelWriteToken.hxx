@@ -173,6 +173,7 @@ public:
 
 protected:
   friend class DataWriterBase;
+  friend class DataUpdaterBase;
   friend class DCOWriter;
 
   /** wrapper for the "old" sendEvent member call
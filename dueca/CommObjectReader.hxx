@@ -63,6 +63,9 @@ public:
       @param i         Index of the data member */
   ElementReader operator [] (unsigned i) const;
 
+  /** Pointer to the accessed object */
+  inline const void* getObject() const { return obj; }
+
   /** Destructor */
   ~CommObjectReader();
 };
@@ -73,6 +73,12 @@ const CommObjectMemberAccessBase& CommObjectReaderWriter::getMemberAccessor(unsi
   return *DataClassRegistry::single().getMemberAccessor(entry, i);
 }
 
+DCOMetaFunctor* CommObjectReaderWriter::findMetaFunctor
+(const std::string& fname) const
+{
+  return DataClassRegistry::single().findMetaFunctor(entry, fname);
+}
+
 CommObjectReaderWriter& CommObjectReaderWriter::operator =
 (const CommObjectReaderWriter& o)
 {
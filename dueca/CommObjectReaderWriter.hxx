@@ -73,6 +73,11 @@ public:
   /** Directly reach the MemberAccess object */
   const CommObjectMemberAccessBase &getMemberAccessor(unsigned i) const;
 
+  /** Find a metafunctor for the class, NULL if not available
+
+      @param fname     Functor name */
+  DCOMetaFunctor* findMetaFunctor(const std::string& fname) const;
+
   /** assignment, needed for temporary copy MSGPACKtoDCO */
   CommObjectReaderWriter& operator = (const CommObjectReaderWriter& o);
 };
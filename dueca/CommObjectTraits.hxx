@@ -24,6 +24,7 @@
 #include <map>
 #include <string>
 #include <inttypes.h>
+#include <type_traits>
 #include <dueca_ns.h>
 #include <sstream>
 #include <dueca/stringoptions.h>
@@ -160,6 +161,44 @@ struct dco_isenum : public dco_isdirect {};
 template <typename T>
 struct dco_nested: public dco_isdirect { };
 
+/** Trait that indicates whether objects can be copied as raw memory,
+    e.g. through shared memory, without packing. By default, only
+    trivially copyable types qualify; dueca-codegen specializes this
+    for DCO objects of which all members qualify. */
+template <typename T>
+struct dco_rawcopy: public std::is_trivially_copyable<T> { };
+
+/** Trait giving the number of bytes an object occupies when packed,
+    if that is fixed, or 0 otherwise. Objects with a fixed packed size
+    can be packed into a single block claimed from the store, see
+    packfixed. Arithmetic types have a fixed size; dueca-codegen
+    specializes this for DCO objects of which all members have a
+    fixed packed size. */
+template <typename T>
+struct dco_packsize: public std::integral_constant
+  <size_t, (std::is_arithmetic<T>::value && sizeof(T) <= 8U) ?
+   sizeof(T) : 0U> { };
+
+/** Combined packed size of a number of objects, 0 if any of these
+    does not have a fixed packed size. */
+template <typename... T>
+struct dco_packsize_all;
+
+/** Packed size for a single object */
+template <typename T>
+struct dco_packsize_all<T>: public dco_packsize<T> { };
+
+/** Packed size for a series of objects */
+template <typename T, typename... R>
+struct dco_packsize_all<T, R...>: public std::integral_constant
+  <size_t, (dco_packsize<T>::value && dco_packsize_all<R...>::value) ?
+   dco_packsize<T>::value + dco_packsize_all<R...>::value : 0U> { };
+
+/** Trait that indicates whether objects have a fixed packed size. */
+template <typename T>
+struct dco_packfixed: public std::integral_constant
+  <bool, dco_packsize<T>::value != 0U> { };
+
 /** @name Trait defining struct for read access to DCO members
 
     @brief Defines different treatments of members for reading */
@@ -0,0 +1,171 @@
+/* ------------------------------------------------------------------   */
+/*      item            : DCOTypedCoding.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Typed coding of DCO objects, for JSON and msgpack
+        changes         : 261017 first version
+        api             : DUECA_API
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#ifndef DCOTypedCoding_hxx
+#define DCOTypedCoding_hxx
+
+#include <dueca_ns.h>
+#include <CommObjectTraits.hxx>
+#include <CommObjectReader.hxx>
+#include <sstream>
+
+/** @file DCOTypedCoding.hxx
+
+    Templates for coding DCO objects member by member, with the types
+    of the members known at compile time.
+
+    The introspective coding (DCOtoJSON, and the msgpack coding of the
+    websocket server) reads each member through an ElementReader, and
+    boxes each value in a boost::any. For DCO objects with the (Option
+    json), the code generator specializes dco_typed_coder, and the
+    object is coded directly with these templates.
+
+    A coding "writer" class provides the following calls:
+
+    * StartObject(n), Key(name), EndObject(); an object with n members
+    * StartArray(n), EndArray(); an array with n elements
+    * StartMapped(n), MappedKey(), MappedValue(), EndMappedElement(),
+      EndMapped(); n key-value pairs of a mapped member
+    * String(const char*), and Value(v) overloads for the member types
+    * Reflective(const CommObjectReader&); introspective coding, used
+      for nested objects without generated typed coding
+
+    The typed coding gives the same result as the introspective
+    coding. Members of a type that cannot be coded give a null (nil
+    for msgpack) value and an error message in both. Only Dstring
+    members differ; the introspective coding handles a fixed set of
+    Dstring sizes, the typed coding all sizes.
+*/
+
+DUECA_NS_START;
+
+/** Typed coding of a DCO object.
+
+    The default implementation codes introspectively. The code
+    generator specializes this for objects with the json option,
+    adding a static n_members, and a code_members call that codes
+    the members, without the enclosing object.
+
+    @tparam T      DCO object type.
+*/
+template<typename T>
+struct dco_typed_coder
+{
+  /** Code the object.
+
+      @param w     Coding writer.
+      @param v     Object to code. */
+  template<class W>
+  static void code(W& w, const T& v)
+  {
+    w.Reflective(CommObjectReader(getclassname<T>(),
+                                  reinterpret_cast<const void*>(&v)));
+  }
+};
+
+/** Typed coding of an enum value, with its name.
+
+    The default implementation uses the enum's print function. The
+    code generator specializes this for enums defined in objects with
+    the json option, to use getString directly.
+
+    @tparam T      Enum type.
+*/
+template<typename T>
+struct dco_enum_coder
+{
+  /** Code the enum value.
+
+      @param w     Coding writer.
+      @param v     Value to code. */
+  template<class W>
+  static void code(W& w, const T& v)
+  {
+    std::ostringstream o; o << v;
+    w.String(o.str().c_str());
+  }
+};
+
+/** Report a member value that cannot be coded, as the introspective
+    coding does.
+
+    @param coding  Name of the coding, for the message.
+    @param tname   Type name of the value. */
+void dco_typed_unknown(const char* coding, const char* tname);
+
+/** Code a single value, primitive or primitive-based */
+template<class W, typename T>
+inline void dco_code_value(W& w, const T& v, const dco_isdirect&)
+{ w.Value(v); }
+
+/** Code a single enum value, with its name */
+template<class W, typename T>
+inline void dco_code_value(W& w, const T& v, const dco_isenum&)
+{ dco_enum_coder<T>::code(w, v); }
+
+/** Code a single nested object */
+template<class W, typename T>
+inline void dco_code_value(W& w, const T& v, const dco_isnested&)
+{ dco_typed_coder<T>::code(w, v); }
+
+/** Code a single member */
+template<class W, typename T>
+inline void dco_code_member(W& w, const T& v, const dco_read_single&)
+{ dco_code_value(w, v, dco_nested<T>()); }
+
+/** Code an iterable member, as array */
+template<class W, typename T>
+inline void dco_code_member(W& w, const T& v, const dco_read_iterable&)
+{
+  w.StartArray(v.size());
+  for (const auto &e: v) {
+    dco_code_value(w, e, dco_nested<typename T::value_type>());
+  }
+  w.EndArray();
+}
+
+/** Code a mapped member */
+template<class W, typename T>
+inline void dco_code_member(W& w, const T& v, const dco_read_map&)
+{
+  w.StartMapped(v.size());
+  for (const auto &e: v) {
+    w.MappedKey();
+    dco_code_value(w, e.first, dco_nested<typename T::key_type>());
+    w.MappedValue();
+    dco_code_value(w, e.second, dco_nested<typename T::mapped_type>());
+    w.EndMappedElement();
+  }
+  w.EndMapped();
+}
+
+/** Code an optional member; as for introspection, only the value */
+template<class W, typename T>
+inline void dco_code_member(W& w, const T& v, const dco_read_optional&)
+{ dco_code_value(w, v.value, dco_nested<typename T::value_type>()); }
+
+/** Code a member with its key, as used in generated code.
+
+    @param w       Coding writer.
+    @param name    Member name.
+    @param v       Member value. */
+template<class W, typename T>
+inline void dco_code_member(W& w, const char* name, const T& v)
+{
+  w.Key(name);
+  dco_code_member(w, v, typename dco_traits<T>::rtype());
+}
+
+DUECA_NS_END;
+
+#endif
@@ -424,11 +424,37 @@ static void DCOtoJSON(WRITER& writer,
 }
 
 
+void dco_typed_unknown(const char* coding, const char* tname)
+{
+  /* DUECA JSON.
+
+     Have no mapping to serialize a DCO object member of this datatype
+     to JSON or msgpack. Use other datatypes in your DCO, or try to get
+     the serialize expanded. */
+  E_XTR("No mapping to serialize type '" << tname << "' to " << coding);
+}
+
+/** Code with the typed coder of the class, if available */
+template<typename WRITER>
+static inline bool DCOtoJSONtyped(WRITER& writer,
+                                  const CommObjectReader& reader,
+                                  bool strict)
+{
+  const DCOJSONMetaFunctor* coder = dynamic_cast<const DCOJSONMetaFunctor*>
+    (reader.findMetaFunctor("tojson"));
+  if (coder) {
+    coder->toJSON(writer, reader.getObject(), strict);
+    return true;
+  }
+  return false;
+}
+
 void DCOtoJSONcompact(json::StringBuffer &doc,
                       const char* dcoclass, const void* object)
 {
   CommObjectReader reader(dcoclass, object);
   json::Writer<json::StringBuffer> writer(doc);
+  if (DCOtoJSONtyped(writer, reader, false)) return;
   DCOtoJSON<json::Writer<json::StringBuffer>, writefloatflex<json::Writer<json::StringBuffer>,float>, writefloatflex<json::Writer<json::StringBuffer>,double> >(writer, reader);
 }
 
@@ -436,12 +462,14 @@ void DCOtoJSONcompact(json::StringBuffer &doc,
 void DCOtoJSONcompact(rapidjson::Writer<rapidjson::StringBuffer> &writer,
                       const CommObjectReader& reader)
 {
+  if (DCOtoJSONtyped(writer, reader, false)) return;
   DCOtoJSON<json::Writer<json::StringBuffer>, writefloatflex<json::Writer<json::StringBuffer>,float>, writefloatflex<json::Writer<json::StringBuffer>,double> >(writer, reader);
 }
 
 void DCOtoJSONcompact(rapidjson::Writer<rapidjson::OStreamWrapper> &writer,
                       const CommObjectReader& reader)
 {
+  if (DCOtoJSONtyped(writer, reader, false)) return;
   DCOtoJSON<json::Writer<json::OStreamWrapper>, writefloatflex<json::Writer<rapidjson::OStreamWrapper>,float>, writefloatflex<json::Writer<rapidjson::OStreamWrapper>,double> >(writer, reader);
 }
 
@@ -450,6 +478,7 @@ void DCOtoJSONstrict(json::StringBuffer &doc,
 {
   CommObjectReader reader(dcoclass, object);
   json::Writer<json::StringBuffer> writer(doc);
+  if (DCOtoJSONtyped(writer, reader, true)) return;
   DCOtoJSON<json::Writer<json::StringBuffer>, writefloatstrict<json::Writer<json::StringBuffer>,float>, writefloatstrict<json::Writer<json::StringBuffer>,double> >(writer, reader);
 }
 
@@ -457,12 +486,14 @@ void DCOtoJSONstrict(json::StringBuffer &doc,
 void DCOtoJSONstrict(rapidjson::Writer<rapidjson::StringBuffer> &writer,
                      const CommObjectReader& reader)
 {
+  if (DCOtoJSONtyped(writer, reader, true)) return;
   DCOtoJSON<json::Writer<json::StringBuffer>, writefloatstrict<json::Writer<json::StringBuffer>,float>, writefloatstrict<json::Writer<json::StringBuffer>,double> >(writer, reader);
 }
 
 void DCOtoJSONstrict(rapidjson::Writer<rapidjson::OStreamWrapper> &writer,
                      const CommObjectReader& reader)
 {
+  if (DCOtoJSONtyped(writer, reader, true)) return;
   DCOtoJSON<json::Writer<json::OStreamWrapper>, writefloatstrict<json::Writer<rapidjson::OStreamWrapper>,float>, writefloatstrict<json::Writer<json::OStreamWrapper>,double> >(writer, reader);
 }
 
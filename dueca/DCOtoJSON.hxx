@@ -23,6 +23,14 @@
 #include "rapidjson/writer.h"
 #include <rapidjson/stringbuffer.h>
 #include <dueca/CommObjectReader.hxx>
+#include <dueca/DCOTypedCoding.hxx>
+#include <dueca/DCOMetaFunctor.hxx>
+#include <dueca/Dstring.hxx>
+#include <type_traits>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include <typeinfo>
 
 /** @file DCOtoJSON.hxx
 
@@ -30,6 +38,7 @@
 
 DUECA_NS_START;
 class CommObjectReader;
+union ActivityContext;
 
 /** Convert the data from a DCO object to a JSON stringbuffer
 
@@ -114,9 +123,154 @@ void DCOtoJSONstrict(rapidjson::StringBuffer &doc,
 /** classname function, should exist for DCO objects */
 template <typename T> const char* getclassname();
 
+/** Coding writer for typed coding of DCO objects to JSON, see
+    DCOTypedCoding.hxx.
+
+    Produces the same JSON as the DCOtoJSONcompact and DCOtoJSONstrict
+    calls. As there, an ActivityContext is coded with its printed
+    value, and values of types without a JSON coding are coded as null,
+    with an error message.
+
+    @tparam WR      RapidJSON writer, with StringBuffer or
+                    OStreamWrapper.
+*/
+template<class WR>
+struct DCOJSONTypedWriter
+{
+  /** RapidJSON writer */
+  WR& writer;
+
+  /** Strict coding, NaN as null, and infinity as large floats */
+  bool strict;
+
+  /** Constructor
+
+      @param writer  RapidJSON writer.
+      @param strict  If true, code strict JSON. */
+  DCOJSONTypedWriter(WR& writer, bool strict) :
+    writer(writer), strict(strict) { }
+
+  inline void StartObject(size_t n) { writer.StartObject(); }
+  inline void EndObject() { writer.EndObject(); }
+  inline void Key(const char* k) { writer.Key(k); }
+  inline void StartArray(size_t n) { writer.StartArray(); }
+  inline void EndArray() { writer.EndArray(); }
+
+  /** mapped members are coded as an array of key/value objects */
+  inline void StartMapped(size_t n) { writer.StartArray(); }
+  inline void MappedKey() { writer.StartObject(); writer.Key("key"); }
+  inline void MappedValue() { writer.Key("value"); }
+  inline void EndMappedElement() { writer.EndObject(); }
+  inline void EndMapped() { writer.EndArray(); }
+
+  inline void String(const char* s) { writer.String(s); }
+
+  inline void Value(char c)
+  { const char tmp[2] = { c, '\0' }; writer.String(tmp, 1, true); }
+  inline void Value(uint8_t i) { writer.Uint(i); }
+  inline void Value(uint16_t i) { writer.Uint(i); }
+  inline void Value(uint32_t i) { writer.Uint(i); }
+  inline void Value(uint64_t i) { writer.Uint64(i); }
+  inline void Value(int8_t i) { writer.Int(i); }
+  inline void Value(int16_t i) { writer.Int(i); }
+  inline void Value(int32_t i) { writer.Int(i); }
+  inline void Value(int64_t i) { writer.Int64(i); }
+  inline void Value(bool b) { writer.Bool(b); }
+  inline void Value(float f) { Value(double(f)); }
+  inline void Value(double d)
+  {
+    if (!strict || std::isfinite(d)) { writer.Double(d); }
+    else if (std::isnan(d)) { writer.Null(); }
+    else { writer.Double(std::signbit(d) ? -1e200 : 1e200); }
+  }
+  inline void Value(const std::string& s)
+  { writer.String(s.data(), s.size()); }
+  template<unsigned mxsize>
+  inline void Value(const Dstring<mxsize>& s)
+  { writer.String(s.c_str(), s.size(), true); }
+
+  /** Other types; strings derived from std::string, ActivityContext,
+      or types without JSON coding */
+  template<typename T>
+  inline void Value(const T& v)
+  { ValueOther(v, std::is_base_of<std::string,T>()); }
+
+  template<typename T>
+  inline void ValueOther(const T& v, const std::true_type&)
+  { writer.String(v.data(), v.size()); }
+  template<typename T>
+  inline void ValueOther(const T& v, const std::false_type&)
+  { ValuePrinted(v, std::is_same<T,ActivityContext>()); }
+
+  template<typename T>
+  inline void ValuePrinted(const T& v, const std::true_type&)
+  { std::stringstream o; v.print(o); writer.String(o.str().c_str()); }
+  template<typename T>
+  inline void ValuePrinted(const T& v, const std::false_type&)
+  { dco_typed_unknown("JSON", typeid(T).name()); writer.Null(); }
+
+  /** Nested objects without typed coding */
+  inline void Reflective(const CommObjectReader& r);
+};
+
+/** Metafunctor for typed coding of a DCO object to JSON.
+
+    The code generator adds this metafunctor, with key "tojson", to
+    DCO objects with the json option. The DCOtoJSONcompact and
+    DCOtoJSONstrict calls use it when available.
+*/
+class DCOJSONMetaFunctor: public DCOMetaFunctor
+{
+public:
+  /** Code an object to JSON.
+
+      @param writer  RapidJSON writer object.
+      @param object  Pointer to the DCO object.
+      @param strict  If true, code strict JSON. */
+  virtual void toJSON(rapidjson::Writer<rapidjson::StringBuffer>& writer,
+                      const void* object, bool strict) const = 0;
+
+  /** Code an object to JSON.
+
+      @param writer  RapidJSON writer object.
+      @param object  Pointer to the DCO object.
+      @param strict  If true, code strict JSON. */
+  virtual void toJSON(rapidjson::Writer<rapidjson::OStreamWrapper>& writer,
+                      const void* object, bool strict) const = 0;
+};
+
+/** Implementation of the JSON metafunctor for a DCO object.
+
+    @tparam T      DCO object type, with a dco_typed_coder
+                   specialization.
+*/
+template<class T>
+class DCOJSONMetaFunctorImp: public DCOJSONMetaFunctor
+{
+public:
+  void toJSON(rapidjson::Writer<rapidjson::StringBuffer>& writer,
+              const void* object, bool strict) const final
+  {
+    DCOJSONTypedWriter<rapidjson::Writer<rapidjson::StringBuffer> >
+      w(writer, strict);
+    dco_typed_coder<T>::code(w, *reinterpret_cast<const T*>(object));
+  }
+
+  void toJSON(rapidjson::Writer<rapidjson::OStreamWrapper>& writer,
+              const void* object, bool strict) const final
+  {
+    DCOJSONTypedWriter<rapidjson::Writer<rapidjson::OStreamWrapper> >
+      w(writer, strict);
+    dco_typed_coder<T>::code(w, *reinterpret_cast<const T*>(object));
+  }
+};
+
 /** Convert the data from a DCO object into a JSON writer
     Templated version, directly access the (known) object.
 
+    Uses typed coding when the DCO object has the json option, and
+    introspection otherwise.
+
     @param writer   JSON writer object.
     @param object   Object to be read.
     @tparam WR      Compatible type for JSON writing
@@ -125,9 +279,15 @@ template <typename T> const char* getclassname();
 template<class WR, class DCO>
 void dco_to_json(WR &writer, const DCO& object)
 {
-  CommObjectReader reader(getclassname<DCO>(),
-			  reinterpret_cast<const void*>(&object));
-  DCOtoJSONstrict(writer, reader);
+  DCOJSONTypedWriter<WR> w(writer, true);
+  dco_typed_coder<DCO>::code(w, object);
+}
+
+template<class WR>
+inline void DCOJSONTypedWriter<WR>::Reflective(const CommObjectReader& r)
+{
+  if (strict) { DCOtoJSONstrict(writer, r); }
+  else { DCOtoJSONcompact(writer, r); }
 }
 
 DUECA_NS_END;
@@ -0,0 +1,166 @@
+/* ------------------------------------------------------------------   */
+/*      item            : DCOtoMsgpack.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Typed coding of DCO objects to msgpack
+        changes         : 261017 first version
+        api             : DUECA_API
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#ifndef DCOtoMsgpack_hxx
+#define DCOtoMsgpack_hxx
+
+#include <dueca_ns.h>
+#include <msgpack.hpp>
+#include <dueca/DCOTypedCoding.hxx>
+#include <dueca/DCOMetaFunctor.hxx>
+#include <dueca/Dstring.hxx>
+#include <type_traits>
+#include <typeinfo>
+#include <string>
+#include <cstring>
+
+/** @file DCOtoMsgpack.hxx
+
+    Typed conversion of DCO objects to msgpack. */
+
+DUECA_NS_START;
+
+/** Coding writer for typed coding of DCO objects to msgpack, see
+    DCOTypedCoding.hxx.
+
+    Produces the same msgpack as the introspective coding of the
+    websocket server; objects are coded as maps with the member names
+    as keys, enums with their names, and mapped members as maps.
+    Values of types without a msgpack coding are coded as nil, with an
+    error message.
+
+    @tparam S       Stream type for the msgpack packer.
+*/
+template<class S>
+struct DCOMsgpackTypedWriter
+{
+  /** Function for introspective coding */
+  typedef void (*reflective_coder)(msgpack::packer<S>& writer,
+                                   const CommObjectReader& reader);
+
+  /** msgpack packer */
+  msgpack::packer<S>& writer;
+
+  /** Introspective coding, for nested objects without typed coding */
+  reflective_coder reflective;
+
+  /** Constructor
+
+      @param writer     Packer object.
+      @param reflective Introspective coding function. */
+  DCOMsgpackTypedWriter(msgpack::packer<S>& writer,
+                        reflective_coder reflective) :
+    writer(writer), reflective(reflective) { }
+
+  inline void StartObject(size_t n) { writer.pack_map(n); }
+  inline void EndObject() { }
+  inline void Key(const char* k) { String(k); }
+  inline void StartArray(size_t n) { writer.pack_array(n); }
+  inline void EndArray() { }
+
+  inline void StartMapped(size_t n) { writer.pack_map(n); }
+  inline void MappedKey() { }
+  inline void MappedValue() { }
+  inline void EndMappedElement() { }
+  inline void EndMapped() { }
+
+  inline void String(const char* s)
+  {
+    const size_t l = std::strlen(s);
+    writer.pack_str(l);
+    writer.pack_str_body(s, l);
+  }
+
+  inline void Value(char c) { writer.pack_char(c); }
+  inline void Value(uint8_t i) { writer.pack_uint8(i); }
+  inline void Value(uint16_t i) { writer.pack_uint16(i); }
+  inline void Value(uint32_t i) { writer.pack_uint32(i); }
+  inline void Value(uint64_t i) { writer.pack_uint64(i); }
+  inline void Value(int8_t i) { writer.pack_int8(i); }
+  inline void Value(int16_t i) { writer.pack_int16(i); }
+  inline void Value(int32_t i) { writer.pack_int32(i); }
+  inline void Value(int64_t i) { writer.pack_int64(i); }
+  inline void Value(bool b)
+  { if (b) { writer.pack_true(); } else { writer.pack_false(); } }
+  inline void Value(float f) { writer.pack_float(f); }
+  inline void Value(double d) { writer.pack_double(d); }
+  inline void Value(const std::string& s)
+  { writer.pack_str(s.size()); writer.pack_str_body(s.data(), s.size()); }
+  template<unsigned mxsize>
+  inline void Value(const Dstring<mxsize>& s)
+  { writer.pack_str(s.size()); writer.pack_str_body(s.c_str(), s.size()); }
+
+  /** Other types; strings derived from std::string, or types without
+      msgpack coding */
+  template<typename T>
+  inline void Value(const T& v)
+  { ValueOther(v, std::is_base_of<std::string,T>()); }
+
+  template<typename T>
+  inline void ValueOther(const T& v, const std::true_type&)
+  { writer.pack_str(v.size()); writer.pack_str_body(v.data(), v.size()); }
+  template<typename T>
+  inline void ValueOther(const T& v, const std::false_type&)
+  { dco_typed_unknown("msgpack", typeid(T).name()); writer.pack_nil(); }
+
+  /** Nested objects without typed coding */
+  inline void Reflective(const CommObjectReader& r)
+  { reflective(writer, r); }
+};
+
+/** Metafunctor for typed coding of a DCO object to msgpack.
+
+    The code generator adds this metafunctor, with key "tomsgpack", to
+    DCO objects with the json option, when compiled with msgpack
+    (DUECA_CONFIG_MSGPACK) or websocket (DUECA_CONFIG_WEBSOCK)
+    support. The websocket server uses it when available.
+*/
+class DCOMsgpackMetaFunctor: public DCOMetaFunctor
+{
+public:
+  /** Function for introspective coding */
+  typedef DCOMsgpackTypedWriter<std::ostream>::reflective_coder
+  reflective_coder;
+
+  /** Code an object to msgpack.
+
+      @param writer     Packer object.
+      @param object     Pointer to the DCO object.
+      @param reflective Introspective coding, used for nested objects
+                        without typed coding. */
+  virtual void toMsgpack(msgpack::packer<std::ostream>& writer,
+                         const void* object,
+                         reflective_coder reflective) const = 0;
+};
+
+/** Implementation of the msgpack metafunctor for a DCO object.
+
+    @tparam T      DCO object type, with a dco_typed_coder
+                   specialization.
+*/
+template<class T>
+class DCOMsgpackMetaFunctorImp: public DCOMsgpackMetaFunctor
+{
+public:
+  void toMsgpack(msgpack::packer<std::ostream>& writer,
+                 const void* object,
+                 reflective_coder reflective) const final
+  {
+    DCOMsgpackTypedWriter<std::ostream> w(writer, reflective);
+    dco_typed_coder<T>::code(w, *reinterpret_cast<const T*>(object));
+  }
+};
+
+DUECA_NS_END;
+
+#endif
@@ -21,6 +21,7 @@
 #include <map>
 #include <debug.h>
 #include <string>
+#include <algorithm>
 #include <boost/scoped_ptr.hpp>
 
 DUECA_NS_START;
@@ -31,6 +32,12 @@ DUECA_NS_START;
 /** This describes the entries in the registry. */
 struct DCRegistryEntry
 {
+  /** Name of the class */
+  std::string classname;
+
+  /** Id of the class */
+  DataClassRegistry_id_type classid;
+
   /** Name of the parent, if applicable */
   std::string parent;
 
@@ -69,10 +76,14 @@ struct DCRegistryEntry
   unsigned n_in_parents;
 
 public:
-  DCRegistryEntry(const char* parent,
+  DCRegistryEntry(const char* classname,
+                  DataClassRegistry_id_type classid,
+                  const char* parent,
                   const CommObjectDataTable* table,
                   const functortable_type* functortable,
                   const DataSetConverter* converter) :
+    classname(classname),
+    classid(classid),
     parent(parent ? parent : ""),
     iparent(),
     table(table),
@@ -92,6 +103,15 @@ DataClassRegistry::DataClassRegistry()
 }
 
 
+/** Hash of the class names, for the lookup table */
+static inline uint32_t djb2(const std::string& s, uint32_t hash = 5381U)
+{
+  for (std::string::const_iterator it = s.begin(); it != s.end(); it++) {
+    hash = (hash << 5) + hash + uint32_t(*it);
+  }
+  return hash;
+}
+
 DataClassRegistry& DataClassRegistry::single()
 {
   static DataClassRegistry* one = new DataClassRegistry();
@@ -105,54 +125,72 @@ void DataClassRegistry::registerClass(const char* classname,
                                       const DataSetConverter* converter)
 {
   std::string classname_string(classname);
-  if (entries.find(classname) != entries.end()) {
+  assert(classname_string.size());
+  if (findId(classname_string) != dataclass_noid) {
     throw(DataObjectClassDoubleEntry(classname));
   }
-  entries.insert(map_type::value_type
-                 (std::string(classname),
-                  std::shared_ptr<DCRegistryEntry>
-                  (new DCRegistryEntry(parent, table,
-                                       functortable, converter))));
-  assert(entries.find(std::string("")) == entries.end());
+
+  // new id, and insert in the lookup table
+  const DataClassRegistry_id_type classid = entries.size();
+  entries.push_back(std::shared_ptr<DCRegistryEntry>
+                    (new DCRegistryEntry(classname, classid, parent, table,
+                                         functortable, converter)));
+  const index_type::value_type key(djb2(classname_string), classid);
+  index.insert(std::upper_bound(index.begin(), index.end(), key), key);
+}
+
+DataClassRegistry_id_type
+DataClassRegistry::findId(const std::string& classname) const
+{
+  const uint32_t hash = djb2(classname);
+  for (index_type::const_iterator ii = std::lower_bound
+         (index.begin(), index.end(), index_type::value_type(hash, 0U));
+       ii != index.end() && ii->first == hash; ii++) {
+    if (entries[ii->second]->classname == classname) {
+      return ii->second;
+    }
+  }
+  return dataclass_noid;
+}
+
+DataClassRegistry_id_type
+DataClassRegistry::getClassId(const std::string& classname) const
+{
+  const DataClassRegistry_id_type classid = findId(classname);
+  if (classid == dataclass_noid) throw(DataObjectClassNotFound(classname));
+  return classid;
 }
 
 const CommObjectDataTable*
 DataClassRegistry::getTable(const std::string& classname)
 {
-  map_type::const_iterator ix = entries.find(classname);
-  if (ix == entries.end()) throw(DataObjectClassNotFound(classname));
-  return ix->second->table;
+  return entries[getClassId(classname)]->table;
 }
 
 bool DataClassRegistry::isRegistered(const std::string& classname)
 {
-  return bool(entries.count(classname));
+  return findId(classname) != dataclass_noid;
 }
 
-inline uint32_t djb2(const std::string& s, uint32_t hash)
+DataClassRegistry_entry_type DataClassRegistry::getEntry
+(const std::string& classname)
 {
-  for (std::string::const_iterator it = s.begin(); it != s.end(); it++) {
-    hash = (hash << 5) + hash + uint32_t(*it);
-  }
-  return hash;
+  return getEntry(getClassId(classname));
 }
 
 DataClassRegistry_entry_type DataClassRegistry::getEntry
-(const std::string& classname)
+(DataClassRegistry_id_type classid)
 {
-  map_type::iterator ix = entries.find(classname);
-  if (ix == entries.end()) throw(DataObjectClassNotFound(classname));
-  completeIndices(ix->second);
-  return ix->second.get();
+  completeIndices(entries[classid]);
+  return entries[classid].get();
 }
 
 DataClassRegistry::map_type::mapped_type DataClassRegistry::getEntryShared
 (const std::string& classname)
 {
-  map_type::iterator ix = entries.find(classname);
-  if (ix == entries.end()) throw(DataObjectClassNotFound(classname));
-  completeIndices(ix->second);
-  return ix->second;
+  const map_type::mapped_type& ix = entries[getClassId(classname)];
+  completeIndices(ix);
+  return ix;
 }
 
 const CommObjectMemberAccessBasePtr& DataClassRegistry::
@@ -280,26 +318,42 @@ unsigned DataClassRegistry::completeIndices(map_type::mapped_type ix)
 const std::string&
 DataClassRegistry::getParent(const std::string& classname)
 {
-  map_type::const_iterator ix = entries.find(classname);
-  if (ix == entries.end()) throw(DataObjectClassNotFound(classname));
-  return ix->second->parent;
+  return entries[getClassId(classname)]->parent;
+}
+
+DataClassRegistry_id_type
+DataClassRegistry::getParentId(DataClassRegistry_id_type classid)
+{
+  auto ix = getEntry(classid);
+  return ix->iparent ? ix->iparent->classid : dataclass_noid;
 }
 
 const DataSetConverter*
 DataClassRegistry::getConverter(const std::string& classname) const
 {
-  map_type::const_iterator ix = entries.find(classname);
-  if (ix == entries.end()) throw(DataObjectClassNotFound(classname));
-  return ix->second->converter.get();
+  return entries[getClassId(classname)]->converter.get();
+}
+
+const DataSetConverter*
+DataClassRegistry::getConverter(DataClassRegistry_id_type classid) const
+{
+  return entries[classid]->converter.get();
 }
 
 bool DataClassRegistry::isCompatible(const std::string& tryclass,
                                      const std::string& classname)
 {
-  auto ix = getEntry(classname);
   if (tryclass == classname) return true;
+  const DataClassRegistry_id_type tryid = findId(tryclass);
+  return tryid != dataclass_noid && isCompatible(tryid, getClassId(classname));
+}
+
+bool DataClassRegistry::isCompatible(DataClassRegistry_id_type tryclass,
+                                     DataClassRegistry_id_type classid)
+{
+  auto ix = getEntry(classid);
   while (ix) {
-    if (ix->parent == tryclass) return true;
+    if (ix->classid == tryclass) return true;
     ix = ix->iparent.get();
   }
   return false;
@@ -309,15 +363,23 @@ std::weak_ptr<DCOMetaFunctor>
 DataClassRegistry::getMetaFunctor(const std::string& classname,
                                   const std::string& fname) const
 {
-  map_type::const_iterator ix = entries.find(classname);
-  if (ix == entries.end()) throw(DataObjectClassNotFound(classname));
+  const map_type::mapped_type& ix = entries[getClassId(classname)];
 
-  functortable_type::const_iterator fi = ix->second->functortable->find(fname);
-  if (fi == ix->second->functortable->end()) throw(UndefinedFunctor(classname));
+  functortable_type::const_iterator fi = ix->functortable->find(fname);
+  if (fi == ix->functortable->end()) throw(UndefinedFunctor(classname));
 
   return std::weak_ptr<DCOMetaFunctor>(fi->second);
 }
 
+DCOMetaFunctor*
+DataClassRegistry::findMetaFunctor(DataClassRegistry_entry_type ix,
+                                   const std::string& fname) const
+{
+  if (ix->functortable == NULL) return NULL;
+  functortable_type::const_iterator fi = ix->functortable->find(fname);
+  return fi == ix->functortable->end() ? NULL : fi->second.get();
+}
+
 DataObjectClassNotFound::DataObjectClassNotFound(const std::string& msg) :
   MsgException("Registry does not contain DCO class ", msg.c_str())
 { }
@@ -27,6 +27,11 @@ DUECA_NS_START;
     Note that most of the interfaces of this class are being used
     internally by DUECA. For some external projects it may be useful
     to inspect DCO classes.
+
+    Each registered class gets an integer id. Lookup of a class name
+    uses a sorted table of name hashes, so it needs only integer
+    comparisons and (normally) a single string comparison. Where
+    possible, use the class ids in repeated lookups.
 */
 class DataClassRegistry
 {
@@ -34,11 +39,20 @@ class DataClassRegistry
       all necessary meta-information. */
   typedef DataClassRegistry_map_type  map_type;
 
-  /** iterator for running over the map */
-  typedef map_type::const_iterator map_iterator;
+  /** The actual entries, indexed by class id. */
+  std::vector<map_type::mapped_type> entries;
+
+  /** Type for the name lookup table, name hash and class id */
+  typedef std::vector<std::pair<uint32_t,DataClassRegistry_id_type> >
+  index_type;
 
-  /** The map with the actual entries. */
-  map_type entries;
+  /** Name lookup table, sorted on hash */
+  index_type index;
+
+  /** Find the id of a class.
+      @param classname   name of the data class
+      @returns           Class id, or dataclass_noid if not registered */
+  DataClassRegistry_id_type findId(const std::string& classname) const;
 
   /** Constructor */
   DataClassRegistry();
@@ -73,6 +87,20 @@ public:
   */
   map_type::mapped_type getEntryShared(const std::string& classname);
 
+  /** Return the integer id for a class.
+
+      @param classname   name of the data class
+      @returns           Class id, valid during the process lifetime
+  */
+  DataClassRegistry_id_type getClassId(const std::string& classname) const;
+
+  /** Return a quick-access entry index given a class id
+
+      @param classid     id of the data class
+      @returns           An index to the entry
+  */
+  DataClassRegistry_entry_type getEntry(DataClassRegistry_id_type classid);
+
 private:
   /** registration of a new DCO object type; is commonly done
       automatically, at start-up time. */
@@ -155,6 +183,14 @@ public:
   */
   const std::string& getParent(const std::string& classname);
 
+  /** Get the id of the parent class
+
+      @param classid     child class id
+      @returns           id of the parent class, or dataclass_noid if no
+                         parent available.
+  */
+  DataClassRegistry_id_type getParentId(DataClassRegistry_id_type classid);
+
   /** See whether a class is a parent of (compatible with reading) 
       another class.
       
@@ -164,12 +200,27 @@ public:
   bool isCompatible(const std::string& tryclass, 
                     const std::string& classname);
 
+  /** See whether a class is a parent of (compatible with reading)
+      another class, using class ids.
+
+      @param tryclass    Class you want to access/read with
+      @param classid     Class given.
+      */
+  bool isCompatible(DataClassRegistry_id_type tryclass,
+                    DataClassRegistry_id_type classid);
+
   /** Get a pointer to the dataset converter for this data type.
 
       @param classname   data type class name
       @returns           a pointer to the converter */
   const DataSetConverter* getConverter(const std::string& classname) const;
 
+  /** Get a pointer to the dataset converter for this data type.
+
+      @param classid     data type class id
+      @returns           a pointer to the converter */
+  const DataSetConverter* getConverter(DataClassRegistry_id_type classid) const;
+
   /** Get a metafunctor, searched by name
 
       Functors are used to implement specific services on dataclasses.
@@ -185,6 +236,19 @@ public:
   */
   std::weak_ptr<DCOMetaFunctor>
   getMetaFunctor(const std::string& classname, const std::string& fname) const;
+
+  /** Find a metafunctor for a quick-access entry
+
+      Contrary to getMetaFunctor, this does not throw when the functor
+      is not available, so it can be used to test for optional
+      services on the class.
+
+      @param ix          index returned by the getEntry call
+      @param fname       functor name
+      @returns           pointer to the metafunctor, NULL if not defined
+  */
+  DCOMetaFunctor* findMetaFunctor(DataClassRegistry_entry_type ix,
+                                  const std::string& fname) const;
 };
 
 DUECA_NS_END;
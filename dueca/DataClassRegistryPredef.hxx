@@ -19,7 +19,9 @@
 #include <dueca_ns.h>
 #include <Exception.hxx>
 #include <map>
+#include <vector>
 #include <string>
+#include <inttypes.h>
 #include <memory>
 #include <boost/scoped_ptr.hpp>
 #include <dueca/visibility.h>
@@ -42,6 +44,15 @@ typedef std::map<const std::string,std::shared_ptr<DCRegistryEntry> >
 //typedef DataClassRegistry_map_type::mapped_type DataClassRegistry_entry_type;
 typedef const DCRegistryEntry* DataClassRegistry_entry_type;
 
+/** Integer id of a class in the DataClassRegistry. Ids are issued in
+    order of registration, and remain valid while the process runs;
+    they differ between DUECA processes. */
+typedef uint32_t DataClassRegistry_id_type;
+
+/** Id value indicating no class, e.g. for the parent of a class
+    without parent. */
+const DataClassRegistry_id_type dataclass_noid = 0xffffffff;
+
 /** Exception thrown when the class name searched has not been registered */
 class DataObjectClassNotFound: public MsgException<128>
 {
@@ -56,6 +56,11 @@ public:
       initialization (which can be none!) is done */
   virtual void* clone(const void* ref) const = 0;
 
+  /** Re-use an object obtained earlier from clone or create, by
+      assigning the value of ref to it. If ref is NULL, a default
+      value is assigned. Returns the target. */
+  virtual void* cloneInto(void* target, const void* ref) const = 0;
+
   /** Delete an object of said data type. */
   // virtual void delData(void* data) const = 0;
 
@@ -80,6 +85,11 @@ public:
 
   /** Return the class name */
   virtual const char* getClassname() const = 0;
+
+  /** Check whether objects can be copied as raw memory
+      @returns           true if the class has only fixed-size data
+  */
+  virtual bool rawCopyable() const = 0;
 };
 
 DUECA_NS_END
@@ -49,6 +49,9 @@ public:
   /** Clone an object */
   void* clone(const void* ref=0) const;
 
+  /** Assign to an existing object */
+  void* cloneInto(void* target, const void* ref) const;
+
   /** Delete one object. */
   void delData(const void* data) const;
 
@@ -70,6 +73,9 @@ public:
 
   /** Return the class name */
   const char* getClassname() const;
+
+  /** Check whether objects can be copied as raw memory */
+  bool rawCopyable() const;
 };
 DUECA_NS_END
 
@@ -85,6 +91,7 @@ DUECA_NS_END
 #define DataSetSubsidiary_ii
 
 #include "AmorphStore.hxx"
+#include "CommObjectTraits.hxx"
 
 DUECA_NS_START
 template<class T>
@@ -140,6 +147,18 @@ clone(const void* ref) const
   return data;
 }
 
+template<class T> void* DataSetSubsidiary<T>::
+cloneInto(void* target, const void* ref) const
+{
+  if (ref == NULL) {
+    *reinterpret_cast<T*>(target) = T();
+  }
+  else {
+    *reinterpret_cast<T*>(target) = *reinterpret_cast<const T*>(ref);
+  }
+  return target;
+}
+
 template<class T> void DataSetSubsidiary<T>::delData(const void* data) const
 {
   delete reinterpret_cast<const T*>(data);
@@ -174,6 +193,11 @@ getClassname() const
   return getclassname<T>();
 }
 
+template<class T> bool DataSetSubsidiary<T>::rawCopyable() const
+{
+  return dco_rawcopy<T>::value;
+}
+
 DUECA_NS_END
 #endif
 #endif
@@ -23,6 +23,7 @@
 #include "ScriptInterpret.hxx"
 #include "ObjectManager.hxx"
 #include "ActivityManager.hxx"
+#include "UChannelEntry.hxx"
 #include <oddoptions.h>
 #include <TimeKeeper.hxx>
 #include <Condition.hxx>
@@ -124,6 +125,14 @@ Environment::Environment() :
   NamedObject(
     NameSet("dueca", "Environment", ObjectManager::single()->getLocation())),
   run_mode(MultiThread),
+  heap_scheduling(false),
+  lockfree_wake(false),
+  wake_spin(200),
+  am_workers(),
+  full_pack_interval(0U),
+  shm_channel_slots(0U),
+  latest_value_copy(false),
+  deferred_log_slots(0U),
   highest_priority(0),
   current_highprio(0),
   running_multithread(false),
@@ -241,12 +250,29 @@ bool Environment::complete()
   // the activity managers) can be made for higher priorities
   ActivityManager::setMaxPrio(highest_priority);
 
+  // periodic full packing of channel data
+  UChannelEntry::setFullPackInterval(full_pack_interval);
+
+  // shared memory transport of channel data
+  UChannelEntry::setShmSlots(shm_channel_slots);
+
+  // uncounted reading of the latest channel data
+  UChannelEntry::setLatestCopy(latest_value_copy);
+
+#ifdef NEW_LOGGING
+  // formatting of log messages in the log concentrator
+  LogConcentrator::single().setDeferred(deferred_log_slots);
+#endif
+
   // create the activity managers
   int prio = 0;
   for (list<SchedPriority>::const_iterator ii = sched_priorities.begin();
        ii != sched_priorities.end(); ii++) {
+    unsigned workers = prio < int(am_workers.size()) ? am_workers[prio] : 1;
     activity_manager.push_back(
-      new ActivityManager(prio, ii->sched_mode, ii->sched_prio));
+      new ActivityManager(prio, ii->sched_mode, ii->sched_prio,
+                          heap_scheduling, lockfree_wake, wake_spin,
+                          workers));
     prio++;
   }
 
@@ -307,6 +333,58 @@ const ParameterTable *Environment::getParameterTable()
       new MemberCall<Environment, vector<int>>(&Environment::setAMFiFo),
       "Add activity priority level with first-in, first-out scheduling\n"
       "See above for explanation on priority levels" },
+    { "heap-scheduling",
+      new VarProbe<Environment, bool>(
+        REF_MEMBER(&Environment::heap_scheduling)),
+      "(default false) order the scheduled activities in priority levels\n"
+      "above 0 with a binary heap, instead of an ordered list. This is\n"
+      "more efficient when many activities are queued at once." },
+    { "lockfree-wake",
+      new VarProbe<Environment, bool>(
+        REF_MEMBER(&Environment::lockfree_wake)),
+      "(default false) wake the activity managers in priority levels above\n"
+      "0 with an event count instead of a mutex and condition. Triggering\n"
+      "threads then only make a system call when the thread is asleep" },
+    { "wake-spin",
+      new VarProbe<Environment, unsigned>(
+        REF_MEMBER(&Environment::wake_spin)),
+      "(default 200) with lockfree-wake, number of times the activity\n"
+      "manager polls for new work before putting its thread to sleep" },
+    { "priority-workers",
+      new MemberCall<Environment, vector<int>>(&Environment::setAMWorkers),
+      "Number of threads for each priority level, starting with level 0.\n"
+      "Levels above 0 with more than one thread run different activities\n"
+      "in parallel; the activations of a single activity remain in order,\n"
+      "and never overlap. Level 0 always uses one thread, lockfree-wake\n"
+      "is not used for levels with multiple threads" },
+    { "full-pack-interval",
+      new VarProbe<Environment, unsigned>(
+        REF_MEMBER(&Environment::full_pack_interval)),
+      "(default 0) for channel entries written with mixed packing, send\n"
+      "a full data pack after this number of differential packs, so\n"
+      "receivers can re-synchronise. 0 sends only differential packs\n"
+      "after the first full pack, unless there is a gap in the data" },
+    { "shm-channel-slots",
+      new VarProbe<Environment, unsigned>(
+        REF_MEMBER(&Environment::shm_channel_slots)),
+      "(default 0) when non-zero, data of channel entries written here,\n"
+      "with a data class of fixed size, is copied into a shared memory\n"
+      "ring with this number of slots, and only a notification is packed\n"
+      "for transport. Only usable when all DUECA nodes run on one host" },
+    { "latest-value-copy",
+      new VarProbe<Environment, bool>(
+        REF_MEMBER(&Environment::latest_value_copy)),
+      "(default false) keep a copy of the latest data in stream channel\n"
+      "entries with a data class of fixed size, protected by a sequence\n"
+      "lock. Readers of the latest value then copy the data, instead of\n"
+      "counting their access to the entry's data" },
+    { "deferred-log-slots",
+      new VarProbe<Environment, unsigned>(
+        REF_MEMBER(&Environment::deferred_log_slots)),
+      "(default 0) when non-zero, log messages are not formatted by the\n"
+      "logging thread, but copied in binary form into a per-thread buffer\n"
+      "with this number of slots, and formatted by the log concentrator.\n"
+      "Messages are dropped when a buffer is full" },
     { "x-multithread-lock",
       new VarProbe<Environment, bool>(REF_MEMBER(&Environment::xlib_lock)),
       "initialise the Xlib lock, to allow for multi-threaded access to X\n"
@@ -402,6 +480,24 @@ bool Environment::setAMNice(const vector<int> &level)
   return true;
 }
 
+bool Environment::setAMWorkers(const vector<int> &workers)
+{
+  for (unsigned int ii = 0; ii < workers.size(); ii++) {
+    if (workers[ii] < 1 || workers[ii] > 64) {
+      /* DUECA system.
+
+         An error in your activity level configuration, the number of
+         threads for a priority level should be between 1 and 64.
+         Adjust configuration file on the affected node. */
+      E_CNF("Environment: Illegal number of threads " << workers[ii] <<
+            " for priority level " << ii);
+      return false;
+    }
+  }
+  am_workers = workers;
+  return true;
+}
+
 bool Environment::setAMRoundRobin(const vector<int> &level)
 {
   for (unsigned int ii = 0; ii < level.size(); ii++) {
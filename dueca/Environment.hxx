@@ -89,6 +89,36 @@ private:
   /** Scheduling priorities for the different activity managers. */
   list<SchedPriority> sched_priorities;
 
+  /** Use a binary heap for ordering activities in the activity
+      managers with priority > 0. */
+  bool heap_scheduling;
+
+  /** Wake the activity managers with priority > 0 without a mutex,
+      through an event count. */
+  bool lockfree_wake;
+
+  /** With lockfree_wake, number of polls before parking a thread. */
+  unsigned wake_spin;
+
+  /** Number of threads for each activity manager, from level 0 up. */
+  vector<int> am_workers;
+
+  /** Number of differential packs between full packs, for channel
+      entries with mixed packing. */
+  unsigned full_pack_interval;
+
+  /** Number of slots in shared memory rings for channel data, 0 for
+      transport by packing only. */
+  unsigned shm_channel_slots;
+
+  /** Keep a sequence-locked copy of the latest data in stream channel
+      entries, for readers of the latest value. */
+  bool latest_value_copy;
+
+  /** Number of log messages buffered per thread for deferred
+      formatting, 0 to format directly. */
+  unsigned deferred_log_slots;
+
   /** dummy parameter. */
   int rt_mode;
 
@@ -378,6 +408,9 @@ public:
   /** Call to add real-time threads with XENOMAI scheduling. */
   bool setAMXENO(const vector<int>& levels);
 
+  /** Call to set the number of threads for the priority levels. */
+  bool setAMWorkers(const vector<int>& workers);
+
   /** Get the current gui handler. */
   inline GuiHandler* getActiveGuiHandler() {return gui_handler; }
 
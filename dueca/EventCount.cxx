@@ -0,0 +1,138 @@
+/* ------------------------------------------------------------------   */
+/*      item            : EventCount.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define EventCount_cxx
+#include "EventCount.hxx"
+#include <dueca-conf.h>
+#include <atomic>
+#include <climits>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <pthread.h>
+#endif
+
+#define DEBPRINTLEVEL -1
+#include <debprint.h>
+
+DUECA_NS_START
+
+/** Implementation-dependent data for parking the waiting thread. */
+class EventCountData
+{
+#if !defined(__linux__)
+  /** Mutex for the parking condition */
+  pthread_mutex_t mutex;
+
+  /** Condition for parking */
+  pthread_cond_t  condition;
+#endif
+
+public:
+#if defined(__linux__)
+  EventCountData() { }
+
+  ~EventCountData() { }
+
+  /** Sleep while the epoch is still at key */
+  inline void park(volatile void* epoch, uint32_t key)
+  {
+    syscall(SYS_futex, epoch, FUTEX_WAIT_PRIVATE, key, NULL, NULL, 0);
+  }
+
+  /** Wake the parked thread(s) */
+  inline void unpark(volatile void* epoch)
+  {
+    syscall(SYS_futex, epoch, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+  }
+#else
+  EventCountData()
+  {
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&condition, NULL);
+  }
+
+  ~EventCountData()
+  {
+    pthread_cond_destroy(&condition);
+    pthread_mutex_destroy(&mutex);
+  }
+
+  /** Sleep while the epoch is still at key */
+  inline void park(volatile void* epoch, uint32_t key)
+  {
+    pthread_mutex_lock(&mutex);
+    while (*reinterpret_cast<volatile uint32_t*>(epoch) == key) {
+      pthread_cond_wait(&condition, &mutex);
+    }
+    pthread_mutex_unlock(&mutex);
+  }
+
+  /** Wake the parked thread(s) */
+  inline void unpark(volatile void* epoch)
+  {
+    pthread_mutex_lock(&mutex);
+    pthread_cond_broadcast(&condition);
+    pthread_mutex_unlock(&mutex);
+  }
+#endif
+};
+
+EventCount::EventCount() :
+  epoch(0U),
+  waiters(0U),
+  my(new EventCountData())
+{
+  //
+}
+
+EventCount::~EventCount()
+{
+  delete my;
+}
+
+uint32_t EventCount::prepareWait()
+{
+  // the waiter count must be visible before the epoch is read, and
+  // before the caller re-checks for work
+  atomic_increment32(waiters);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return atomic_access(epoch);
+}
+
+void EventCount::cancelWait()
+{
+  atomic_decrement32(waiters);
+}
+
+void EventCount::wait(uint32_t key)
+{
+  DEB("event count parking at " << key);
+  my->park(&epoch, key);
+  atomic_decrement32(waiters);
+}
+
+void EventCount::notify()
+{
+  // work has been published by the caller before this
+  atomic_increment32(epoch);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (atomic_access(waiters)) {
+    DEB("event count waking");
+    my->unpark(&epoch);
+  }
+}
+
+DUECA_NS_END
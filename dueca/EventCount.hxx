@@ -0,0 +1,87 @@
+/* ------------------------------------------------------------------   */
+/*      item            : EventCount.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Wait and resume without mutex for the producer
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#pragma once
+
+#include "DAtomics.hxx"
+#include <cstdint>
+#include <dueca_ns.h>
+
+DUECA_NS_START
+
+class EventCountData;
+
+/** Event count, for waking a single consumer thread.
+
+    Alternative to the Condition, for the case where producers add
+    work to a lock-free queue (such as the AsyncQueueMT), and a
+    consumer thread waits for that work. Producers only increment a
+    counter, and make a system call only when the consumer is actually
+    parked. The consumer follows this pattern:
+
+    @code
+    while (!work_available()) {
+      uint32_t key = ec.prepareWait();
+      if (work_available()) { ec.cancelWait(); break; }
+      ec.wait(key);
+    }
+    @endcode
+
+    On Linux a futex is used for parking, elsewhere a pthread
+    condition.
+*/
+class EventCount
+{
+  /** Incremented at each notify */
+  atom_type<uint32_t>::type epoch;
+
+  /** Number of threads preparing to wait or waiting */
+  atom_type<uint32_t>::type waiters;
+
+  /** Implementation-dependent data for parking */
+  EventCountData* my;
+
+public:
+  /** Constructor. */
+  EventCount();
+
+  /** Destructor. */
+  ~EventCount();
+
+  /** Announce an upcoming wait, after this re-check for work.
+      @returns   Key to pass to wait. */
+  uint32_t prepareWait();
+
+  /** Cancel the wait, work was found in the re-check. */
+  void cancelWait();
+
+  /** Park, unless a notify came after prepareWait.
+      @param key  Key from prepareWait. */
+  void wait(uint32_t key);
+
+  /** Notify the waiting thread, if any. */
+  void notify();
+};
+
+/** Processor hint for a busy-wait loop. */
+inline void cpuRelax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#else
+  asm volatile("" ::: "memory");
+#endif
+}
+
+DUECA_NS_END
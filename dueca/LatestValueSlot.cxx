@@ -0,0 +1,112 @@
+/* ------------------------------------------------------------------   */
+/*      item            : LatestValueSlot.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define LatestValueSlot_cxx
+#include "LatestValueSlot.hxx"
+#include <cstring>
+
+DUECA_NS_START
+
+/** Number of copy attempts before a reader gives up */
+static const unsigned read_attempts = 4U;
+
+/** Size of the words in the buffer */
+static const uint32_t wsize = sizeof(uint64_t);
+
+/** Copy an object into the buffer words */
+static inline void copyIn(std::atomic<uint64_t>* words, const void* data,
+                          uint32_t objsize)
+{
+  const char* src = reinterpret_cast<const char*>(data);
+  uint32_t ii = 0U;
+  for (; (ii + 1U) * wsize <= objsize; ii++) {
+    uint64_t w;
+    std::memcpy(&w, src + ii * wsize, wsize);
+    words[ii].store(w, std::memory_order_relaxed);
+  }
+  if (ii * wsize < objsize) {
+    uint64_t w = 0U;
+    std::memcpy(&w, src + ii * wsize, objsize - ii * wsize);
+    words[ii].store(w, std::memory_order_relaxed);
+  }
+}
+
+/** Copy the buffer words into an object */
+static inline void copyOut(void* data, const std::atomic<uint64_t>* words,
+                           uint32_t objsize)
+{
+  char* dst = reinterpret_cast<char*>(data);
+  uint32_t ii = 0U;
+  for (; (ii + 1U) * wsize <= objsize; ii++) {
+    const uint64_t w = words[ii].load(std::memory_order_relaxed);
+    std::memcpy(dst + ii * wsize, &w, wsize);
+  }
+  if (ii * wsize < objsize) {
+    const uint64_t w = words[ii].load(std::memory_order_relaxed);
+    std::memcpy(dst + ii * wsize, &w, objsize - ii * wsize);
+  }
+}
+
+LatestValueSlot::LatestValueSlot(uint32_t objsize) :
+  lock(0U),
+  seqid(0U),
+  t_start(0U),
+  t_end(0U),
+  objsize(objsize),
+  nwords((objsize + wsize - 1U) / wsize),
+  buffer(new std::atomic<uint64_t>[nwords])
+{
+  for (unsigned ii = nwords; ii--; ) {
+    buffer[ii].store(0U, std::memory_order_relaxed);
+  }
+}
+
+LatestValueSlot::~LatestValueSlot()
+{
+  delete [] buffer;
+}
+
+void LatestValueSlot::publish(uint32_t seqid, const DataTimeSpec& ts,
+                              const void* data)
+{
+  const uint32_t l = lock.load(std::memory_order_relaxed);
+  lock.store(l + 1U, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  copyIn(buffer, data, objsize);
+  this->seqid.store(seqid, std::memory_order_relaxed);
+  t_start.store(ts.getValidityStart(), std::memory_order_relaxed);
+  t_end.store(ts.getValidityEnd(), std::memory_order_relaxed);
+  lock.store(l + 2U, std::memory_order_release);
+}
+
+bool LatestValueSlot::read(void* data, uint32_t& seqid,
+                           DataTimeSpec& ts) const
+{
+  for (unsigned ii = read_attempts; ii--; ) {
+    const uint32_t l = lock.load(std::memory_order_acquire);
+    if (l == 0U) return false;
+    if (l & 1U) continue;
+    copyOut(data, buffer, objsize);
+    const uint32_t sid = this->seqid.load(std::memory_order_relaxed);
+    const TimeTickType t0 = t_start.load(std::memory_order_relaxed);
+    const TimeTickType t1 = t_end.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (lock.load(std::memory_order_relaxed) == l) {
+      seqid = sid;
+      ts = DataTimeSpec(t0, t1);
+      return true;
+    }
+  }
+  return false;
+}
+
+DUECA_NS_END
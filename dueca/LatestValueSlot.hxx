@@ -0,0 +1,91 @@
+/* ------------------------------------------------------------------   */
+/*      item            : LatestValueSlot.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Sequence-locked copy of the latest data in an
+                          entry
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "TimeSpec.hxx"
+#include <dueca_ns.h>
+
+DUECA_NS_START
+
+/** Copy of the latest data written in a stream channel entry,
+    protected by a sequence lock.
+
+    The writer of the entry copies each new data object into the
+    slot, as raw memory. Readers that only need the latest value copy
+    the data optimistically into their own object, and check
+    afterwards that the slot was not modified while copying. Contrary
+    to normal access to the entry's data, the readers do not modify
+    any shared counters, so many readers of a single entry do not
+    contend for a cache line.
+
+    The data is copied through relaxed atomic 64-bit words, not with
+    memcpy. A plain copy under the sequence lock would be a data race
+    in the C++ memory model, even though torn copies are discarded,
+    and would be reported by the thread sanitizer. On common
+    platforms the relaxed word accesses compile to normal loads and
+    stores.
+
+    Only usable for data classes for which the dco_rawcopy trait is
+    true; objects of fixed size, without pointers. There must be a
+    single writer.
+*/
+class LatestValueSlot
+{
+  /** Sequence lock, odd while the writer updates the slot */
+  std::atomic<uint32_t>     lock;
+
+  /** Sequence number of the data in the entry, 0 when no data */
+  std::atomic<uint32_t>     seqid;
+
+  /** Start of the data validity */
+  std::atomic<TimeTickType> t_start;
+
+  /** End of the data validity */
+  std::atomic<TimeTickType> t_end;
+
+  /** Size of the data objects */
+  uint32_t                  objsize;
+
+  /** Number of words in the buffer */
+  uint32_t                  nwords;
+
+  /** Copy of the latest data, in words */
+  std::atomic<uint64_t>*    buffer;
+
+public:
+  /** Constructor.
+      \param objsize   Size of the data objects. */
+  LatestValueSlot(uint32_t objsize);
+
+  /** Destructor */
+  ~LatestValueSlot();
+
+  /** Copy new data into the slot, writing end.
+      \param seqid     Sequence number of the data in the entry.
+      \param ts        Validity of the data.
+      \param data      Data object, objsize bytes. */
+  void publish(uint32_t seqid, const DataTimeSpec& ts, const void* data);
+
+  /** Copy the latest data from the slot.
+      \param data      Destination, objsize bytes.
+      \param seqid     Sequence number of the copied data.
+      \param ts        Validity of the copied data.
+      \returns         false if there is no data yet, or the data was
+                       repeatedly modified while copying. */
+  bool read(void* data, uint32_t& seqid, DataTimeSpec& ts) const;
+};
+
+DUECA_NS_END
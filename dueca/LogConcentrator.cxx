@@ -25,6 +25,9 @@
 #include <LogPoint.hxx>
 #include <InformationStash.ixx>
 #include <PeriodicAlarm.hxx>
+#include "LogRing.hxx"
+#include <sstream>
+#include <cstdlib>
 #include <Ticker.hxx>
 #include <algorithm>
 #include <DataReader.hxx>
@@ -70,6 +73,12 @@ void LogConcentrator::print(std::ostream& os, const LogMessage& msg)
 /** A function that returns the stash singleton */
 InformationStash<LogPoint>& Logpoint_stash();
 
+/** Format the remaining deferred messages at program exit */
+static void flushDeferredAtExit()
+{
+  LogConcentrator::single().flushDeferred();
+}
+
 LogConcentrator::LogConcentrator() :
   StateGuard("log concentrator", false),
   id(NULL),
@@ -81,6 +90,12 @@ LogConcentrator::LogConcentrator() :
   r_level(NULL),
   w_level(),
   cb_initial(this, &LogConcentrator::cbLoadInitial),
+  deferred_slots(0U),
+  cb_drain(this, &LogConcentrator::drainRecords),
+  drain(NULL),
+  drain_alarm(NULL),
+  drain_guard("log concentrator drain", false),
+  drain_text(),
   logfile(std::cerr)
 {
   assert(sizeof(LogMessage) == 256);
@@ -118,6 +133,19 @@ void LogConcentrator::initialise(const TimeSpec& ts)
   configure->setTrigger(*r_level);
   configure->switchOn(TimeSpec::start_of_time);
 
+  // deferred logging, format the messages at the period given by ts
+  if (deferred_slots) {
+    drain_alarm = new PeriodicAlarm(ts);
+    drain = new ActivityCallback(id->getId(), "format log messages",
+                                 &cb_drain, PrioritySpec(0,0));
+    drain->setTrigger(*drain_alarm);
+    drain->switchOn(TimeSpec::start_of_time);
+    LogRing::setRingSize(deferred_slots);
+
+    // messages still waiting at the end of the program
+    std::atexit(flushDeferredAtExit);
+  }
+
   // for node 0, check whether there is a file with loglevels defined
   if (id->getId().getLocationId() == 0 && access("dueca-initlog.xml", R_OK) == 0) {
     w_level.reset(new ChannelWriteToken
@@ -127,6 +155,11 @@ void LogConcentrator::initialise(const TimeSpec& ts)
   }
 }
 
+void LogConcentrator::setDeferred(unsigned slots)
+{
+  deferred_slots = slots;
+}
+
 void LogConcentrator::cbLoadInitial(const TimeSpec& ts)
 {
   pugi::xml_document doc;
@@ -195,27 +228,80 @@ uint32_t LogConcentrator::addLogger(Logger* logger)
   return id;
 }
 
-void LogConcentrator::accept(Logger* logger)
+void LogConcentrator::emit(Logger* logger, uint32_t count,
+                           const LogTime& time, const ActivityContext& context,
+                           const char* text, TimeTickType tick)
 {
-  unsigned period = SimTime::getTimeTick() / periodsize;
+  unsigned period = tick / periodsize;
 
   // if the number of stacked messages is not excessive, log this
   // one.
   if (logger->logsInPeriod(period) < max_messages_per_interval) {
     LogMessage* lm = new LogMessage
-      (logger->id(), logger->count(), LogTime::now(),
-       id ? ActivityManager::getActivityContext(): ActivityContext(0xff,0),
-       logger->str().c_str());
+      (logger->id(), count, time, context, text);
     print(logfile, *lm);
 
     // send through the stash
     w_logmessage.stash(lm);
   }
+}
+
+void LogConcentrator::accept(Logger* logger)
+{
+  emit(logger, logger->count(), LogTime::now(),
+       id ? ActivityManager::getActivityContext(): ActivityContext(0xff,0),
+       logger->str().c_str(), SimTime::getTimeTick());
 
   // reset the logged string
   logger->str("");
 }
 
+void LogConcentrator::drainRecords(const TimeSpec& ts)
+{
+  flushDeferred();
+}
+
+void LogConcentrator::flushDeferred()
+{
+  ScopeLock d(drain_guard);
+  LogRing* prev = NULL;
+  for (LogRing* ring = LogRing::first(); ring != NULL; ) {
+    const LogRecord* rec;
+    while ((rec = ring->front()) != NULL) {
+      Logger* logger;
+      {
+        ScopeLock l(*this);
+        logger = loggers[rec->logpoint];
+      }
+      drain_text.str("");
+      drain_text.flags(std::ios_base::skipws | std::ios_base::dec);
+      drain_text.precision(6);
+      drain_text.fill(' ');
+      rec->format(drain_text);
+      ActivityContext context;
+      context.total = rec->context;
+      emit(logger, rec->count, LogTime(rec->seconds, rec->usecs), context,
+           drain_text.str().c_str(), rec->tick);
+      ring->release();
+    }
+
+    uint32_t dropped = ring->takeDropped();
+    if (dropped) {
+      logfile << "Deferred logging, " << dropped
+              << " messages dropped, increase deferred-log-slots" << std::endl;
+    }
+
+    // the rings of threads that exited are removed when empty
+    if (ring->exhausted()) {
+      ring = LogRing::remove(ring, prev);
+    }
+    else {
+      prev = ring;
+      ring = ring->next;
+    }
+  }
+}
+
 const GlobalId& LogConcentrator::getId() const
 {
   static GlobalId no_id;
@@ -75,12 +75,39 @@ class LogConcentrator: private StateGuard
   /** Callback object, to load initial log levels upon token validity */
   Callback<LogConcentrator>           cb_initial;
 
+  /** Number of slots in the per-thread rings for deferred logging, 0
+      when messages are formatted directly */
+  unsigned                            deferred_slots;
+
+  /** Callback function for formatting deferred messages. */
+  Callback<LogConcentrator>           cb_drain;
+
+  /** The activity for formatting deferred messages. */
+  ActivityCallback                    *drain;
+
+  /** Periodic trigger for the drain activity */
+  PeriodicAlarm                       *drain_alarm;
+
+  /** Only one thread at a time may format deferred messages */
+  StateGuard                          drain_guard;
+
+  /** Stream for formatting the deferred messages */
+  std::ostringstream                  drain_text;
+
   /** Stream to print to. */
   std::ostream& logfile;
 
   /** Initial load function */
   void cbLoadInitial(const TimeSpec& ts);
 
+  /** Format and send the messages in the per-thread rings. */
+  void drainRecords(const TimeSpec& ts);
+
+  /** Print and send a log message, if the rate limit allows it. */
+  void emit(Logger* logger, uint32_t count, const LogTime& time,
+            const ActivityContext& context, const char* text,
+            TimeTickType tick);
+
 public:
   /** Constructor. */
   LogConcentrator();
@@ -92,6 +119,19 @@ public:
       Environment object. */
   void initialise(const TimeSpec& ts);
 
+  /** Defer the formatting of log messages to the concentrator's
+      activity, only to be called by the Environment object, before
+      initialise.
+
+      @param slots  Number of messages buffered per thread, 0 for
+                    direct formatting. */
+  void setDeferred(unsigned slots);
+
+  /** Format and send the messages waiting in the per-thread rings
+      for deferred logging. Called periodically, before an error
+      message is formatted, and at exit. */
+  void flushDeferred();
+
   /** Configure the log level. */
   void configureLevel(const TimeSpec& ts);
 
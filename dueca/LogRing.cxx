@@ -0,0 +1,220 @@
+/* ------------------------------------------------------------------   */
+/*      item            : LogRing.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define LogRing_cxx
+#include "LogRing.hxx"
+#include <cstring>
+
+#define DEBPRINTLEVEL -1
+#include <debprint.h>
+
+// WARNING. This code may not use normal notification/logging facilities
+// Since that would lead to recursive loops!
+
+DUECA_NS_START
+
+std::atomic<uint32_t> LogRing::ring_size(0U);
+
+/** List of all rings */
+static std::atomic<LogRing*> all_rings(NULL);
+
+/** Ring of each thread */
+static thread_local LogRing* thread_ring = NULL;
+
+/** Set when the thread's ring has been retired */
+static thread_local bool thread_exited = false;
+
+/** Retires the ring of a thread when the thread exits */
+struct LogRingHolder
+{
+  /** Destructor, at thread exit */
+  ~LogRingHolder()
+  {
+    if (thread_ring) {
+      thread_ring->retire();
+      thread_ring = NULL;
+    }
+    thread_exited = true;
+  }
+};
+
+// read a value from the argument data
+template<typename T>
+static inline T getArg(const char* &p)
+{
+  T res;
+  std::memcpy(&res, p, sizeof(T));
+  p += sizeof(T);
+  return res;
+}
+
+void LogRecord::format(std::ostream& os) const
+{
+  const char* p = args;
+  const char* end = args + sizeof(args);
+  while (p < end) {
+    switch (LogArgType(*p++)) {
+    case LogArgEnd:
+      return;
+    case LogArgBool:
+      os << bool(*p++);
+      break;
+    case LogArgChar:
+      os << *p++;
+      break;
+    case LogArgInt:
+      os << getArg<int64_t>(p);
+      break;
+    case LogArgUInt:
+      os << getArg<uint64_t>(p);
+      break;
+    case LogArgDouble:
+      os << getArg<double>(p);
+      break;
+    case LogArgString: {
+      unsigned len = uint8_t(*p++);
+      os.write(p, len);
+      p += len;
+    }
+      break;
+    case LogArgManip:
+      os << getArg<std::ostream& (*)(std::ostream&)>(p);
+      break;
+    case LogArgBaseManip:
+      os << getArg<std::ios_base& (*)(std::ios_base&)>(p);
+      break;
+    default:
+      os << "<corrupt log record>";
+      return;
+    }
+  }
+}
+
+LogRing::LogRing(uint32_t n, LogRing* next) :
+  nslots(n <= 2U ? 2U : (1U << (32 - __builtin_clz(n - 1U)))),
+  slots(new LogRecord[nslots]),
+  head(0U),
+  tail(0U),
+  dropped(0U),
+  retired(false),
+  next(next)
+{
+  //
+}
+
+LogRing::~LogRing()
+{
+  delete[] slots;
+}
+
+LogRecord* LogRing::claim()
+{
+  const uint32_t h = head.load(std::memory_order_relaxed);
+  if (h - tail.load(std::memory_order_acquire) == nslots) {
+    dropped.fetch_add(1U, std::memory_order_relaxed);
+    return NULL;
+  }
+  return &slots[h & (nslots - 1U)];
+}
+
+void LogRing::commit()
+{
+  head.store(head.load(std::memory_order_relaxed) + 1U,
+             std::memory_order_release);
+}
+
+const LogRecord* LogRing::front()
+{
+  const uint32_t t = tail.load(std::memory_order_relaxed);
+  if (head.load(std::memory_order_acquire) == t) {
+    return NULL;
+  }
+  return &slots[t & (nslots - 1U)];
+}
+
+void LogRing::release()
+{
+  tail.store(tail.load(std::memory_order_relaxed) + 1U,
+             std::memory_order_release);
+}
+
+uint32_t LogRing::takeDropped()
+{
+  return dropped.exchange(0U, std::memory_order_relaxed);
+}
+
+bool LogRing::exhausted()
+{
+  // retired first; no new messages come in after that
+  return retired.load(std::memory_order_acquire) && front() == NULL;
+}
+
+void LogRing::setRingSize(uint32_t size)
+{
+  ring_size.store(size, std::memory_order_relaxed);
+}
+
+LogRing* LogRing::single()
+{
+  if (thread_ring == NULL && !thread_exited) {
+
+    // holder for retiring the ring at thread exit
+    static thread_local LogRingHolder holder;
+
+    // new ring, at the start of the list
+    LogRing* ring = new LogRing(ring_size.load(std::memory_order_relaxed),
+                                all_rings.load(std::memory_order_relaxed));
+    while (!all_rings.compare_exchange_weak(ring->next, ring,
+                                            std::memory_order_release)) {
+      // ring->next updated, retry
+    }
+    DEB("New log ring " << reinterpret_cast<void*>(ring));
+    thread_ring = ring;
+  }
+  return thread_ring;
+}
+
+void LogRing::prepare()
+{
+  if (deferring()) {
+    single();
+  }
+}
+
+LogRing* LogRing::first()
+{
+  return all_rings.load(std::memory_order_acquire);
+}
+
+LogRing* LogRing::remove(LogRing* ring, LogRing* prev)
+{
+  // new rings are only added at the start of the list, so when the
+  // ring is no longer first, find the ring before it
+  LogRing* expected = ring;
+  if (prev == NULL &&
+      !all_rings.compare_exchange_strong(expected, ring->next,
+                                         std::memory_order_acq_rel)) {
+    prev = expected;
+    while (prev->next != ring) {
+      prev = prev->next;
+    }
+  }
+  if (prev != NULL) {
+    prev->next = ring->next;
+  }
+  LogRing* next = ring->next;
+  DEB("Removing log ring " << reinterpret_cast<void*>(ring));
+  delete ring;
+  return next;
+}
+
+DUECA_NS_END
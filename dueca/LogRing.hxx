@@ -0,0 +1,164 @@
+/* ------------------------------------------------------------------   */
+/*      item            : LogRing.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Per-thread buffer for deferred log messages
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <iostream>
+#include <dueca_ns.h>
+
+DUECA_NS_START
+
+/** Type tags for the arguments in a LogRecord. */
+enum LogArgType {
+  LogArgEnd,          /**< No further arguments */
+  LogArgBool,         /**< bool, 1 byte */
+  LogArgChar,         /**< character, 1 byte */
+  LogArgInt,          /**< signed integer, as int64_t */
+  LogArgUInt,         /**< unsigned integer, as uint64_t */
+  LogArgDouble,       /**< floating point, as double */
+  LogArgString,       /**< string, 1 byte length, and the characters */
+  LogArgManip,        /**< stream manipulator, function pointer */
+  LogArgBaseManip     /**< ios_base manipulator, function pointer */
+};
+
+/** Binary form of a single log message, as written by a
+    LogRecorder. The size matches that of a LogMessage. */
+struct LogRecord
+{
+  /** Id of the logger */
+  uint32_t      logpoint;
+
+  /** Count of the message for that logger */
+  uint32_t      count;
+
+  /** Time, seconds */
+  uint32_t      seconds;
+
+  /** Time, microseconds */
+  uint32_t      usecs;
+
+  /** Activity context, in its packed form */
+  uint32_t      context;
+
+  /** Simulation time tick, for limiting the message rate */
+  uint32_t      tick;
+
+  /** Tagged argument values, closed with LogArgEnd */
+  char          args[232];
+
+  /** Format the arguments as text */
+  void format(std::ostream& os) const;
+};
+
+/** Ring buffer for the log messages of a single thread.
+
+    There is one producer, the thread that writes messages, and one
+    consumer, the LogConcentrator. When the ring is full, messages
+    are dropped and counted.
+
+    Rings are created when an ActivityManager thread starts, or
+    otherwise on the first deferred log message in a thread. When the
+    thread exits, its ring is retired; the LogConcentrator formats the
+    remaining messages, and then removes and deletes the ring.
+*/
+class LogRing
+{
+  /** Number of slots, a power of two */
+  const uint32_t      nslots;
+
+  /** Message slots */
+  LogRecord*          slots;
+
+  /** Next slot to write, only modified by the producer */
+  std::atomic<uint32_t> head;
+
+  /** Next slot to read, only modified by the consumer */
+  std::atomic<uint32_t> tail;
+
+  /** Messages dropped because the ring was full */
+  std::atomic<uint32_t> dropped;
+
+  /** The thread of the ring has exited, no more messages */
+  std::atomic<bool>   retired;
+
+  /** Number of slots for new rings, 0 if not deferring */
+  static std::atomic<uint32_t> ring_size;
+
+public:
+  /** Next ring in the list of rings */
+  LogRing*            next;
+
+  /** Constructor
+
+      @param nslots  Number of slots, rounded up to a power of two.
+      @param next    Next ring, for linking.
+  */
+  LogRing(uint32_t nslots, LogRing* next);
+
+  /** Destructor */
+  ~LogRing();
+
+  /** Claim a slot for writing, producer side.
+      @returns   Slot, or NULL if the ring is full. */
+  LogRecord* claim();
+
+  /** Publish the claimed slot. */
+  void commit();
+
+  /** Oldest published slot, consumer side.
+      @returns   Slot, or NULL if the ring is empty. */
+  const LogRecord* front();
+
+  /** Release the slot returned by front(). */
+  void release();
+
+  /** Return and reset the number of dropped messages. */
+  uint32_t takeDropped();
+
+  /** Mark that the producer thread has exited. */
+  inline void retire() { retired.store(true, std::memory_order_release); }
+
+  /** Check whether the ring is retired and empty, and may be removed,
+      consumer side. */
+  bool exhausted();
+
+  /** Switch deferred logging on or off.
+      @param size    Number of slots for each thread's ring, 0 for off. */
+  static void setRingSize(uint32_t size);
+
+  /** Check whether deferred logging is on. */
+  static inline bool deferring()
+  { return ring_size.load(std::memory_order_relaxed) != 0U; }
+
+  /** Ring for the calling thread, created when needed.
+      @returns   The ring, or NULL when the thread is exiting. */
+  static LogRing* single();
+
+  /** Create the ring for the calling thread when deferring, so the
+      first message does not allocate. Call at the start of a
+      thread. */
+  static void prepare();
+
+  /** Start of the list of all rings */
+  static LogRing* first();
+
+  /** Remove a ring from the list, and delete it; consumer side.
+      @param ring    Ring to remove, must be exhausted.
+      @param prev    Ring before it in the list, NULL if it was the
+                     first ring when found.
+      @returns       The ring after the removed one. */
+  static LogRing* remove(LogRing* ring, LogRing* prev);
+};
+
+DUECA_NS_END
@@ -15,8 +15,13 @@
 #define Logger_cxx
 #include "Logger.hxx"
 #include "LogConcentrator.hxx"
+#include "LogRing.hxx"
+#include "ActivityManager.hxx"
+#include "SimTime.hxx"
+#include "ThreadSpecific.hxx"
 #include "InformationStash.ixx"
 #include <LogPoint.hxx>
+#include <cstring>
 #define DEBPRINTLEVEL -1
 #include <debprint.h>
 
@@ -56,6 +61,10 @@ Logger::~Logger()
 
 void Logger::transmit()
 {
+  // deferred messages are complete in the recorder
+  if (LogRecorder::finish(*this)) {
+    return;
+  }
   _count++;
   LogConcentrator::single().accept(this);
 }
@@ -71,6 +80,209 @@ void Logger::showType(std::ostream& os) const
   os << LogLevel_to_letter(this->level) << this->category;
 }
 
+LogRecorder::TextBuffer::TextBuffer(LogRecorder& recorder) :
+  recorder(recorder)
+{
+  //
+}
+
+LogRecorder::TextBuffer::int_type
+LogRecorder::TextBuffer::overflow(int_type c)
+{
+  if (c != traits_type::eof()) {
+    const char ch = traits_type::to_char_type(c);
+    recorder.putString(&ch, 1);
+  }
+  return traits_type::not_eof(c);
+}
+
+std::streamsize LogRecorder::TextBuffer::xsputn(const char* s,
+                                                std::streamsize n)
+{
+  recorder.putString(s, n);
+  return n;
+}
+
+LogRecorder::LogRecorder() :
+  std::ostream(NULL),
+  logger(NULL),
+  ring(NULL),
+  record(NULL),
+  direct(true),
+  pos(NULL),
+  text(*this)
+{
+  //
+}
+
+LogRecorder& LogRecorder::single()
+{
+  // not deleted, like the log rings, recorders are used until the end
+  static ThreadSpecific* _ts = new ThreadSpecific();
+  LogRecorder* recorder = reinterpret_cast<LogRecorder*>(_ts->ptr());
+  if (recorder == NULL) {
+    recorder = new LogRecorder();
+    _ts->setPtr(recorder);
+  }
+  return *recorder;
+}
+
+LogRecorder& LogRecorder::start(Logger& logger)
+{
+  LogRecorder& r = single();
+  r.logger = &logger;
+  r.record = NULL;
+  r.direct = true;
+
+  // each message starts with the default format
+  r.flags(std::ios_base::skipws | std::ios_base::dec);
+  r.precision(6);
+  r.width(0);
+  r.fill(' ');
+
+  r.ring = NULL;
+  if (LogRing::deferring()) {
+
+    // errors are formatted directly, after the waiting messages; a
+    // thread that is exiting no longer has a ring, and also formats
+    // directly
+    if (!(logger.level < LogLevel(LogLevel::Error))) {
+      LogConcentrator::single().flushDeferred();
+    }
+    else {
+      r.ring = LogRing::single();
+    }
+    if (r.ring != NULL) {
+      r.direct = false;
+      r.record = r.ring->claim();
+      if (r.record) {
+        const LogTime now = LogTime::now();
+        r.record->logpoint = logger.id();
+        r.record->count = logger.countDeferred();
+        r.record->seconds = now.seconds;
+        r.record->usecs = now.usecs;
+        r.record->context = ActivityManager::getActivityContext().total;
+        r.record->tick = SimTime::getTimeTick();
+        r.pos = r.record->args;
+        r.rdbuf(&r.text);
+      }
+      else {
+        // ring full, the message is dropped, output fails silently
+        r.rdbuf(NULL);
+      }
+      return r;
+    }
+  }
+
+  r.rdbuf(logger.rdbuf());
+  return r;
+}
+
+bool LogRecorder::finish(Logger& logger)
+{
+  LogRecorder& r = single();
+
+  // not started here, e.g. when the first argument's stream operator
+  // is only known to the caller
+  if (r.logger != &logger) {
+    return false;
+  }
+  r.logger = NULL;
+  if (r.record) {
+    *r.pos = char(LogArgEnd);
+    r.ring->commit();
+    r.record = NULL;
+    r.rdbuf(NULL);
+  }
+  return !r.direct;
+}
+
+void LogRecorder::put(char tag, const void* data, unsigned size)
+{
+  // keep room for the closing tag; drop what does not fit
+  if (pos + size + 2 > record->args + sizeof(record->args)) {
+    return;
+  }
+  *pos++ = tag;
+  std::memcpy(pos, data, size);
+  pos += size;
+}
+
+void LogRecorder::putString(const char* s, size_t len)
+{
+  const size_t room = record->args + sizeof(record->args) - pos;
+  if (room < 3) return;
+  if (len > room - 3) len = room - 3;
+  if (len > 255) len = 255;
+  *pos++ = char(LogArgString);
+  *pos++ = char(len);
+  std::memcpy(pos, s, len);
+  pos += len;
+}
+
+LogRecorder& LogRecorder::operator<< (bool v)
+{
+  if (record) { put(LogArgBool, &v, 1); }
+  else { format(v); }
+  return *this;
+}
+
+LogRecorder& LogRecorder::operator<< (char v)
+{
+  if (record) { put(LogArgChar, &v, 1); }
+  else { format(v); }
+  return *this;
+}
+
+LogRecorder& LogRecorder::addInt(long long v)
+{
+  if (record) { int64_t i(v); put(LogArgInt, &i, sizeof(i)); }
+  else { format(v); }
+  return *this;
+}
+
+LogRecorder& LogRecorder::addUInt(unsigned long long v)
+{
+  if (record) { uint64_t i(v); put(LogArgUInt, &i, sizeof(i)); }
+  else { format(v); }
+  return *this;
+}
+
+LogRecorder& LogRecorder::operator<< (double v)
+{
+  if (record) { put(LogArgDouble, &v, sizeof(v)); }
+  else { format(v); }
+  return *this;
+}
+
+LogRecorder& LogRecorder::operator<< (const char* v)
+{
+  if (record) { putString(v, std::strlen(v)); }
+  else { format(v); }
+  return *this;
+}
+
+LogRecorder& LogRecorder::operator<< (const std::string& v)
+{
+  if (record) { putString(v.c_str(), v.size()); }
+  else { format(v); }
+  return *this;
+}
+
+LogRecorder& LogRecorder::operator<< (std::ostream& (*m)(std::ostream&))
+{
+  if (record) { put(LogArgManip, &m, sizeof(m)); }
+  else { format(m); }
+  return *this;
+}
+
+LogRecorder& LogRecorder::operator<< (std::ios_base& (*m)(std::ios_base&))
+{
+  // also applied here, for the arguments printed as text
+  if (record) { put(LogArgBaseManip, &m, sizeof(m)); }
+  format(m);
+  return *this;
+}
 
 DUECA_NS_END
 
@@ -17,10 +17,14 @@
 #include <LogCategory.hxx>
 #include <LogLevel.hxx>
 #include <sstream>
+#include <type_traits>
+#include <utility>
 #include <dueca_ns.h>
 
 DUECA_NS_START
 
+class LogRecorder;
+
 /** A class for logging messages about the running system. Do not use
     these objects directly, use the D_MSG etc. macros */
 class Logger: public std::stringstream
@@ -86,9 +90,25 @@ public:
   /** Identifying number. */
   inline uint32_t id() { return _id; }
 
+  /** Start a message with its first argument. The message is
+      collected by the LogRecorder of the calling thread. */
+  template<typename T>
+  inline auto operator<< (const T& v) ->
+    decltype(std::declval<LogRecorder&>() << v);
+
+  /** Start a message with a stream manipulator. */
+  inline LogRecorder& operator<< (std::ostream& (*m)(std::ostream&));
+
+  /** Start a message with a stream manipulator. */
+  inline LogRecorder& operator<< (std::ios_base& (*m)(std::ios_base&));
+
   /** Transmit the recorded message. */
   void transmit();
 
+  /** Count a message that is not transmitted directly.
+      @returns   The new count. */
+  inline uint32_t countDeferred() { return ++_count; }
+
   /** Check whether excessive logging in period */
   inline uint32_t logsInPeriod(const uint32_t period)
   { if (period != period_id) { period_id = period; period_count = 0;}
@@ -101,6 +121,176 @@ public:
   void showType(std::ostream& os) const;
 };
 
+struct LogRecord;
+class LogRing;
+
+/** Collects the arguments of a log message. Do not use these objects
+    directly, the D_MSG etc. macros pass their arguments through the
+    Logger to the recorder of the calling thread. The recorder is
+    created once for each thread, and re-used for all messages.
+
+    Normally the message is formatted directly in the Logger's stream,
+    and transmitted by the macro. With deferred logging (the
+    "deferred-log-slots" option of the Environment), the recorder
+    claims a slot in a ring buffer for the calling thread, and copies
+    the arguments in binary form. The LogConcentrator formats the
+    message later, in its own activity, so the logging thread does not
+    format or allocate. Error messages are not deferred; the rings are
+    emptied first, and the error is formatted directly.
+
+    Strings, numbers and stream manipulators are copied as
+    values. Other arguments are printed with their normal stream
+    operator, and copied as text.
+
+    Since each thread has a single recorder, logging from within the
+    stream operator of an object that is itself being logged is not
+    supported; the nested message would take over the recorder of the
+    message being recorded. */
+class LogRecorder: public std::ostream
+{
+  /** Buffer adding printed text to the record */
+  class TextBuffer: public std::streambuf
+  {
+    /** Recorder to add to */
+    LogRecorder& recorder;
+
+  public:
+    /** Constructor */
+    TextBuffer(LogRecorder& recorder);
+
+  protected:
+    /** Add a single character */
+    int_type overflow(int_type c);
+
+    /** Add a series of characters */
+    std::streamsize xsputn(const char* s, std::streamsize n);
+  };
+
+  /** Logger for the current message, NULL when not recording */
+  Logger* logger;
+
+  /** Ring with the record */
+  LogRing* ring;
+
+  /** Record being filled, NULL when formatting directly */
+  LogRecord* record;
+
+  /** Format directly; false when the record is dropped */
+  bool direct;
+
+  /** Write position in the record */
+  char* pos;
+
+  /** Text buffer, for arguments printed as text */
+  TextBuffer text;
+
+  /** Constructor */
+  LogRecorder();
+
+  /** Recorder of the calling thread */
+  static LogRecorder& single();
+
+  /** Add a tagged value to the record */
+  void put(char tag, const void* data, unsigned size);
+
+  /** Add a string to the record */
+  void putString(const char* s, size_t len);
+
+  /** Add a signed integer */
+  LogRecorder& addInt(long long v);
+
+  /** Add an unsigned integer */
+  LogRecorder& addUInt(unsigned long long v);
+
+  /** Pass an argument to the stream, when not recording binary */
+  template<typename T>
+  inline void format(const T& v)
+  { static_cast<std::ostream&>(*this) << v; }
+
+public:
+  /** Start a new message for a logger, on the calling thread's
+      recorder. */
+  static LogRecorder& start(Logger& logger);
+
+  /** Complete the message for a logger.
+
+      @returns  true if the message has been recorded, or dropped;
+                false if it is formatted in the logger, and should be
+                transmitted. */
+  static bool finish(Logger& logger);
+
+  /** Add an argument */
+  LogRecorder& operator<< (bool v);
+
+  /** Add an argument */
+  LogRecorder& operator<< (char v);
+
+  /** Add an argument */
+  inline LogRecorder& operator<< (signed char v)
+  { return *this << char(v); }
+
+  /** Add an argument */
+  inline LogRecorder& operator<< (unsigned char v)
+  { return *this << char(v); }
+
+  /** Add an integer argument */
+  template<typename T>
+  inline typename std::enable_if<std::is_integral<T>::value,
+                                 LogRecorder&>::type
+  operator<< (T v)
+  {
+    if (std::is_signed<T>::value) { return addInt((long long)(v)); }
+    return addUInt((unsigned long long)(v));
+  }
+
+  /** Add an argument */
+  LogRecorder& operator<< (double v);
+
+  /** Add an argument */
+  inline LogRecorder& operator<< (float v)
+  { return *this << double(v); }
+
+  /** Add an argument, printed as text */
+  inline LogRecorder& operator<< (long double v)
+  { format(v); return *this; }
+
+  /** Add an argument */
+  LogRecorder& operator<< (const char* v);
+
+  /** Add an argument */
+  LogRecorder& operator<< (const std::string& v);
+
+  /** Add a null pointer */
+  inline LogRecorder& operator<< (std::nullptr_t)
+  { return *this << "nullptr"; }
+
+  /** Add any other argument, printed with its stream operator */
+  template<typename T>
+  inline typename std::enable_if
+  <!std::is_arithmetic<T>::value,
+   decltype(std::declval<std::ostream&>() << std::declval<const T&>(),
+            std::declval<LogRecorder&>())>::type
+  operator<< (const T& v)
+  { format(v); return *this; }
+
+  /** Add a stream manipulator, such as std::endl */
+  LogRecorder& operator<< (std::ostream& (*m)(std::ostream&));
+
+  /** Add a stream manipulator, such as std::hex */
+  LogRecorder& operator<< (std::ios_base& (*m)(std::ios_base&));
+};
+
+template<typename T>
+inline auto Logger::operator<< (const T& v) ->
+  decltype(std::declval<LogRecorder&>() << v)
+{ return LogRecorder::start(*this) << v; }
+
+inline LogRecorder& Logger::operator<< (std::ostream& (*m)(std::ostream&))
+{ return LogRecorder::start(*this) << m; }
+
+inline LogRecorder& Logger::operator<< (std::ios_base& (*m)(std::ios_base&))
+{ return LogRecorder::start(*this) << m; }
+
 DUECA_NS_END
 
 #endif
@@ -0,0 +1,264 @@
+/* ------------------------------------------------------------------   */
+/*      item            : ShmChannelRing.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define ShmChannelRing_cxx
+#include "ShmChannelRing.hxx"
+#include "NameSet.hxx"
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#define DEBPRINTLEVEL -1
+#include "debug.h"
+#include <debprint.h>
+
+DUECA_NS_START
+
+/** Format marker, indicates a completely initialised ring */
+static const uint32_t ring_format = 0x53484d31U;
+
+/** Offset of the data in a slot, keeps the data aligned */
+static const uint32_t data_offset = 16U;
+
+struct ShmChannelRing::Header
+{
+  /** Format marker, written last */
+  std::atomic<uint32_t> format;
+
+  /** Magic number of the data class */
+  uint32_t            datamagic;
+
+  /** Size of the data objects */
+  uint32_t            objsize;
+
+  /** Number of slots */
+  uint32_t            nslots;
+
+  /** Distance between slots */
+  uint32_t            stride;
+
+  /** Sequence number of the first data in the ring */
+  std::atomic<uint32_t> first;
+
+  /** Sequence number of the latest data */
+  std::atomic<uint32_t> latest;
+};
+
+struct ShmChannelRing::SlotHead
+{
+  /** Sequence lock, odd while the slot is being written */
+  std::atomic<uint32_t> lock;
+
+  /** Sequence number of the data in the slot */
+  std::atomic<uint32_t> seqid;
+};
+
+ShmChannelRing::ShmChannelRing(const std::string& name, bool owner) :
+  name(name),
+  owner(owner),
+  mapsize(0),
+  base(NULL),
+  filled(false),
+  objsize(0U),
+  nslots(0U),
+  stride(0U)
+{
+  //
+}
+
+ShmChannelRing::~ShmChannelRing()
+{
+  if (base) {
+    munmap(base, mapsize);
+  }
+  if (owner) {
+    shm_unlink(name.c_str());
+  }
+}
+
+ShmChannelRing* ShmChannelRing::create(const std::string& name,
+                                       uint32_t datamagic,
+                                       uint32_t objsize, uint32_t nslots)
+{
+  // never take over an existing ring, that might be in use by readers
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd == -1) {
+    /* DUECA channel.
+
+       Cannot create a shared memory object for transporting channel
+       data to other processes on this host, or an object with the
+       same name already exists, possibly left over by an earlier
+       process with the same process id. The data will be
+       transported by packing instead. */
+    W_CHN("Cannot create shared memory " << name << ", " << strerror(errno));
+    return NULL;
+  }
+
+  ShmChannelRing* ring = new ShmChannelRing(name, true);
+  ring->objsize = objsize;
+  ring->nslots = nslots;
+  ring->stride = (data_offset + objsize + 63U) & ~63U;
+  if (ring->stride < sizeof(Header)) ring->stride = 64U;
+  ring->mapsize = size_t(ring->stride) * (nslots + 1U);
+
+  void* mem = MAP_FAILED;
+  if (ftruncate(fd, ring->mapsize) == 0) {
+    mem = mmap(NULL, ring->mapsize, PROT_READ | PROT_WRITE, MAP_SHARED,
+               fd, 0);
+  }
+  close(fd);
+  if (mem == MAP_FAILED) {
+    /* DUECA channel.
+
+       Cannot size or map a shared memory object for transporting
+       channel data. The data will be transported by packing
+       instead. */
+    W_CHN("Cannot map shared memory " << name << ", " << strerror(errno));
+    delete ring;
+    return NULL;
+  }
+  ring->base = reinterpret_cast<char*>(mem);
+
+  // the memory is zeroed, fill the description
+  Header* h = reinterpret_cast<Header*>(ring->base);
+  h->datamagic = datamagic;
+  h->objsize = objsize;
+  h->nslots = nslots;
+  h->stride = ring->stride;
+  h->format.store(ring_format, std::memory_order_release);
+  DEB("Created shared memory ring " << name << " slots=" << nslots);
+  return ring;
+}
+
+ShmChannelRing* ShmChannelRing::attach(const std::string& name,
+                                       uint32_t datamagic, uint32_t objsize)
+{
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd == -1) {
+    /* DUECA channel.
+
+       Cannot open the shared memory with data from a channel
+       entry. Shared memory transport is only possible when all
+       DUECA processes run on the same host. */
+    E_CHN("Cannot open shared memory " << name << ", " << strerror(errno));
+    return NULL;
+  }
+
+  ShmChannelRing* ring = new ShmChannelRing(name, false);
+  struct stat st;
+  void* mem = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(Header)) {
+    ring->mapsize = st.st_size;
+    mem = mmap(NULL, ring->mapsize, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (mem == MAP_FAILED) {
+    /* DUECA channel.
+
+       Cannot map the shared memory with data from a channel entry. */
+    E_CHN("Cannot map shared memory " << name << ", " << strerror(errno));
+    delete ring;
+    return NULL;
+  }
+  ring->base = reinterpret_cast<char*>(mem);
+
+  const Header* h = reinterpret_cast<const Header*>(ring->base);
+  if (h->format.load(std::memory_order_acquire) != ring_format ||
+      h->datamagic != datamagic || h->objsize != objsize ||
+      size_t(h->stride) * (h->nslots + 1U) > ring->mapsize) {
+    /* DUECA channel.
+
+       The shared memory for a channel entry does not match the data
+       class used here. Check that all DUECA processes use the same
+       version of the DCO objects. */
+    E_CHN("Shared memory " << name << " does not match the data class");
+    delete ring;
+    return NULL;
+  }
+  ring->objsize = objsize;
+  ring->nslots = h->nslots;
+  ring->stride = h->stride;
+  DEB("Attached shared memory ring " << name << " slots=" << ring->nslots);
+  return ring;
+}
+
+std::string ShmChannelRing::ringName(const NameSet& channel, unsigned entry,
+                                     uint32_t key)
+{
+  // FNV-1a hash of the channel name, keeps the name short and free
+  // of slashes
+  uint32_t hash = 2166136261U;
+  for (const char c: channel.name) {
+    hash = (hash ^ uint8_t(c)) * 16777619U;
+  }
+  std::stringstream n;
+  n << "/dueca-" << getuid() << '-' << key << '-' << std::hex << hash
+    << std::dec << '-' << entry;
+  return n.str();
+}
+
+uint32_t ShmChannelRing::sessionKey()
+{
+  return uint32_t(getpid());
+}
+
+void ShmChannelRing::publish(uint32_t seqid, const void* data)
+{
+  SlotHead* s = slot(seqid);
+  const uint32_t l = s->lock.load(std::memory_order_relaxed);
+  s->lock.store(l + 1U, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(reinterpret_cast<char*>(s) + data_offset, data, objsize);
+  s->seqid.store(seqid, std::memory_order_relaxed);
+  s->lock.store(l + 2U, std::memory_order_release);
+  Header* h = reinterpret_cast<Header*>(base);
+  if (!filled.load(std::memory_order_relaxed)) {
+    h->first.store(seqid, std::memory_order_relaxed);
+    h->latest.store(seqid, std::memory_order_relaxed);
+
+    // first and latest are visible to holds() once filled is
+    filled.store(true, std::memory_order_release);
+    return;
+  }
+  h->latest.store(seqid, std::memory_order_release);
+}
+
+bool ShmChannelRing::holds(uint32_t seqid) const
+{
+  // within the last nslots, and not from before the ring was created
+  if (!filled.load(std::memory_order_acquire)) return false;
+  const Header* h = reinterpret_cast<const Header*>(base);
+  const uint32_t latest = h->latest.load(std::memory_order_acquire);
+  const uint32_t first = h->first.load(std::memory_order_relaxed);
+  return latest - seqid < nslots && seqid - first <= latest - first;
+}
+
+bool ShmChannelRing::read(uint32_t seqid, void* data) const
+{
+  // the data has been completely written before the notification was
+  // sent; a slot never written, being written, or modified while
+  // copying, means the data is not there or being overwritten
+  const SlotHead* s = slot(seqid);
+  const uint32_t l = s->lock.load(std::memory_order_acquire);
+  if (l == 0U || (l & 1U)) return false;
+  std::memcpy(data, reinterpret_cast<const char*>(s) + data_offset, objsize);
+  const uint32_t sid = s->seqid.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return s->lock.load(std::memory_order_relaxed) == l && sid == seqid;
+}
+
+DUECA_NS_END
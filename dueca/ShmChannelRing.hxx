@@ -0,0 +1,139 @@
+/* ------------------------------------------------------------------   */
+/*      item            : ShmChannelRing.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Shared memory ring for channel entry data
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <atomic>
+#include <dueca_ns.h>
+
+DUECA_NS_START
+
+struct NameSet;
+
+/** Ring of data slots in POSIX shared memory, for transport of the
+    data of a single channel entry to other DUECA processes on the
+    same host.
+
+    The writing end creates the ring, and copies each new data object
+    into a slot, as raw memory. Each slot is protected by a sequence
+    lock; a reading end copies the data optimistically, and checks
+    afterwards that the slot was not modified while copying. The
+    transport of the channel still carries a small notification with
+    the sequence number and time of the data, but not the data
+    itself.
+
+    This is only possible for data classes for which the
+    dco_rawcopy trait is true; objects of fixed size, without
+    pointers.
+
+    The ring name contains a key of the writing process, which is
+    sent with the notifications, so rings of different DUECA
+    sessions on one host do not clash. A ring is only created when
+    no shared memory object with that name exists; the writing end
+    otherwise packs its data normally.
+*/
+class ShmChannelRing
+{
+  /** Ring description, at the start of the shared memory */
+  struct Header;
+
+  /** Administration for each slot */
+  struct SlotHead;
+
+  /** Name of the shared memory object */
+  std::string         name;
+
+  /** Writing end, creates and removes the shared memory */
+  bool                owner;
+
+  /** Size of the mapping */
+  size_t              mapsize;
+
+  /** Start of the mapping */
+  char*               base;
+
+  /** Writing end, data has been published. Set by the writing
+      thread, checked by the packer in holds() */
+  std::atomic<bool>   filled;
+
+  /** Size of the data objects */
+  uint32_t            objsize;
+
+  /** Number of slots */
+  uint32_t            nslots;
+
+  /** Distance between slots, in bytes */
+  uint32_t            stride;
+
+  /** Constructor, use create or attach */
+  ShmChannelRing(const std::string& name, bool owner);
+
+  /** Slot administration for a sequence number */
+  inline SlotHead* slot(uint32_t seqid) const
+  { return reinterpret_cast<SlotHead*>
+      (base + stride * (1U + seqid % nslots)); }
+
+public:
+  /** Destructor. Unmaps, and for the writing end, removes the
+      shared memory object. */
+  ~ShmChannelRing();
+
+  /** Create a ring, writing end. Fails when a shared memory object
+      with the same name already exists.
+      \param name      Name of the shared memory object.
+      \param datamagic Magic number of the data class.
+      \param objsize   Size of the data objects.
+      \param nslots    Number of slots.
+      \returns         The new ring, or NULL on failure. */
+  static ShmChannelRing* create(const std::string& name, uint32_t datamagic,
+                                uint32_t objsize, uint32_t nslots);
+
+  /** Attach to an existing ring, reading end.
+      \param name      Name of the shared memory object.
+      \param datamagic Magic number of the data class, must match.
+      \param objsize   Size of the data objects, must match.
+      \returns         The ring, or NULL on failure. */
+  static ShmChannelRing* attach(const std::string& name, uint32_t datamagic,
+                                uint32_t objsize);
+
+  /** Name for the ring of a channel entry.
+      \param channel   Name of the channel.
+      \param entry     Entry number.
+      \param key       Key of the writing process, see sessionKey. */
+  static std::string ringName(const NameSet& channel, unsigned entry,
+                              uint32_t key);
+
+  /** Key for the rings created by this process, unique on the host
+      while the process runs. */
+  static uint32_t sessionKey();
+
+  /** Copy new data into the ring, writing end.
+      \param seqid     Sequence number of the data in the entry.
+      \param data      Data object, objsize bytes. */
+  void publish(uint32_t seqid, const void* data);
+
+  /** Check that data with the given sequence number is in the ring,
+      writing end. Data from before the first publish, or overwritten
+      by newer data, is not. */
+  bool holds(uint32_t seqid) const;
+
+  /** Copy data from the ring, reading end.
+      \param seqid     Sequence number of the data.
+      \param data      Destination, objsize bytes.
+      \returns         false if the data has already been overwritten. */
+  bool read(uint32_t seqid, void* data) const;
+};
+
+DUECA_NS_END
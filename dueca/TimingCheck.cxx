@@ -18,6 +18,7 @@
 
 #include "TimingCheck.hxx"
 #include <TimingResults.hxx>
+#include <TimingHistogram.hxx>
 #include <Activity.hxx>
 #include <TimeSpec.hxx>
 #include <NameSet.hxx>
@@ -48,6 +49,16 @@ static InformationStash<TimingResults>& timing_stash()
   return the_stash;
 }
 
+static InformationStash<TimingHistogram>& histogram_stash()
+{
+  static InformationStash<TimingHistogram> the_stash("TimingHistogram");
+  volatile static bool initialise = true;
+  if (initialise) {
+    initialise = false;
+    the_stash.initialise(0);
+  }
+  return the_stash;
+}
 
 TimingCheck::TimingCheck(Activity& act,
                          int warning_limit, int critical_limit,
@@ -69,12 +80,16 @@ TimingCheck::TimingCheck(Activity& act,
 # error "No suitable random function available"
 #endif
   cumul_start(0),
-  cumul_complete(0)
+  cumul_complete(0),
+  histogram(new TimingHistogram()),
+  last_start(0)
 {
   if (counter <= 0) {
     DEB("counter was " << counter);
     counter=1;
   }
+  histogram->owner_id = my_activity.getOwner();
+  histogram->activity_no = my_activity.getDescriptionId();
 
   if (nloops_in > -nloops) {
     /* DUECA UI.
@@ -90,6 +105,7 @@ TimingCheck::TimingCheck(Activity& act,
 TimingCheck::~TimingCheck()
 {
   my_activity.unsetCheck();
+  delete histogram;
   //delete timing_channel;
 }
 
@@ -101,6 +117,7 @@ void TimingCheck::before(const TimeSpec& ts)
   if (delay < result->min_start) result->min_start = delay;
   if (delay > result->max_start) result->max_start = delay;
   cumul_start += delay;
+  last_start = delay;
 }
 
 void TimingCheck::after(const TimeSpec& ts)
@@ -111,6 +128,7 @@ void TimingCheck::after(const TimeSpec& ts)
   if (delay < result->min_complete) result->min_complete = delay;
   if (delay > result->max_complete) result->max_complete = delay;
   cumul_complete += delay;
+  histogram->record(last_start, delay - last_start);
   if (delay > critical_limit) {
     result->n_critical++;
   }
@@ -127,6 +145,7 @@ void TimingCheck::after(const TimeSpec& ts)
 
       // send off the results
       timing_stash().stash(result);
+      histogram_stash().stash(new TimingHistogram(*histogram));
     }
     else {
 
@@ -146,6 +165,7 @@ void TimingCheck::after(const TimeSpec& ts)
     counter = nloops;
     cumul_start = 0;
     cumul_complete = 0;
+    histogram->reset();
   }
 }
 
@@ -21,6 +21,7 @@
 #include "GlobalId.hxx"
 #include "dueca_ns.h"
 #include "TimingResults.hxx"
+#include "TimingHistogram.hxx"
 
 DUECA_NS_START
 
@@ -35,6 +36,13 @@ class TimeSpec;
     number of delays beyond a warning limit and beyond a critical
     limit.
 
+    In addition, a histogram of the start latency and the run
+    duration of the activity is kept, in log-linear buckets of fixed
+    size. At the end of each reporting period, the histogram is sent
+    as a TimingHistogram event, on a channel named "TimingHistogram".
+    Histograms from different periods and nodes can be merged, and
+    give the percentiles (p50, p99, p99.9) of the timing.
+
     A TimingCheck can be added to an Activity by creating one
     with the activity as an argument. Results from the check are
     assembled and sent over a channel, and made accessible by the
@@ -103,6 +111,12 @@ class TimingCheck
   /** A helper, counts complete times. */
   int64_t cumul_complete;
 
+  /** Histogram of the start latency and run duration. */
+  TimingHistogram* histogram;
+
+  /** Start latency of the current invocation. */
+  int last_start;
+
 public:
   /** Constructor. A timingcheck can monitor a single activity's
       timing delays. It is constructed with a reference to the
@@ -0,0 +1,86 @@
+/* ------------------------------------------------------------------   */
+/*      item            : TimingHistogramExtra.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     : additional methods TimingHistogram dco
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+DUECA_NS_END
+#include <cmath>
+#include <algorithm>
+DUECA_NS_START
+
+// code originally written for this codegen version
+#define __CUSTOM_COMPATLEVEL_111
+
+int32_t TimingHistogram::bucketHigh(unsigned idx)
+{
+  const unsigned shift = idx < (1U << sub_bits) ? 0U : (idx >> sub_bits) - 1U;
+  const uint32_t base = idx - (shift << sub_bits);
+  return int32_t(((base + 1U) << shift) - 1U);
+}
+
+void TimingHistogram::merge(const TimingHistogram& o)
+{
+  for (unsigned ii = n_buckets; ii--; ) {
+    start_counts[ii] += o.start_counts[ii];
+    run_counts[ii] += o.run_counts[ii];
+  }
+  if (o.max_start > max_start) max_start = o.max_start;
+  if (o.max_run > max_run) max_run = o.max_run;
+  n_samples += o.n_samples;
+}
+
+void TimingHistogram::reset()
+{
+  for (unsigned ii = n_buckets; ii--; ) {
+    start_counts[ii] = 0U;
+    run_counts[ii] = 0U;
+  }
+  max_start = 0;
+  max_run = 0;
+  n_samples = 0U;
+}
+
+// upper bound of the bucket that contains fraction p of the samples
+static int32_t histogramPercentile(const fixvector<352,uint32_t>& counts,
+                                   uint32_t n, int32_t vmax, double p)
+{
+  if (n == 0U) return 0;
+  const uint64_t target = uint64_t(std::ceil(p * n));
+  uint64_t cumul = 0U;
+  for (unsigned ii = 0; ii < TimingHistogram::n_buckets; ii++) {
+    cumul += counts[ii];
+    if (cumul >= target) {
+      return std::min(TimingHistogram::bucketHigh(ii), vmax);
+    }
+  }
+  return vmax;
+}
+
+int32_t TimingHistogram::startPercentile(double p) const
+{
+  return histogramPercentile(start_counts, n_samples, max_start, p);
+}
+
+int32_t TimingHistogram::runPercentile(double p) const
+{
+  return histogramPercentile(run_counts, n_samples, max_run, p);
+}
+
+void TimingHistogram::printSummary(std::ostream& os) const
+{
+  os << "n=" << n_samples
+     << " start p50=" << startPercentile(0.5)
+     << " p99=" << startPercentile(0.99)
+     << " p99.9=" << startPercentile(0.999)
+     << " max=" << max_start
+     << " run p50=" << runPercentile(0.5)
+     << " p99=" << runPercentile(0.99)
+     << " p99.9=" << runPercentile(0.999)
+     << " max=" << max_run;
+}
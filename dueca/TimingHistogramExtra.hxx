@@ -0,0 +1,70 @@
+/* ------------------------------------------------------------------   */
+/*      item            : TimingHistogramExtra.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : additional methods TimingHistogram .dco
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+  /** Number of buckets per power of two, as a power of two. Bucket
+      width is at most 1/16 of the bucket's values. */
+  static const unsigned sub_bits = 4;
+
+  /** Number of buckets, covering 0 to 2^25 microseconds. */
+  static const unsigned n_buckets = 352;
+
+  /** Bucket index for a time.
+      \param usecs   Time in microseconds. Negative times go in the
+                     first bucket, times beyond the range in the last.
+      \returns       Bucket index. */
+  static inline unsigned bucketIndex(int32_t usecs)
+  {
+    if (usecs < (1 << sub_bits)) return usecs < 0 ? 0U : unsigned(usecs);
+    const unsigned shift =
+      (31 - __builtin_clz(uint32_t(usecs))) - sub_bits;
+    const unsigned idx = (shift << sub_bits) + (uint32_t(usecs) >> shift);
+    return idx < n_buckets ? idx : n_buckets - 1U;
+  }
+
+  /** Highest time in a bucket.
+      \param idx     Bucket index.
+      \returns       Time in microseconds. */
+  static int32_t bucketHigh(unsigned idx);
+
+  /** Add a single invocation.
+      \param start   Start latency, microseconds.
+      \param run     Run duration, microseconds. */
+  inline void record(int32_t start, int32_t run)
+  {
+    start_counts[bucketIndex(start)]++;
+    run_counts[bucketIndex(run)]++;
+    if (start > max_start) max_start = start;
+    if (run > max_run) max_run = run;
+    n_samples++;
+  }
+
+  /** Add the counts of another histogram, e.g., from another
+      reporting period, or from the same activity on another node. */
+  void merge(const TimingHistogram& o);
+
+  /** Clear all counts. */
+  void reset();
+
+  /** Start latency percentile.
+      \param p       Fraction, e.g. 0.99 for p99.
+      \returns       Upper bound of the bucket with the percentile,
+                     limited to the maximum. */
+  int32_t startPercentile(double p) const;
+
+  /** Run duration percentile.
+      \param p       Fraction, e.g. 0.99 for p99.
+      \returns       Upper bound of the bucket with the percentile,
+                     limited to the maximum. */
+  int32_t runPercentile(double p) const;
+
+  /** Print a summary, with p50, p99, p99.9 and maximum. */
+  void printSummary(std::ostream& os) const;
@@ -19,6 +19,8 @@
 #include "GlobalId.hxx"
 #include "Ticker.hxx"
 #include "Trigger.hxx"
+#include "DataClassRegistry.hxx"
+#include "DataSetConverter.hxx"
 
 DUECA_NS_START;
 
@@ -36,6 +38,7 @@ UCClientHandle::UCClientHandle(ChannelReadToken* token,
   config_change(NULL),
   access_count(1),
   dataclassname(dataclassname),
+  dataclassid(DataClassRegistry::single().getClassId(dataclassname)),
   class_lead(NULL),
   entry(NULL),
   callback(callback),
@@ -103,11 +106,18 @@ UCEntryClientLink::UCEntryClientLink(UChannelEntryPtr entry,
   client_id(client_id),
   sequential_read(sequential_read),
   read_index(sequential_read ? entry->latchSequentialRead() : NULL),
-  seq_id(0)
+  seq_id(0),
+  latest_copy(NULL),
+  copy_converter(NULL)
 {
   //
 }
 
+UCEntryClientLink::~UCEntryClientLink()
+{
+  if (latest_copy) copy_converter->delData(latest_copy);
+}
+
 bool UCEntryClientLink::isMatch(const UCEntryClientLinkPtr other) const
 {
   return entry_creation_id == other->entry_creation_id;
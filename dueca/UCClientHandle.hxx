@@ -20,6 +20,7 @@
 #include "TimeSpec.hxx"
 #include <cmath>
 #include "ChannelDef.hxx"
+#include "DataClassRegistryPredef.hxx"
 #include "DAtomics.hxx"
 #include "GlobalId.hxx"
 
@@ -92,11 +93,21 @@ struct UCEntryClientLink
   /** Remeber the index counter of the last read data point */
   uchan_seq_id_t       seq_id;
 
+  /** Private copy of the entry's latest data, when reading from the
+      entry's latest-value slot; created at first use. */
+  void*                latest_copy;
+
+  /** Converter for the latest_copy object */
+  const DataSetConverter* copy_converter;
+
   /** Constructor */
   UCEntryClientLink(UChannelEntryPtr entry, uint32_t client_id,
                     bool sequential_read,
                     UCEntryClientLinkPtr next);
 
+  /** Destructor */
+  ~UCEntryClientLink();
+
   /** Test for equivalence of the entry */
   bool isMatch(const UCEntryClientLinkPtr other) const;
 
@@ -131,6 +142,9 @@ struct UCClientHandle
   /** Name of the type being accessed by the client. */
   std::string dataclassname;
 
+  /** Registry id of the type being accessed by the client. */
+  DataClassRegistry_id_type dataclassid;
+
   /** Pointer to the lead (first) entry of the specified type, NULL
       if not valid. */
   UCEntryClientLinkPtr class_lead;
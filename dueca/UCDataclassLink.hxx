@@ -16,6 +16,7 @@
 
 #include "dueca_ns.h"
 #include "UCClientHandle.hxx"
+#include "DataClassRegistryPredef.hxx"
 #include <map>
 
 DUECA_NS_START
@@ -33,8 +34,9 @@ struct UCDataclassLink
     UCDataclassLink() : entries(NULL), clients(NULL) {}
 };
 
-/** define a shortcut to the entry map type */
-typedef std::map<std::string,UCDataclassLink> dataclassmap_type;
+/** define a shortcut to the entry map type, keyed with the class id
+    from the DataClassRegistry */
+typedef std::map<DataClassRegistry_id_type,UCDataclassLink> dataclassmap_type;
 typedef UCDataclassLink* UCDataclassLinkPtr;
 
 DUECA_NS_END
@@ -25,6 +25,8 @@
 #include "UnifiedChannel.hxx"
 #include "UChannelCommRequest.hxx"
 #include "GenericCallback.hxx"
+#include "ShmChannelRing.hxx"
+#include "LatestValueSlot.hxx"
 #include <DataClassRegistry.hxx>
 #include <EntryCountResult.hxx>
 #include <ChannelReadToken.hxx>
@@ -33,6 +35,10 @@
 
 DUECA_NS_START
 
+unsigned UChannelEntry::full_pack_interval = 0U;
+unsigned UChannelEntry::shm_slots = 0U;
+bool UChannelEntry::latest_copy = false;
+
 /** Constructor for a non-local entry */
 UChannelEntry::UChannelEntry(UnifiedChannel* channel,
                              uint32_t creationid,
@@ -48,20 +54,29 @@ UChannelEntry::UChannelEntry(UnifiedChannel* channel,
   channel(channel),
   converter(DataClassRegistry::single().getConverter(dataclassname)),
   dataclassname(dataclassname),
+  dataclassid(DataClassRegistry::single().getClassId(dataclassname)),
   creation_id(creationid),
   entry_id(entry_id),
   span(20),
   depth(1),
   send_full(true),
+  full_requested(false),
   cleanup(new UChannelEntryData(0, NULL, NULL, 0)),
   oldest(new UChannelEntryData(0, cleanup)),
   latest(oldest),
   monitored(NULL),
+  ring_size(0),
+  spare_entries(),
+  spare_data(),
   valid(false),
   eventtype(eventtype),
   exclusive(exclusive),
   saveup(nreservations > 0 ? SaveUp : NoSaveUp),
   fullpackmode(fullpackmode),
+  shm_ring(NULL),
+  shm_checked(false),
+  latest_slot(latest_copy && !eventtype && converter->rawCopyable() ?
+              new LatestValueSlot(converter->size()) : NULL),
   origin(origin),
   entrylabel(entrylabel),
   dataclasslink(),
@@ -89,6 +104,10 @@ UChannelEntry::~UChannelEntry()
   cerr << "UChannelEntry deletion "
        << reinterpret_cast<void*>(writer) << endl;
 #endif
+  for (auto ed: spare_entries) { delete ed; }
+  for (auto d: spare_data) { converter->delData(d); }
+  delete shm_ring;
+  delete latest_slot;
   delete writer;
 }
 
@@ -245,10 +264,77 @@ bool UChannelEntry::cleanAllData()
   return (cleanup == NULL);
 }
 
+void UChannelEntry::adjustRing()
+{
+  // depth + 1 points are normally kept, one more is needed for the
+  // new sentinel before cleaning catches up
+  ring_size = depth + 2;
+  spare_entries.reserve(ring_size);
+  while (spare_entries.size() < ring_size) {
+    spare_entries.push_back(new UChannelEntryData(0, NULL, NULL, 0));
+  }
+
+  // data objects are only re-used when written locally
+  if (writer) {
+    spare_data.reserve(ring_size);
+  }
+  DEB(channel->getNameSet() << " entry #" << entry_id <<
+      " recycling ring size " << ring_size);
+}
+
+UChannelEntryData* UChannelEntry::newEntryData(const TimeTickType& ts,
+                                               UChannelEntryData* current)
+{
+  if (spare_entries.empty()) {
+    return new UChannelEntryData(ts, current);
+  }
+  UChannelEntryData* ed = spare_entries.back();
+  spare_entries.pop_back();
+  return ed->reUse(ts, current);
+}
+
+UChannelEntryData* UChannelEntry::newEntryData(const TimeTickType& ts,
+                                               const void* data,
+                                               UChannelEntryData* current,
+                                               uchan_seq_id_t seq_id)
+{
+  if (spare_entries.empty()) {
+    return new UChannelEntryData(ts, data, current, seq_id);
+  }
+  UChannelEntryData* ed = spare_entries.back();
+  spare_entries.pop_back();
+  return ed->reUse(ts, data, current, seq_id);
+}
+
+void UChannelEntry::recycleEntryData(UChannelEntryData* ed)
+{
+  // the data is no longer accessed; keep it for getDataSpace or
+  // unPackShmData when there is room in the ring
+  if ((writer || shm_ring) && ed->stealData() &&
+      spare_data.size() < ring_size) {
+    spare_data.push_back(const_cast<void*>(ed->stealData()));
+  }
+  else {
+    converter->delData(ed->stealData());
+  }
+
+  if (spare_entries.size() < ring_size) {
+    spare_entries.push_back(ed);
+  }
+  else {
+    delete ed;
+  }
+}
+
 void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
 {
   uchan_seq_id_t latest_seqid = latest->seqId();
 
+  // stream entries recycle their data points, follow depth changes
+  if (!eventtype && ring_size != depth + 2) {
+    adjustRing();
+  }
+
   DEB("write in " << (channel ? channel->getNameSet() : NameSet("")) <<
       " entry #" << entry_id << " t=" << t_write << " seq#" << latest_seqid);
 
@@ -257,10 +343,9 @@ void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
   // delete entries that can be recycled. Were indicated in a
   // previous write, and no access requested in the meantime
   while (cleanup->getNext() != oldest && cleanup->tryRecycle()) {
-    converter->delData(cleanup->stealData());
     UChannelEntryData* to_delete = cleanup;
     cleanup = cleanup->getNext();
-    delete to_delete;
+    recycleEntryData(to_delete);
     assert(cleanup != NULL);
   }
 
@@ -309,7 +394,7 @@ void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
     }
 
     // create a new "sentinel" type data point.
-    latest = new UChannelEntryData(0, latest);
+    latest = newEntryData(0, latest);
   }
   else {
 
@@ -333,7 +418,7 @@ void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
       }
 
       // make a new sentinel
-      latest = new UChannelEntryData(t_write.getValidityEnd(), latest);
+      latest = newEntryData(t_write.getValidityEnd(), latest);
     }
 
     // There is a timing gap (data not been written). need a special
@@ -348,7 +433,7 @@ void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
           t_write.getValidityStart());
 
       // now insert data here
-      UChannelEntryData* ewithdata = new UChannelEntryData
+      UChannelEntryData* ewithdata = newEntryData
         (t_write.getValidityStart(), data, latest, latest_seqid);
 
       // before adding data, refresh config if needed
@@ -357,7 +442,7 @@ void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
       }
 
       // and write a new sentinel
-      latest = new UChannelEntryData(t_write.getValidityEnd(), ewithdata);
+      latest = newEntryData(t_write.getValidityEnd(), ewithdata);
 
       // add a warning on writing event-style on stream channels
       if (t_write.getValiditySpan() == 0) {
@@ -385,7 +470,7 @@ void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
       }
 
       // make a new sentinel
-      latest = new UChannelEntryData(t_write.getValidityEnd(), latest);
+      latest = newEntryData(t_write.getValidityEnd(), latest);
     }
     else {
       /* DUECA channel.
@@ -406,6 +491,14 @@ void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
     }
   }
 
+  // copy for readers of the latest value, before these are triggered
+  if (latest_slot) {
+    UChannelEntryData* ed = latest->getPrevious();
+    latest_slot->publish
+      (ed->seqId(), DataTimeSpec(ed->getValidityStart(),
+                                 ed->getValidityEnd()), data);
+  }
+
   // HACK: race when transport added
 
   if (saveup == SaveUpTryRemove) {
@@ -419,6 +512,21 @@ void UChannelEntry::newData(const void* data, const DataTimeSpec& t_write)
   }
 
   if (writer && pclients.size()) {
+
+    // raw copy into shared memory, for reading ends on this host
+    if (shm_slots && !shm_checked) {
+      shm_checked = true;
+      if (converter->rawCopyable() && entry_id != entry_end) {
+        shm_ring = ShmChannelRing::create
+          (ShmChannelRing::ringName(channel->getNameSet(), entry_id,
+                                    ShmChannelRing::sessionKey()),
+           converter->getMagic(), converter->size(), shm_slots);
+      }
+    }
+    if (shm_ring) {
+      shm_ring->publish(latest_seqid, data);
+    }
+
     DEB(channel->getNameSet() << " entry #" << entry_id <<
         " notify packers " << " seq #" << latest_seqid);
     channel->thereIsNewTransportWork(this, latest_seqid);
@@ -554,9 +662,16 @@ void UChannelEntry::refreshTransporters()
 
 void* UChannelEntry::getDataSpace()
 {
-  if (latest->getPrevious())
-    return converter->clone(latest->getPrevious()->stealData());
-  return converter->clone(NULL);
+  const void* ref = latest->getPrevious() ?
+    latest->getPrevious()->stealData() : NULL;
+
+  // re-fill a recycled data object, if available
+  if (!spare_data.empty()) {
+    void* data = spare_data.back();
+    spare_data.pop_back();
+    return converter->cloneInto(data, ref);
+  }
+  return converter->clone(ref);
 }
 
 
@@ -599,7 +714,24 @@ bool UChannelEntry::packData(AmorphStore& store, int packer_idx,
     // pclient.previous_data = NULL;
   }
 
-  if (pclient.send_full /* || pclient.previous_data == NULL*/) {
+  // data in shared memory only needs a notification, unless a
+  // receiver asked for full data
+  if (shm_ring && !pclient.send_full && shm_ring->holds(seqid)) {
+    DEB(channel->getNameSet() << " entry #" << entry_id <<
+        " shm seq " << seqid);
+    ::packData(store, UChannelCommRequest::ShmData);
+    ::packData(store, entry_id);
+    ::packData(store, uint32_t(seqid));
+    ::packData(store, ShmChannelRing::sessionKey());
+    ::packData(store, ts_actual.getValidityEnd());
+    pclient.n_diff = 0U;
+  }
+
+  // in mixed mode, a periodic full pack lets receivers re-synchronise;
+  // when not from shared memory, always send full, since a receiver
+  // may have missed overwritten data in the ring
+  else if (pclient.send_full || shm_ring ||
+           (full_pack_interval && pclient.n_diff >= full_pack_interval)) {
     DEB(channel->getNameSet() << " entry #" << entry_id <<
         " pack seq " << seqid);
     // header is flag about full data packing, and entry index
@@ -607,7 +739,8 @@ bool UChannelEntry::packData(AmorphStore& store, int packer_idx,
     ::packData(store, entry_id);
     ::packData(store, ts_actual.getValidityEnd());
     converter->packData(store, data);
-    pclient.send_full = fullpackmode;
+    pclient.send_full = fullpackmode && !shm_ring;
+    pclient.n_diff = 0U;
   }
   else {
     DEB("entry=" << entry_id << " differential pack");
@@ -615,6 +748,7 @@ bool UChannelEntry::packData(AmorphStore& store, int packer_idx,
     ::packData(store, entry_id);
     ::packData(store, ts_actual.getValidityEnd());
     converter->packDataDiff(store, data, pclient.previous_data);
+    pclient.n_diff++;
   }
 
   pclient.previous_data = data;
@@ -661,6 +795,9 @@ bool UChannelEntry::unPackData(AmorphReStore& source)
     return true;
   }
 
+  // differential data can be applied again
+  full_requested = false;
+
   // use newData to insert the thing. cleaning is performed when appropriate
   DEB(channel->getNameSet() << " entry #" << entry_id <<
       " unpack tick=" << endtime << " seq " << latest->seqId());
@@ -697,16 +834,83 @@ bool UChannelEntry::unPackDataDiff(AmorphReStore& source)
     return true;
   }
 
+  return false;
+}
+
+bool UChannelEntry::needFullData()
+{
+  if (full_requested) return false;
+  full_requested = true;
+
   /* DUECA channel.
 
-     Differential data has arrived for this channel entry, but the
-     full data (which might be transported in Bulk mode) is not
-     present yet. The differential data will be cached for later
-     application.
-   */
+     Data has arrived for this channel entry that cannot be used;
+     differential data without the preceding data, for example
+     because this end joined after the writing end started sending,
+     or data in shared memory that cannot be mapped or has already
+     been overwritten. The data is dropped, and a full data pack is
+     requested from the writing end. If this happens often with
+     shared memory, increase the "shm-channel-slots" Environment
+     option. */
   W_CHN(channel->getNameSet() << " entry #" << entry_id <<
-        " caching data since full not yet arrived");
-  return false;
+        " requesting full data, data not usable");
+  return true;
+}
+
+bool UChannelEntry::unPackShmData(AmorphReStore& source, uint32_t seqid)
+{
+  // unpack the key of the writing process, and end time
+  uint32_t key(source);
+  TimeTickType endtime(source);
+
+  // map the ring of the writing end
+  if (shm_ring == NULL && !shm_checked) {
+    shm_checked = true;
+    if (converter->rawCopyable()) {
+      shm_ring = ShmChannelRing::attach
+        (ShmChannelRing::ringName(channel->getNameSet(), entry_id, key),
+         converter->getMagic(), converter->size());
+    }
+  }
+
+  if (shm_ring == NULL) {
+    DEB(channel->getNameSet() << " entry #" << entry_id <<
+        " no shared memory for seq " << seqid);
+    return false;
+  }
+
+  // copy the object directly, into a recycled data object if available
+  void *data;
+  if (!spare_data.empty()) {
+    data = spare_data.back();
+    spare_data.pop_back();
+  }
+  else {
+    data = converter->clone(NULL);
+  }
+  if (!shm_ring->read(seqid, data)) {
+    DEB(channel->getNameSet() << " entry #" << entry_id <<
+        " shared memory data seq " << seqid << " not available");
+    if (spare_data.size() < ring_size) {
+      spare_data.push_back(data);
+    }
+    else {
+      converter->delData(data);
+    }
+    return false;
+  }
+
+  full_requested = false;
+  DEB(channel->getNameSet() << " entry #" << entry_id <<
+      " shm tick=" << endtime << " seq " << seqid);
+  if (eventtype) {
+    newData(data, TimeSpec(endtime, endtime));
+  }
+  else {
+    newData(data, TimeSpec(unpackTimeTick(), endtime));
+  }
+
+  return true;
 }
 
 bool UChannelEntry::timeJump(const TimeTickType& jumptime)
@@ -911,8 +1115,25 @@ const void* UChannelEntry::accessData(UCClientHandlePtr client,
     }
   }
 
+  // the newest data, from a copy, without counting the access
+  else if (latest_slot && t_latest == MAX_TIMETICK) {
+    UCEntryClientLinkPtr link = client->entry;
+    if (link->latest_copy == NULL) {
+      link->latest_copy = converter->clone(NULL);
+      link->copy_converter = converter;
+    }
+    uint32_t seqid;
+    if (latest_slot->read(link->latest_copy, seqid, ts_actual)) {
+      origin = this->origin;
+      link->seq_id = seqid;
+      DEB("latest copy returning data: " << ts_actual);
+      return link->latest_copy;
+    }
+    DEB("latest copy not available, access data");
+  }
+
   // now handle reading according to specified data time
-  else {
+  {
     // temporarily lock the oldest datapoint
     AccessLockOldest al(this);
 
@@ -1171,6 +1392,9 @@ void UChannelEntry::releaseData(UCClientHandlePtr client)
   DEB("UChannelEntry::releaseData, channel=" << channel->getId() <<
       " entry=" << entry_id);
 
+  // reading a copy of the latest data, no access to release
+  if (client->accessed == NULL) return;
+
   if (client->entry->isSequential()) {
     // set the index to the next data point, and increment the read access
     // there
@@ -1191,6 +1415,7 @@ void UChannelEntry::releaseDataNoStep(UCClientHandlePtr client)
 {
   DEB("UChannelEntry::releaseDataNoStep, channel=" << channel->getId() <<
       " entry=" << entry_id);
+  if (client->accessed == NULL) return;
   if (client->entry->isSequential()) {
     client->accessed->incrementReadAccess();
   }
@@ -1200,6 +1425,12 @@ void UChannelEntry::releaseDataNoStep(UCClientHandlePtr client)
 
 void UChannelEntry::releaseOnlyAccess(UCClientHandlePtr client)
 {
+  // the client keeps the copy of the latest data, a new one is made
+  if (client->accessed == NULL) {
+    client->entry->latest_copy = NULL;
+    return;
+  }
+
   if (client->entry->isSequential()) {
     client->entry->read_index = client->accessed->getNext();
     client->entry->read_index->incrementReadAccess();
@@ -1353,6 +1584,7 @@ UChannelEntry::PackerClientData::PackerClientData() :
   validity_end(MAX_TIMETICK),
   previous_data(NULL),
   send_full(true),
+  n_diff(0U),
   seq_id(0)
 { }
 
@@ -1360,6 +1592,7 @@ UChannelEntry::PackerClientData::PackerClientData(const PackerClient& c) :
   validity_end(c.validity_end),
   previous_data(c.previous_data),
   send_full(c.send_full),
+  n_diff(c.n_diff),
   seq_id(c.seq_id)
 { }
 
@@ -1380,6 +1613,7 @@ UChannelEntry::PackerClient::operator= (const PackerClientData& d)
   validity_end = d.validity_end;
   previous_data = d.previous_data;
   send_full = d.send_full;
+  n_diff = d.n_diff;
   seq_id = d.seq_id;
   return *this;
 }
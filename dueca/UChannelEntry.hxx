@@ -22,10 +22,13 @@
 #include "UCDataclassLink.hxx"
 #include "UChannelEntryData.hxx"
 #include "vectorMT.hxx"
+#include <vector>
 
 DUECA_NS_START
 
 class DataSetConverter;
+class ShmChannelRing;
+class LatestValueSlot;
 class ChannelWriteToken;
 class UnifiedChannel;
 struct NameSet;
@@ -64,6 +67,9 @@ class UChannelEntry
   /** Name of the data class being written */
   std::string dataclassname;
 
+  /** Registry id of the data class */
+  DataClassRegistry_id_type dataclassid;
+
   /** Provisional ID issued at creation, if the channel was created here */
   uint32_t creation_id;
 
@@ -83,6 +89,11 @@ class UChannelEntry
       next packing action. */
   bool send_full;
 
+  /** Flag to remember that full data has been requested from the
+      writing end, after differential data arrived without the
+      preceding data. */
+  bool full_requested;
+
   /** A pointer to the clean-up entries. Is maintained at one behind the
       oldest; this makes is possible to create a diff pack for the oldest
       data point. */
@@ -99,6 +110,19 @@ class UChannelEntry
   /** A pointer to a currently monitored data point */
   UChannelEntryData* monitored;
 
+  /** Size of the recycling ring for stream entries. Cleaned data
+      points and data objects are kept, up to this number, for re-use
+      in later writes. Zero for event entries, which do not recycle. */
+  unsigned ring_size;
+
+  /** Data point objects cleaned from the list, kept for re-use. */
+  std::vector<UChannelEntryData*> spare_entries;
+
+  /** Data objects cleaned from the list, re-filled by getDataSpace
+      for locally written entries, or by unPackShmData for entries
+      read from shared memory. */
+  std::vector<void*> spare_data;
+
   /** Flag to indicate that this entry can be used. */
   bool valid;
 
@@ -126,6 +150,30 @@ class UChannelEntry
   /** Require full packing */
   bool fullpackmode;
 
+  /** With mixed packing, send a full pack after this many differential
+      packs; 0 for no periodic full packs. */
+  static unsigned full_pack_interval;
+
+  /** Number of slots in a shared memory ring for entry data; 0 for
+      no shared memory transport. */
+  static unsigned shm_slots;
+
+  /** Shared memory with raw copies of the data, for transport to
+      processes on the same host. NULL if not used. */
+  ShmChannelRing* shm_ring;
+
+  /** Remember whether the creation of a shared memory ring has been
+      tried. */
+  bool shm_checked;
+
+  /** Keep a sequence-locked copy of the latest data, for stream
+      entries with a data class of fixed size. */
+  static bool latest_copy;
+
+  /** Copy of the latest data, for readers of the latest value. NULL
+      if not used. */
+  LatestValueSlot* latest_slot;
+
   /** Remember origin of this data */
   GlobalId origin;
 
@@ -177,6 +225,9 @@ class UChannelEntry
     /** A flag to remember a full pack */
     bool              send_full;
 
+    /** Number of differential packs since the last full pack */
+    unsigned          n_diff;
+
     /** Sequence id, to guard against double triggering */
     uchan_seq_id_t       seq_id;
 
@@ -252,7 +303,9 @@ public:
   /** Destructor, takes entered data with it. */
   ~UChannelEntry();
 
-  /** Set minimum requirements on span and depth
+  /** Set minimum requirements on span and depth. For stream
+      entries, the depth also sizes the ring of recycled data points,
+      which is adjusted at the next write.
       @param span    Minimum duration to keep data, in ticks
       @param depth   Minimum number of copies to keep. */
   void setMinimumSpanAndDepth(TimeTickType span, unsigned depth)
@@ -277,6 +330,23 @@ private:
   /** Remove a saveup condition */
   void saveupRemoveInner();
 
+  /** Size the recycling ring to the current depth, and pre-allocate
+      the data point objects. */
+  void adjustRing();
+
+  /** Get a new sentinel data point, re-used if possible. */
+  UChannelEntryData* newEntryData(const TimeTickType& ts,
+                                  UChannelEntryData* current);
+
+  /** Get a new data point with data, re-used if possible. */
+  UChannelEntryData* newEntryData(const TimeTickType& ts,
+                                  const void* data,
+                                  UChannelEntryData* current,
+                                  uchan_seq_id_t seq_id);
+
+  /** Recycle or delete a cleaned data point and its data. */
+  void recycleEntryData(UChannelEntryData* ed);
+
 public:
   /** Does this entry hold event type data? */
   inline bool isEventType() const { return eventtype; }
@@ -284,6 +354,23 @@ public:
   /** Full packing? */
   inline bool isFullPack() const { return fullpackmode; }
 
+  /** Set the interval for full packs in mixed packing mode.
+      \param n               Number of differential packs between full
+                              packs, 0 to only pack full at start or
+                              after gaps. */
+  static void setFullPackInterval(unsigned n) { full_pack_interval = n; }
+
+  /** Set the size of shared memory rings for channel data transport.
+      \param n               Number of slots in each ring, 0 to not use
+                              shared memory transport. */
+  static void setShmSlots(unsigned n) { shm_slots = n; }
+
+  /** Keep a sequence-locked copy of the latest data in stream
+      entries, so readers of the latest value need not count their
+      access.
+      \param c              True to create copies in new entries. */
+  static void setLatestCopy(bool c) { latest_copy = c; }
+
   /** Get the channel pointer back */
   inline const UnifiedChannel* getChannel() const { return channel; }
 
@@ -355,6 +442,10 @@ public:
   /** Get the base dataclass name */
   inline const std::string& getDataClassName() const {return dataclassname; }
 
+  /** Return the registry id of the data class. */
+  inline DataClassRegistry_id_type getDataClassId() const
+  { return dataclassid; }
+
   /** Create new data space */
   void* getDataSpace();
 
@@ -427,9 +518,25 @@ public:
   /** Unpack data for an entry from amorphous storage, take only
       difference from previous entry.
       \param store   Store with data.
-      \returns       True if ok. */
+      \returns       True if ok, false if the previous data is not
+                     present, the store is then not read. */
   bool unPackDataDiff(AmorphReStore& store);
 
+  /** Check whether full data must be requested from the writing end,
+      after unPackDataDiff or unPackShmData failed. Returns true only
+      once, until full data has been received.
+      \returns       True if a request is to be sent. */
+  bool needFullData();
+
+  /** Get data for an entry from shared memory, the store only has
+      the key of the writing process, for the ring name, and the
+      timing.
+      \param store   Store with the key and the time.
+      \param seqid   Sequence number of the data in the ring.
+      \returns       True if ok, false if the ring cannot be mapped or
+                     the data is no longer there. */
+  bool unPackShmData(AmorphReStore& store, uint32_t seqid);
+
   /** Jump in time, keeps data identical but prevents triggering, if enabled
       @param jumptime  New time from which triggering takes place. */
   bool timeJump(const TimeTickType& jumptime);
@@ -465,7 +572,11 @@ public:
 
       If sequential reading, the data is returned when the event time
       (events) or start time (stream) <= t_latest. If time-based
-      reading, the latest data matching the time is returned.
+      reading, the latest data matching the time is returned. If
+      time-based reading of the newest data (t_latest ==
+      MAX_TIMETICK), and the entry keeps a latest-value slot, a copy
+      of the data in the client's link is returned, without counting
+      the access.
 
       \param client Client's handle.
       \param t_latest Time for which the access is requested. If not
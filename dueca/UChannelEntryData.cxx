@@ -78,6 +78,36 @@ UChannelEntryData::~UChannelEntryData()
   //
 }
 
+UChannelEntryData* UChannelEntryData::reUse(const TimeTickType& ts,
+                                            UChannelEntryData* current)
+{
+  time_or_time_end = ts;
+  data = NULL;
+  older = current;
+  newer = NULL;
+  read_accesses = 1U;
+  seq_id = current->seq_id + 1;
+  current->newer = this;
+  DEB2("seq #" << seq_id << " re-used");
+  return this;
+}
+
+UChannelEntryData* UChannelEntryData::reUse(const TimeTickType& ts,
+                                            const void* data,
+                                            UChannelEntryData* current,
+                                            uchan_seq_id_t seq_id)
+{
+  this->time_or_time_end = ts;
+  this->data = data;
+  this->older = current;
+  this->newer = NULL;
+  this->read_accesses = 1U;
+  this->seq_id = seq_id;
+  if (current) current->newer = this;
+  DEB2("seq #" << seq_id << " re-used with data");
+  return this;
+}
+
 // this call is only executed for stream data
 UChannelEntryData* UChannelEntryData::tryDeleteData
 (const TimeTickType tick, const DataSetConverter* converter)
@@ -157,6 +157,19 @@ public:
   /** Destructor. */
   ~UChannelEntryData();
 
+  /** Re-initialise a recycled object as a new sentinel, linked after
+      current. Equivalent to the first constructor, without
+      allocation. */
+  UChannelEntryData* reUse(const TimeTickType& ts,
+                           UChannelEntryData* current);
+
+  /** Re-initialise a recycled object with data and explicit sequence
+      id. Equivalent to the second constructor, without allocation. */
+  UChannelEntryData* reUse(const TimeTickType& ts,
+                           const void* data,
+                           UChannelEntryData* current,
+                           uchan_seq_id_t seq_id);
+
 public:
 
   /** Clean by deleting the data. Moves the current UChannelEntryData object to
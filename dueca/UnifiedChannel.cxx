@@ -349,7 +349,7 @@ bool UnifiedChannel::refreshClientHandleInner(UCClientHandlePtr client)
 
       // first test, is this type of data compatible (same or descendant)
       if (DataClassRegistry::single().isCompatible(
-            client->dataclassname, cc->entry->getDataClassName()) &&
+            client->dataclassid, cc->entry->getDataClassId()) &&
 
           // option one, single specific entry requested (label or id) and
           // there was no connected/found entry yet
@@ -610,8 +610,16 @@ void UnifiedChannel::unPackData(AmorphReStore &source, int sender_id,
       // normal data sending. Have to unpack.
       // ScopeLock e(entries_lock);
       if (!entries[entry]->unPackDataDiff(source)) {
-        cacheUnpack(entry, source, storelevel, len);
-      };
+
+        // the data preceding the difference is missing, skip this
+        // and ask the writing end for a full pack
+        source.setIndex(storelevel + len);
+        if (entries[entry]->needFullData()) {
+          AsyncQueueWriter<UChannelCommRequest> w(config_requests);
+          w.data() = UChannelCommRequest
+            (UChannelCommRequest::FullDataReq, 0U, entry, 0U);
+        }
+      }
     } break;
 
     case UChannelCommRequest::FullData: {
@@ -622,11 +630,29 @@ void UnifiedChannel::unPackData(AmorphReStore &source, int sender_id,
       entries[entry]->unPackData(source);
     } break;
 
+    case UChannelCommRequest::ShmData: {
+
+      // data is in shared memory, data1 has its sequence number; if
+      // not readable, ask the writing end for a full pack
+      if (!entries[entry]->unPackShmData(source, msg.data1) &&
+          entries[entry]->needFullData()) {
+        AsyncQueueWriter<UChannelCommRequest> w(config_requests);
+        w.data() = UChannelCommRequest
+          (UChannelCommRequest::FullDataReq, 0U, entry, 0U);
+      }
+    } break;
+
     case UChannelCommRequest::FullDataReq: {
       if (entries[entry]->isLocal()) {
         DEB(getNameSet() << "full data req entry " << entry);
         entries[entry]->nextSendFull();
       }
+      else if (masterp) {
+        // pass on to the other ends, in case the request did not
+        // reach the writing end directly
+        AsyncQueueWriter<UChannelCommRequest> w(config_requests);
+        w.data() = msg;
+      }
     } break;
 
     case UChannelCommRequest::TimeJump: {
@@ -635,10 +661,21 @@ void UnifiedChannel::unPackData(AmorphReStore &source, int sender_id,
       // enter the gap in time
       entries[entry]->timeJump(msg.data1);
 
-      // the message will furthermore contain a full data pack
+      // the message will furthermore contain a full data pack, or
+      // a reference to shared memory
       UChannelCommRequest msg2(source);
-      assert(msg2.type == UChannelCommRequest::FullData);
-      entries[entry]->unPackData(source);
+      if (msg2.type == UChannelCommRequest::ShmData) {
+        if (!entries[entry]->unPackShmData(source, msg2.data1) &&
+            entries[entry]->needFullData()) {
+          AsyncQueueWriter<UChannelCommRequest> w(config_requests);
+          w.data() = UChannelCommRequest
+            (UChannelCommRequest::FullDataReq, 0U, entry, 0U);
+        }
+      }
+      else {
+        assert(msg2.type == UChannelCommRequest::FullData);
+        entries[entry]->unPackData(source);
+      }
     } break;
 
     case UChannelCommRequest::RemoveSaveupCmd: {
@@ -691,6 +728,14 @@ void UnifiedChannel::updateConfiguration(const UChannelCommRequest &msg)
     entries[msg.data0]->removeSaveUp();
   } break;
 
+    // double, also in unPackData, full data requested by another end
+  case UChannelCommRequest::FullDataReq: {
+    if (msg.data0 < entries.size() && entries[msg.data0] &&
+        entries[msg.data0]->isLocal()) {
+      entries[msg.data0]->nextSendFull();
+    }
+  } break;
+
   case UChannelCommRequest::NewEntryConf:
 
     assert(msg.origin != GlobalId());
@@ -748,7 +793,7 @@ void UnifiedChannel::updateConfiguration(const UChannelCommRequest &msg)
         }
 
         // make the entry accessible, find the mapping in the entrymap
-        std::string clsname(msg.dataclassname);
+        DataClassRegistry_id_type clsid = entries[entry]->getDataClassId();
 
         // increase the configuration counter
         config_version++;
@@ -775,16 +820,16 @@ void UnifiedChannel::updateConfiguration(const UChannelCommRequest &msg)
 
         do {
 
-          // find the matching classname, and if not found create
-          dataclassmap_type::iterator ix = entrymap.find(clsname);
+          // find the matching class, and if not found create
+          dataclassmap_type::iterator ix = entrymap.find(clsid);
           if (ix == entrymap.end()) {
-            DEB("for new entry, adding class map " << clsname);
+            DEB("for new entry, adding class map " << clsid);
             ix = entrymap.insert(
               entrymap.begin(),
-              dataclassmap_type::value_type(clsname, UCDataclassLink()));
+              dataclassmap_type::value_type(clsid, UCDataclassLink()));
           }
           else {
-            DEB("adding entry, to existing class map " << clsname);
+            DEB("adding entry, to existing class map " << clsid);
           }
 
           // add the pointer to this entry to the linked list of writers
@@ -836,9 +881,9 @@ void UnifiedChannel::updateConfiguration(const UChannelCommRequest &msg)
           }
 
           // see if there is a parent class too, repeat the trick there
-          clsname = DataClassRegistry::single().getParent(clsname);
+          clsid = DataClassRegistry::single().getParentId(clsid);
         }
-        while (clsname.size());
+        while (clsid != dataclass_noid);
 
         DEB("Entry now valid");
 #if DEBPRINTLEVEL >= 0
@@ -1434,8 +1479,8 @@ UCClientHandlePtr UnifiedChannel::addReadToken(
     // with lock on the entries, mark config generation
     handle->config_change = latest_entry_config_change;
 
-    // try to find the dataclass mapping with this data class name
-    dataclassmap_type::iterator ix = entrymap.find(dataclassname);
+    // try to find the dataclass mapping with this data class
+    dataclassmap_type::iterator ix = entrymap.find(handle->dataclassid);
     if (ix == entrymap.end()) {
 
       // this type of data not known before, insert a new map object,
@@ -1443,7 +1488,8 @@ UCClientHandlePtr UnifiedChannel::addReadToken(
       // all entries
       ix = entrymap.insert(
         entrymap.begin(),
-        dataclassmap_type::value_type(dataclassname, UCDataclassLink()));
+        dataclassmap_type::value_type(handle->dataclassid,
+                                      UCDataclassLink()));
 
       DEB(getNameSet() << " reading token, new dataclass " << dataclassname);
     }
@@ -1608,7 +1654,7 @@ void UnifiedChannel::removeReadToken(UCClientHandlePtr &client)
   config_version++;
 
   // find the entry in the classmap
-  dataclassmap_type::iterator ix = entrymap.find(client->dataclassname);
+  dataclassmap_type::iterator ix = entrymap.find(client->dataclassid);
 
   // remove it from the list of entries
   UCClientHandleLinkPtr l = ix->second.clients;
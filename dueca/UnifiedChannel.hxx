@@ -160,9 +160,12 @@ private:
   /** class of transportation services used. */
   Channel::TransportClass              transport_class;
 
+protected:
   /** list of entries in this channel. */
   vectorMT<UChannelEntryPtr>           entries;
 
+private:
+
   /** list of temporary storage for incoming data */
   vectorMT<UCEntryDataCache*>          entrycache;
 
@@ -204,10 +207,13 @@ private:
   /** Another lock for watchers. */
   StateGuard                           watchers_lock;
 
+protected:
   /** Configuration requests. Are sent to a master processor locally,
       or sent over the net if not the master. */
   AsyncQueueMT<UChannelCommRequest>    config_requests;
 
+private:
+
   /** Confirmed configuration changes. Are sent out over the net by the
       master. */
   AsyncQueueMT<UChannelCommRequest>    config_changes;
@@ -269,9 +275,12 @@ private:
   /** type for transporters vector */
   typedef vectorMT<GenericPacker*> transporters_type;
 
+protected:
   /** Vector with all transporting clients for this channel. */
   transporters_type transporters;
 
+private:
+
   /** Remember the ID of the master end */
   GlobalId          master_id;
 
@@ -391,13 +400,15 @@ public:
       @returns     Time span (or tick) of the oldest data point */
   DataTimeSpec getLatestDataTime(UCClientHandlePtr client);
 
-private:
+protected:
 
   /** This routine unpacks the data received in a transportable
       representation and constructs the latest event or the current
       dataset out of it. */
   void unPackData(AmorphReStore& source, int sender_id, size_t len);
 
+private:
+
   /** Update the local configuration
       \param msg          The message to be processed */
   void updateConfiguration(const UChannelCommRequest& msg);
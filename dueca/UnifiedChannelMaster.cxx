@@ -501,6 +501,22 @@ void UnifiedChannelMaster::process(AsyncQueueMT<UChannelCommRequest>& req,
     }
       break;
 
+      /* Request for full data, from an end that received differential
+         data without the preceding data.
+         Incoming message has:
+         * data0: entry handle
+
+         Actions:
+         - pass on to all ends, the end with the writing entry will
+           pack the next data in full
+       */
+    case UChannelCommRequest::FullDataReq: {
+      DEB(chanid << " full data request #" << req.front().data0);
+      AsyncQueueWriter<UChannelCommRequest> w(com);
+      w.data() = req.front();
+    }
+      break;
+
     default:
       /* DUECA channel.
 
@@ -243,6 +243,15 @@ struct dco_traits<fixvector<N, D>> : public dco_traits_iterablefix,
 template <size_t N, typename D>
 struct dco_nested<fixvector<N, D>> : public dco_nested<D> {};
 
+/** Borrow raw copy property from the data type */
+template <size_t N, typename D>
+struct dco_rawcopy<fixvector<N, D>> : public dco_rawcopy<D> {};
+
+/** Packed size, from the size of the elements */
+template <size_t N, typename D>
+struct dco_packsize<fixvector<N, D>> :
+  public std::integral_constant<size_t, N * dco_packsize<D>::value> {};
+
 DUECA_NS_END;
 
 PRINT_NS_START;
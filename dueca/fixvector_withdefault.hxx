@@ -169,6 +169,18 @@ struct dco_nested<fixvector_withdefault<N, D, DEFLT, BASE>> :
   public dco_nested<D>
 {};
 
+/** Borrow raw copy property from the data type */
+template <size_t N, typename D, int DEFLT, unsigned BASE>
+struct dco_rawcopy<fixvector_withdefault<N, D, DEFLT, BASE>> :
+  public dco_rawcopy<D>
+{};
+
+/** Packed size, from the size of the elements */
+template <size_t N, typename D, int DEFLT, unsigned BASE>
+struct dco_packsize<fixvector_withdefault<N, D, DEFLT, BASE>> :
+  public std::integral_constant<size_t, N * dco_packsize<D>::value>
+{};
+
 DUECA_NS_END;
 
 PRINT_NS_START;
@@ -628,6 +628,109 @@ struct unstream {
       throw  msgpack_unpack_mismatch("wrong type, expected nil");
     }
   }
+
+  /** Skip a complete object, of any type
+
+      @param i0    Iterator
+      @param iend  End value iterator
+  */
+  static void skip_object(S& i0, const S& iend)
+  {
+    check_iterator_notend(i0, iend);
+    uint8_t flag = uint8_t(*i0); ++i0;
+    uint32_t nbytes = 0U, nobjects = 0U;
+    if (flag < 0x80 || flag >= 0xe0) {
+      return;                                   // fixint
+    }
+    else if (flag < 0x90) {
+      nobjects = 2U * (flag & 0x0f);            // fixmap
+    }
+    else if (flag < 0xa0) {
+      nobjects = flag & 0x0f;                   // fixarray
+    }
+    else if (flag < 0xc0) {
+      nbytes = flag & 0x1f;                     // fixstr
+    }
+    else {
+      switch(flag) {
+      case 0xc0:                                // nil, bool
+      case 0xc2:
+      case 0xc3:
+        return;
+      case 0xc4:                                // bin, str
+      case 0xd9:
+        nbytes = process_int<false,true,
+                             endian::native,S,uint8_t>::positive(i0, iend);
+        break;
+      case 0xc5:
+      case 0xda:
+        nbytes = process_int<false,true,
+                             endian::native,S,uint16_t>::positive(i0, iend);
+        break;
+      case 0xc6:
+      case 0xdb:
+        nbytes = process_int<false,true,
+                             endian::native,S,uint32_t>::positive(i0, iend);
+        break;
+      case 0xc7:                                // ext, data and type
+        nbytes = 1U + process_int<false,true,
+                                  endian::native,S,uint8_t>::positive(i0, iend);
+        break;
+      case 0xc8:
+        nbytes = 1U + process_int<false,true,
+                                  endian::native,S,uint16_t>::positive(i0, iend);
+        break;
+      case 0xc9:
+        nbytes = 1U + process_int<false,true,
+                                  endian::native,S,uint32_t>::positive(i0, iend);
+        break;
+      case 0xcc:                                // int, float
+      case 0xd0:
+        nbytes = 1U; break;
+      case 0xcd:
+      case 0xd1:
+        nbytes = 2U; break;
+      case 0xca:
+      case 0xce:
+      case 0xd2:
+        nbytes = 4U; break;
+      case 0xcb:
+      case 0xcf:
+      case 0xd3:
+        nbytes = 8U; break;
+      case 0xd4:                                // fixext, type and data
+        nbytes = 2U; break;
+      case 0xd5:
+        nbytes = 3U; break;
+      case 0xd6:
+        nbytes = 5U; break;
+      case 0xd7:
+        nbytes = 9U; break;
+      case 0xd8:
+        nbytes = 17U; break;
+      case 0xdc:                                // array
+        nobjects = process_int<false,true,
+                               endian::native,S,uint16_t>::positive(i0, iend);
+        break;
+      case 0xdd:
+        nobjects = process_int<false,true,
+                               endian::native,S,uint32_t>::positive(i0, iend);
+        break;
+      case 0xde:                                // map
+        nobjects = 2U * process_int<false,true,
+                                    endian::native,S,uint16_t>::positive(i0, iend);
+        break;
+      case 0xdf:
+        nobjects = 2U * process_int<false,true,
+                                    endian::native,S,uint32_t>::positive(i0, iend);
+        break;
+      default:
+        throw  msgpack_unpack_mismatch("unknown type, cannot skip");
+      }
+    }
+    for (; nbytes; nbytes--) { check_iterator_notend(i0, iend); ++i0; }
+    for (; nobjects; nobjects--) { skip_object(i0, iend); }
+  }
 };
 
 template<typename S>
@@ -638,6 +741,10 @@ template<typename S>
 inline void msg_unpack(S& i0, const S& iend)
 { return unstream<S>::unpack_nil(i0, iend); }
 
+template<typename S>
+inline void msg_skip(S& i0, const S& iend)
+{ return unstream<S>::skip_object(i0, iend); }
+
 template<typename S>
 inline void msg_unpack(S& i0, const S& iend, uint8_t& i)
 { unstream<S>::unpack_int(i0, iend, i); }
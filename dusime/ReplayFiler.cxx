@@ -146,8 +146,8 @@ void ReplayFiler::runCommand(const TimeSpec &ts)
     case ReplayCommand::Command::SpoolReplay: {
 
       // runs through all recorders for this entity, setting start and
-      // end offsets
-      filer->spoolForReplay(cmd.data().run_cycle);
+      // end offsets; the tick gives the start point within the stretch
+      filer->spoolForReplay(cmd.data().run_cycle, cmd.data().tick);
     } break;
 
     case ReplayCommand::Command::StartReplay: {
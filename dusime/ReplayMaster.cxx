@@ -61,6 +61,7 @@ ReplayMaster::ReplayMaster(const char *entity) :
   available_replays(),
   current_selection(-1),
   current_replay(),
+  replay_from(0U),
   watch_confirm(this),
   cb1(this, &_ThisModule_::followDusimeStates),
   cb2(this, &_ThisModule_::followUp),
@@ -150,16 +151,7 @@ void ReplayMaster::followDusimeStates(const TimeSpec &ts)
           else {
             setState(ReplayingThenHold);
           }
-          {
-            DataWriter<ReplayCommand> cmd(w_replaycommand);
-            cmd.data().command = ReplayCommand::Command::StartReplay;
-            cmd.data().tick = ts.getValidityStart();
-          }
-          do_followup.switchOn(ts);
-          replay_stop = ts.getValidityStart() + current_replay->tick1 -
-                        current_replay->tick0;
-          DEB("At tick " << ts.getValidityStart() << " planning replay stop at "
-                         << replay_stop);
+          startReplay(ts);
           break;
 
         default:
@@ -309,15 +301,20 @@ void ReplayMaster::initWork(const std::string &reference_file,
   }
 }
 
-void ReplayMaster::changeSelection(int selected)
+void ReplayMaster::changeSelection(int selected, TimeTickType from_tick)
 {
   if (selected >= 0 && selected < int(available_replays.size())) {
     current_selection = selected;
     current_replay.reset(available_replays[current_selection].get());
+
+    // a start point beyond the recorded span falls back to the start
+    replay_from = (from_tick < current_replay->tick1 - current_replay->tick0) ?
+      from_tick : 0U;
   }
   else {
     current_selection = -1;
     current_replay.reset();
+    replay_from = 0U;
   }
 }
 
@@ -327,11 +324,29 @@ void ReplayMaster::sendSelected()
     DataWriter<ReplayCommand> cmd(w_replaycommand);
     cmd.data().command = ReplayCommand::Command::SpoolReplay;
     cmd.data().run_cycle = current_replay->cycle;
-    cmd.data().tick = current_replay->tick0;
+
+    // start tick relative to the stretch start, as stored in the data
+    cmd.data().tick = current_replay->tick0 + replay_from;
     setState(ReplayPrepared);
   }
 }
 
+void ReplayMaster::startReplay(const TimeSpec &ts)
+{
+  {
+    DataWriter<ReplayCommand> cmd(w_replaycommand);
+    cmd.data().command = ReplayCommand::Command::StartReplay;
+    cmd.data().tick = ts.getValidityStart();
+  }
+  do_followup.switchOn(ts);
+
+  // replay runs from the selected start point to the end of the stretch
+  replay_stop = ts.getValidityStart() + current_replay->tick1 -
+                current_replay->tick0 - replay_from;
+  DEB("At tick " << ts.getValidityStart() << " planning replay stop at "
+                 << replay_stop);
+}
+
 void ReplayMaster::addTagInformation(unsigned node, const ReplayReport &info,
                                      bool after_init)
 {
@@ -253,6 +253,10 @@ private:
   /** Quick access */
   boost::intrusive_ptr<ReplayInfo> current_replay;
 
+  /** Start point of the replay, in ticks from the start of the
+      selected recording stretch */
+  TimeTickType            replay_from;
+
   /** Files */
   std::string             reference_file;
 
@@ -341,10 +345,19 @@ public:
   /** Run all existing data through the given information callback */
   void runRecords(const fun_newrep_t& fun);
 
-  /** Pre-select one of the replays for sending */
-  void changeSelection(int selected);
+  /** Pre-select one of the replays for sending
+
+      @param selected   Index of the replay.
+      @param from_tick  Start point of the replay, in ticks relative to
+                        the start of the recorded stretch. Note that the
+                        initial condition stored with the recording
+                        applies to the start of the stretch; starting
+                        later in the stretch is for replays that do not
+                        depend on the model state.
+  */
+  void changeSelection(int selected, TimeTickType from_tick = 0U);
 
-  /** Send the selected replay */
+  /** Send the selected replay, spooling to the selected start point */
   void sendSelected();
 
   /** Mode for after replay */
@@ -377,6 +390,12 @@ protected:
   void addTagInformation(unsigned node, const ReplayReport& info,
                          bool after_init);
 
+  /** Command the start of the prepared replay, and plan its stop */
+  void startReplay(const TimeSpec& ts);
+
+  /** Planned stop of the replay, MAX_TIMETICK if none */
+  inline TimeTickType getReplayStop() const { return replay_stop; }
+
   /** Callback for token validity */
   void checkValid(const TimeSpec& ts);
 
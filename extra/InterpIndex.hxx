@@ -40,8 +40,17 @@ class InterpIndex
   /** Index with points. */
   const T* ipts;
 
+  /** Flag to indicate the points are equally spaced */
+  bool uniform;
+
+  /** Inverse of the spacing, for equally spaced points */
+  double step_inv;
+
 public:
-  /** Constructor from static data. */
+  /** Constructor from static data.
+      \param n      Number of points, at least 2.
+      \param ipts   Index points, in increasing order.
+      \throws std::invalid_argument when there are less than 2 points. */
   InterpIndex(int n, const T* ipts);
 
   /** Constructor, reading from file. */
@@ -54,15 +63,74 @@ public:
   /** return the number of indexes. */
   inline int nDim() const {return n;}
 
-  /** update an index, and fraction, return whether within the table. */
+  /** return whether the points are equally spaced. */
+  inline bool isUniform() const {return uniform;}
+
+  /** update an index, and fraction, return whether within the table.
+      Starts from the previous index value, and only searches the
+      table when the value is no longer in the same interval. */
   inline bool updateIndex(int& index, double& frac, const T& value) const
   {
-    if (index < 0) index = 0; if (index > n_m2) index = n_m2;
-    while (index > 0 && value < ipts[index]) index--;
-    while (index < n_m2 && value > ipts[index + 1]) index++;
+    if (uniform || index < 0 || index > n_m2 ||
+        value < ipts[index] || value > ipts[index + 1]) {
+      return findIndex(index, frac, value);
+    }
     frac = (value - ipts[index]) / (ipts[index + 1] - ipts[index]);
+    return true;
+  }
+
+  /** find an index and fraction, without using a previous index
+      value, return whether within the table. Equally spaced points
+      are indexed directly, otherwise a binary search without
+      branches is used; this form is suited for batch lookup. A NaN
+      value gives index 0 and a NaN fraction. */
+  inline bool findIndex(int& index, double& frac, const T& value) const
+  {
+    if (uniform) {
+      const double x = (value - ipts[0]) * step_inv;
+      index = !(x >= 0.0) ? 0 : (x > n_m2 ? n_m2 : int(x));
+      frac = x - index;
+    }
+    else {
+      const T* base = ipts;
+      for (int len = n_m1; len > 1; ) {
+        const int half = len / 2;
+        base = (base[half] <= value) ? base + half : base;
+        len -= half;
+      }
+      index = base - ipts;
+      frac = (value - ipts[index]) / (ipts[index + 1] - ipts[index]);
+    }
     return (frac >= 0.0 && frac <= 1.0);
   }
+
+  /** find indices and fractions for a batch of values. Fractions
+      are limited to the table, as done by the interpolators; NaN
+      values keep a NaN fraction.
+      \param index   Resulting indices, n values.
+      \param frac    Resulting fractions, n values.
+      \param value   Values to look up, n values.
+      \param n       Number of values. */
+  inline void findIndices(int* index, double* frac,
+                          const T* value, unsigned n) const
+  {
+    if (uniform) {
+      // separate loop, without calls, for vectorisation
+      for (unsigned ii = 0; ii < n; ii++) {
+        const double x = (value[ii] - ipts[0]) * step_inv;
+        const int i = !(x >= 0.0) ? 0 : (x > n_m2 ? n_m2 : int(x));
+        const double f = x - i;
+        index[ii] = i;
+        frac[ii] = f < 0.0 ? 0.0 : (f > 1.0 ? 1.0 : f);
+      }
+    }
+    else {
+      for (unsigned ii = 0; ii < n; ii++) {
+        findIndex(index[ii], frac[ii], value[ii]);
+        frac[ii] = frac[ii] < 0.0 ? 0.0 : (frac[ii] > 1.0 ? 1.0 : frac[ii]);
+      }
+    }
+  }
 };
 DUECA_NS_END
 #endif
@@ -75,6 +143,8 @@ DUECA_NS_END
    || (defined(DO_INSTANTIATE) && defined(INCLUDE_TEMPLATE_SOURCE))
 #ifndef InterpIndex_ii
 #define InterpIndex_ii
+#include <cmath>
+#include <stdexcept>
 #include <dueca_ns.h>
 DUECA_NS_START
 template<class T>
@@ -82,9 +152,24 @@ InterpIndex<T>::InterpIndex(int n, const T* ipts) :
   n(n),
   n_m1(n-1),
   n_m2(n-2),
-  ipts(ipts)
+  ipts(ipts),
+  uniform(false),
+  step_inv(0.0)
 {
-  //
+  // interpolation needs at least one interval
+  if (n < 2) {
+    throw std::invalid_argument("InterpIndex needs at least 2 points");
+  }
+
+  // check for equally spaced points, these can be indexed directly
+  const double step = (double(ipts[n_m1]) - ipts[0]) / n_m1;
+  uniform = step > 0.0;
+  for (int ii = 1; uniform && ii < n_m1; ii++) {
+    uniform = std::fabs(ipts[0] + ii * step - ipts[ii]) <= 1e-9 * step;
+  }
+  if (uniform) {
+    step_inv = 1.0 / step;
+  }
 }
 
 /*
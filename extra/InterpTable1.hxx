@@ -20,6 +20,8 @@
 #include <dueca_ns.h>
 DUECA_NS_START
 
+class InterpTableFile;
+
 /** Interpolation data holder, for 1d interpolation tables. Either
     reads data from file, or uses a static array initialisation. */
 template<class T, class I>
@@ -39,6 +41,12 @@ public:
   InterpTable1(const I& i1,
                const T* data);
 
+  /** Constructor with a mapped table file as input. The file object
+      must remain in existence while the table is used.
+      \param file  Table file, with breakpoints and data for 1
+                   dimensions. */
+  InterpTable1(const InterpTableFile& file);
+
 #if 0
   /** Constructor with a file as input, flexible. */
   InterpTable1(const char* filename);
@@ -55,6 +63,16 @@ public:
     if (i1 < 0) i1 = 0; if (i1 > index1.maxDim()) i1 = index1.maxDim();
     return data[i1];
   }
+
+  /** Interpolate a batch of points. Indices and fractions are first
+      found for all points, per index, after which the table values
+      are combined. Outside the table the edge values are used, as
+      with the interpolators.
+      \param result  Interpolated values, n values.
+      \param val1    Values for the first index, n values.
+      \param n       Number of points. */
+  void getValues(T* result, const T* val1,
+                 unsigned n) const;
 };
 DUECA_NS_END
 
@@ -68,6 +86,7 @@ DUECA_NS_END
    || (defined(DO_INSTANTIATE) && defined(INCLUDE_TEMPLATE_SOURCE))
 #ifndef InterpTable1_ii
 #define InterpTable1_ii
+#include <InterpTableFile.hxx>
 #include <dueca_ns.h>
 DUECA_NS_START
 
@@ -80,6 +99,36 @@ InterpTable1<T,I>::InterpTable1(const I& i1,
   //
 }
 
+template<class T, class I>
+InterpTable1<T,I>::InterpTable1(const InterpTableFile& file) :
+  index1(file.dim(0), file.axis<T>(0)),
+  data(file.data<T>())
+{
+  if (file.nDims() != 1U) {
+    throw(InterpTableFileError("table dimension does not match file"));
+  }
+}
+
+template<class T, class I>
+void InterpTable1<T,I>::getValues(T* result, const T* val1,
+                                  unsigned n) const
+{
+  // work in chunks, keeping indices and fractions for a chunk locally
+  const unsigned chunk = 64U;
+  int i1[chunk];
+  double f1[chunk];
+
+  for (unsigned k0 = 0; k0 < n; k0 += chunk) {
+    const unsigned nk = (n - k0 < chunk) ? n - k0 : chunk;
+    index1.findIndices(i1, f1, val1 + k0, nk);
+
+    for (unsigned k = 0; k < nk; k++) {
+      const T* d = data + i1[k];
+      result[k0 + k] = (1.0 - f1[k]) * d[0] + f1[k] * d[1];
+    }
+  }
+}
+
 #if 0
 template<class T, class I>
 InterpTable1<T,I>::InterpTable1(const char* filename)
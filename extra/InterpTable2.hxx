@@ -20,6 +20,8 @@
 #include <dueca_ns.h>
 DUECA_NS_START
 
+class InterpTableFile;
+
 /** Interpolation data holder, for 2d interpolation tables. Either
     reads data from file, or uses a static array initialisation. */
 template<class T, class I>
@@ -47,6 +49,12 @@ public:
   InterpTable2(const I& i1, const I& i2,
                const T* data);
 
+  /** Constructor with a mapped table file as input. The file object
+      must remain in existence while the table is used.
+      \param file  Table file, with breakpoints and data for 2
+                   dimensions. */
+  InterpTable2(const InterpTableFile& file);
+
 #if 0
   /** Constructor with a file as input, flexible. */
   InterpTable2(const char* filename);
@@ -68,6 +76,17 @@ public:
     if (i2 < 0) i2 = 0; if (i2 > index2.maxDim()) i2 = index2.maxDim();
     return data[i1 * index2.nDim() + i2];
   }
+
+  /** Interpolate a batch of points. Indices and fractions are first
+      found for all points, per index, after which the table values
+      are combined. Outside the table the edge values are used, as
+      with the interpolators.
+      \param result  Interpolated values, n values.
+      \param val1    Values for the first index, n values.
+      \param val2    Values for the second index, n values.
+      \param n       Number of points. */
+  void getValues(T* result, const T* val1, const T* val2,
+                 unsigned n) const;
 };
 DUECA_NS_END
 
@@ -81,6 +100,7 @@ DUECA_NS_END
    || (defined(DO_INSTANTIATE) && defined(INCLUDE_TEMPLATE_SOURCE))
 #ifndef InterpTable2_ii
 #define InterpTable2_ii
+#include <InterpTableFile.hxx>
 #include <dueca_ns.h>
 DUECA_NS_START
 
@@ -94,6 +114,41 @@ InterpTable2<T,I>::InterpTable2(const I& i1, const I& i2,
   //
 }
 
+template<class T, class I>
+InterpTable2<T,I>::InterpTable2(const InterpTableFile& file) :
+  index1(file.dim(0), file.axis<T>(0)),
+  index2(file.dim(1), file.axis<T>(1)),
+  data(file.data<T>())
+{
+  if (file.nDims() != 2U) {
+    throw(InterpTableFileError("table dimension does not match file"));
+  }
+}
+
+template<class T, class I>
+void InterpTable2<T,I>::getValues(T* result, const T* val1, const T* val2,
+                                  unsigned n) const
+{
+  // work in chunks, keeping indices and fractions for a chunk locally
+  const unsigned chunk = 64U;
+  int i1[chunk], i2[chunk];
+  double f1[chunk], f2[chunk];
+  const int n2 = index2.nDim();
+
+  for (unsigned k0 = 0; k0 < n; k0 += chunk) {
+    const unsigned nk = (n - k0 < chunk) ? n - k0 : chunk;
+    index1.findIndices(i1, f1, val1 + k0, nk);
+    index2.findIndices(i2, f2, val2 + k0, nk);
+
+    for (unsigned k = 0; k < nk; k++) {
+      const T* d = data + i1[k] * n2 + i2[k];
+      const double c0 = (1.0 - f2[k]) * d[0] + f2[k] * d[1];
+      const double c1 = (1.0 - f2[k]) * d[n2] + f2[k] * d[n2 + 1];
+      result[k0 + k] = (1.0 - f1[k]) * c0 + f1[k] * c1;
+    }
+  }
+}
+
 #if 0
 template<class T, class I>
 InterpTable2<T,I>::InterpTable2(const char* filename)
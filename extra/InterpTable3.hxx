@@ -20,6 +20,8 @@
 #include <dueca_ns.h>
 DUECA_NS_START
 
+class InterpTableFile;
+
 /** Interpolation data holder, for 3d interpolation tables. Either
     reads data from file, or uses a static array initialisation. */
 template<class T, class I>
@@ -44,6 +46,12 @@ public:
   InterpTable3(const I& i1, const I& i2, const I& i3,
                const T* data);
 
+  /** Constructor with a mapped table file as input. The file object
+      must remain in existence while the table is used.
+      \param file  Table file, with breakpoints and data for 3
+                   dimensions. */
+  InterpTable3(const InterpTableFile& file);
+
 #if 0
   /** Constructor with a file as input, flexible. */
   InterpTable3(const char* filename);
@@ -70,6 +78,18 @@ public:
     if (i3 < 0) i3 = 0; if (i3 > index3.maxDim()) i3 = index3.maxDim();
     return data[(i1 * index2.nDim() + i2) * index3.nDim() + i3];
   }
+
+  /** Interpolate a batch of points. Indices and fractions are first
+      found for all points, per index, after which the table values
+      are combined. Outside the table the edge values are used, as
+      with the interpolators.
+      \param result  Interpolated values, n values.
+      \param val1    Values for the first index, n values.
+      \param val2    Values for the second index, n values.
+      \param val3    Values for the third index, n values.
+      \param n       Number of points. */
+  void getValues(T* result, const T* val1, const T* val2,
+                 const T* val3, unsigned n) const;
 };
 DUECA_NS_END
 
@@ -83,6 +103,7 @@ DUECA_NS_END
    || (defined(DO_INSTANTIATE) && defined(INCLUDE_TEMPLATE_SOURCE))
 #ifndef InterpTable3_ii
 #define InterpTable3_ii
+#include <InterpTableFile.hxx>
 #include <dueca_ns.h>
 DUECA_NS_START
 
@@ -97,6 +118,49 @@ InterpTable3<T,I>::InterpTable3(const I& i1, const I& i2, const I& i3,
   //
 }
 
+template<class T, class I>
+InterpTable3<T,I>::InterpTable3(const InterpTableFile& file) :
+  index1(file.dim(0), file.axis<T>(0)),
+  index2(file.dim(1), file.axis<T>(1)),
+  index3(file.dim(2), file.axis<T>(2)),
+  data(file.data<T>())
+{
+  if (file.nDims() != 3U) {
+    throw(InterpTableFileError("table dimension does not match file"));
+  }
+}
+
+template<class T, class I>
+void InterpTable3<T,I>::getValues(T* result, const T* val1, const T* val2,
+                                  const T* val3, unsigned n) const
+{
+  // work in chunks, keeping indices and fractions for a chunk locally
+  const unsigned chunk = 64U;
+  int i1[chunk], i2[chunk], i3[chunk];
+  double f1[chunk], f2[chunk], f3[chunk];
+  const int n2 = index2.nDim();
+  const int n3 = index3.nDim();
+  const int s1 = n2 * n3;
+
+  for (unsigned k0 = 0; k0 < n; k0 += chunk) {
+    const unsigned nk = (n - k0 < chunk) ? n - k0 : chunk;
+    index1.findIndices(i1, f1, val1 + k0, nk);
+    index2.findIndices(i2, f2, val2 + k0, nk);
+    index3.findIndices(i3, f3, val3 + k0, nk);
+
+    for (unsigned k = 0; k < nk; k++) {
+      const T* d = data + (i1[k] * n2 + i2[k]) * n3 + i3[k];
+      const double c00 = (1.0 - f3[k]) * d[0] + f3[k] * d[1];
+      const double c01 = (1.0 - f3[k]) * d[n3] + f3[k] * d[n3 + 1];
+      const double c10 = (1.0 - f3[k]) * d[s1] + f3[k] * d[s1 + 1];
+      const double c11 = (1.0 - f3[k]) * d[s1 + n3] + f3[k] * d[s1 + n3 + 1];
+      const double c0 = (1.0 - f2[k]) * c00 + f2[k] * c01;
+      const double c1 = (1.0 - f2[k]) * c10 + f2[k] * c11;
+      result[k0 + k] = (1.0 - f1[k]) * c0 + f1[k] * c1;
+    }
+  }
+}
+
 #if 0
 #pragma BullseyeCoverage off
 template<class T, class I>
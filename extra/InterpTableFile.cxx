@@ -0,0 +1,287 @@
+/* ------------------------------------------------------------------   */
+/*      item            : InterpTableFile.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define InterpTableFile_cxx
+#include "InterpTableFile.hxx"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <debug.h>
+#include <cstring>
+#include <cstdlib>
+
+DUECA_NS_START
+
+/** Identification at the start of a table file */
+static const char itb_magic[8] = { 'D', 'U', 'E', 'C', 'A', 'I', 'T', 'B' };
+
+/** Current file format version */
+static const uint32_t itb_version = 1U;
+
+/** Alignment of breakpoints and data in the file */
+static const uint64_t itb_align = 64U;
+
+static inline uint64_t itb_aligned(uint64_t off)
+{
+  return (off + itb_align - 1U) & ~(itb_align - 1U);
+}
+
+/** Write a complete buffer to a file, continuing after partial writes */
+static bool writeAll(int fd, const void* buf, uint64_t n)
+{
+  const char* p = reinterpret_cast<const char*>(buf);
+  while (n) {
+    const ssize_t w = ::write(fd, p, n);
+    if (w == -1 && errno == EINTR) continue;
+    if (w <= 0) return false;
+    p += w;
+    n -= w;
+  }
+  return true;
+}
+
+InterpTableFileError::InterpTableFileError(const InterpTableFileError& e) :
+  reason(e.reason)
+{
+  //
+}
+
+InterpTableFileError::InterpTableFileError(const char* reason) :
+  reason(reason)
+{
+  //
+}
+
+InterpTableFileError::~InterpTableFileError() throw()
+{
+  //
+}
+
+InterpTableFile::InterpTableFile(const std::string& fname) :
+  fname(fname),
+  size(0),
+  base(NULL),
+  header(NULL),
+  device(0),
+  inode(0)
+{
+  int fd = ::open(fname.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    /* DUECA extra.
+
+       Cannot open an interpolation table file. Check the file name
+       and permissions. */
+    W_XTR("InterpTableFile cannot open " << fname << ", " <<
+          strerror(errno));
+    throw(InterpTableFileError("cannot open table file"));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == -1 || size_t(st.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw(InterpTableFileError("not a table file"));
+  }
+  size = st.st_size;
+  device = st.st_dev;
+  inode = st.st_ino;
+  void* mem = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mem == MAP_FAILED) {
+    throw(InterpTableFileError("cannot map table file"));
+  }
+  base = reinterpret_cast<const char*>(mem);
+  header = reinterpret_cast<const Header*>(base);
+
+  // check the header, and that all data is within the file
+  const char* problem = NULL;
+  if (std::memcmp(header->magic, itb_magic, sizeof(itb_magic))) {
+    problem = "not a table file";
+  }
+  else if (header->version != itb_version) {
+    problem = "table file version not supported";
+  }
+  else if (header->byteorder != 0x01020304U) {
+    problem = "table file has the wrong byte order";
+  }
+  else if (header->ndims < 1U || header->ndims > max_dims ||
+           (header->elsize != 4U && header->elsize != 8U)) {
+    problem = "table file header corrupt";
+  }
+  else {
+    uint64_t ndata = 1U;
+    for (unsigned ii = 0; !problem && ii < header->ndims; ii++) {
+      ndata *= header->dims[ii];
+      if (header->dims[ii] < 2U ||
+          header->axis_offset[ii] % header->elsize ||
+          header->axis_offset[ii] + uint64_t(header->dims[ii]) *
+          header->elsize > size) {
+        problem = "table file breakpoints corrupt";
+      }
+    }
+    if (!problem && (header->data_offset % header->elsize ||
+                     header->data_offset + ndata * header->elsize > size)) {
+      problem = "table file truncated";
+    }
+  }
+  if (problem) {
+    /* DUECA extra.
+
+       An interpolation table file is not correct. Re-create the file
+       with InterpTableFile::write. */
+    W_XTR("InterpTableFile " << fname << ": " << problem);
+    munmap(const_cast<char*>(base), size);
+    throw(InterpTableFileError(problem));
+  }
+}
+
+InterpTableFile::~InterpTableFile()
+{
+  munmap(const_cast<char*>(base), size);
+}
+
+void InterpTableFile::checkElementSize(size_t elsize) const
+{
+  if (elsize != header->elsize) {
+    throw(InterpTableFileError("table value type does not match file"));
+  }
+}
+
+int InterpTableFile::dim(unsigned i) const
+{
+  if (i >= header->ndims) {
+    throw(InterpTableFileError("table dimension not in file"));
+  }
+  return header->dims[i];
+}
+
+bool InterpTableFile::isReplaced() const
+{
+  struct stat st;
+  if (stat(fname.c_str(), &st) == -1) {
+    // file removed, possibly being replaced, keep the current one
+    return false;
+  }
+  return !isFile(st.st_dev, st.st_ino);
+}
+
+void InterpTableFile::write(const std::string& fname, unsigned ndims,
+                            const int* dims, const void* const* axes,
+                            const void* data, unsigned elsize,
+                            uint32_t revision)
+{
+  if (ndims < 1U || ndims > max_dims || (elsize != 4U && elsize != 8U)) {
+    throw(InterpTableFileError("cannot write table with these dimensions"));
+  }
+
+  // lay out the file
+  Header h;
+  std::memset(&h, 0, sizeof(h));
+  std::memcpy(h.magic, itb_magic, sizeof(itb_magic));
+  h.version = itb_version;
+  h.byteorder = 0x01020304U;
+  h.elsize = elsize;
+  h.ndims = ndims;
+  h.revision = revision;
+  uint64_t off = itb_aligned(sizeof(Header));
+  uint64_t ndata = 1U;
+  for (unsigned ii = 0; ii < ndims; ii++) {
+    if (dims[ii] < 2) {
+      throw(InterpTableFileError("table needs two or more breakpoints"));
+    }
+    h.dims[ii] = dims[ii];
+    h.axis_offset[ii] = off;
+    off = itb_aligned(off + uint64_t(dims[ii]) * elsize);
+    ndata *= dims[ii];
+  }
+  h.data_offset = off;
+
+  // write to a uniquely named temporary file in the same directory,
+  // and replace the old file only when complete and on disk; programs
+  // using the old file keep their mapping
+  std::string tmpname = fname + ".XXXXXX";
+  int fd = ::mkstemp(&tmpname[0]);
+  if (fd == -1) {
+    throw(InterpTableFileError("cannot create table file"));
+  }
+  const char zeros[itb_align] = { 0 };
+  bool ok = ::fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0 &&
+    writeAll(fd, &h, sizeof(h));
+  uint64_t pos = sizeof(h);
+  for (unsigned ii = 0; ok && ii <= ndims; ii++) {
+    const uint64_t start = ii < ndims ? h.axis_offset[ii] : h.data_offset;
+    const uint64_t n = (ii < ndims ? uint64_t(dims[ii]) : ndata) * elsize;
+    ok = writeAll(fd, zeros, start - pos) &&
+      writeAll(fd, ii < ndims ? axes[ii] : data, n);
+    pos = start + n;
+  }
+  ok = ok && ::fsync(fd) == 0;
+  if (::close(fd) == -1 || !ok) {
+    ::unlink(tmpname.c_str());
+    throw(InterpTableFileError("cannot write table file"));
+  }
+  if (::rename(tmpname.c_str(), fname.c_str()) == -1) {
+    ::unlink(tmpname.c_str());
+    throw(InterpTableFileError("cannot replace table file"));
+  }
+}
+
+InterpTableSource::InterpTableSource(const std::string& fname) :
+  fname(fname),
+  current(new InterpTableFile(fname)),
+  rejected_device(0),
+  rejected_inode(0)
+{
+  //
+}
+
+InterpTableSource::~InterpTableSource()
+{
+  //
+}
+
+std::shared_ptr<const InterpTableFile> InterpTableSource::get() const
+{
+  return std::atomic_load(&current);
+}
+
+bool InterpTableSource::reload()
+{
+  struct stat st;
+  if (stat(fname.c_str(), &st) == -1 ||
+      std::atomic_load(&current)->isFile(st.st_dev, st.st_ino) ||
+      (st.st_dev == rejected_device && st.st_ino == rejected_inode)) {
+    return false;
+  }
+  try {
+    std::shared_ptr<const InterpTableFile> next(new InterpTableFile(fname));
+    std::atomic_store(&current, next);
+    return true;
+  }
+  catch (const InterpTableFileError& e) {
+    rejected_device = st.st_dev;
+    rejected_inode = st.st_ino;
+    /* DUECA extra.
+
+       A new version of an interpolation table file could not be
+       used. The previous version of the table remains in use. */
+    W_XTR("InterpTableSource keeping old version of " << fname <<
+          ", " << e.what());
+  }
+  return false;
+}
+
+DUECA_NS_END
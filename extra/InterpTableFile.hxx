@@ -0,0 +1,279 @@
+/* ------------------------------------------------------------------   */
+/*      item            : InterpTableFile.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Memory-mapped binary file with interpolation
+                          table data
+        changes         : 261017 first version
+        api             : DUECA_API
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#ifndef InterpTableFile_hxx
+#define InterpTableFile_hxx
+
+#include <exception>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <sys/types.h>
+#include <dueca_ns.h>
+
+DUECA_NS_START
+
+/** Exception to be thrown by InterpTableFile when an error occurs. */
+class InterpTableFileError: public std::exception
+{
+  /** String explaining the problem. */
+  const char* reason;
+
+public:
+  /** Copy constructor.
+      \param   e         Original exception. */
+  InterpTableFileError(const InterpTableFileError& e);
+
+  /** Normal constructor.
+      \param   reason    String explaining the why. */
+  InterpTableFileError(const char* reason = "InterpTableFile error");
+
+  /** Destructor. */
+  virtual ~InterpTableFileError() throw();
+
+  /** Override the "what" of the standard class */
+  const char* what() const throw() {return reason;}
+};
+
+/** Binary file with the breakpoints and data of an interpolation
+    table, of one to four dimensions.
+
+    The file is mapped read-only into memory, so that opening even
+    large tables is quick, and the data is only read from disk when
+    used. The InterpTable1 to InterpTable4 classes can be constructed
+    from an opened file, e.g.
+
+    \code
+    InterpTableFile f("cl.itb");
+    InterpTable2<double, InterpIndex<double> > cl(f);
+    \endcode
+
+    The file object must remain in existence while the table is used.
+
+    The file starts with a header, describing the number of
+    dimensions, the number of breakpoints for each dimension, and the
+    size of the values; 4 for float, 8 for double. The breakpoints for
+    each dimension and the table data follow, each aligned on 64
+    bytes. The data is in row-major order, as for the InterpTable
+    classes, and in the byte order of the host; a file from a host
+    with a different byte order is rejected.
+
+    Use the write() call to create table files. Writing is done to a
+    temporary file in the same directory, which is synced to disk and
+    then replaces any previous file, so that programs that have the
+    old file open are not affected, and a crash does not leave a
+    partial table. Use an
+    InterpTableSource to switch to a new version of the file while
+    running.
+*/
+class InterpTableFile
+{
+public:
+  /** Maximum number of table dimensions */
+  static const unsigned max_dims = 4U;
+
+  /** Layout of the file header. */
+  struct Header
+  {
+    /** Identification, "DUECAITB" */
+    char      magic[8];
+
+    /** Format version */
+    uint32_t  version;
+
+    /** Byte order check, 0x01020304 in the byte order of the host */
+    uint32_t  byteorder;
+
+    /** Size of breakpoint and data values */
+    uint32_t  elsize;
+
+    /** Number of dimensions */
+    uint32_t  ndims;
+
+    /** Number of breakpoints per dimension */
+    uint32_t  dims[max_dims];
+
+    /** Revision of the table data, as given by the writer */
+    uint32_t  revision;
+
+    /** Spare, keeps the offsets aligned */
+    uint32_t  spare;
+
+    /** Offsets of the breakpoints for each dimension */
+    uint64_t  axis_offset[max_dims];
+
+    /** Offset of the table data */
+    uint64_t  data_offset;
+  };
+
+private:
+  /** Name of the file */
+  std::string         fname;
+
+  /** Size of the mapping */
+  size_t              size;
+
+  /** Start of the mapped file */
+  const char*         base;
+
+  /** File header */
+  const Header*       header;
+
+  /** Device of the mapped file */
+  dev_t               device;
+
+  /** Inode of the mapped file */
+  ino_t               inode;
+
+  /** Check the element size for data access */
+  void checkElementSize(size_t elsize) const;
+
+public:
+  /** Constructor, opens and maps a file.
+      \param fname   Name of the file.
+      \throws InterpTableFileError when the file cannot be opened, or
+                     is not a correct table file. */
+  InterpTableFile(const std::string& fname);
+
+  /** Destructor, unmaps the file. */
+  ~InterpTableFile();
+
+  /** Name of the file. */
+  inline const std::string& getName() const { return fname; }
+
+  /** Number of dimensions of the table. */
+  inline unsigned nDims() const { return header->ndims; }
+
+  /** Revision of the table data. */
+  inline uint32_t getRevision() const { return header->revision; }
+
+  /** Number of breakpoints for a dimension.
+      \param i       Dimension, 0 to nDims() - 1. */
+  int dim(unsigned i) const;
+
+  /** Breakpoints for a dimension.
+      \param i       Dimension, 0 to nDims() - 1. */
+  template<class T>
+  const T* axis(unsigned i) const
+  {
+    checkElementSize(sizeof(T)); dim(i);
+    return reinterpret_cast<const T*>(base + header->axis_offset[i]);
+  }
+
+  /** Table data, in row-major order. */
+  template<class T>
+  const T* data() const
+  {
+    checkElementSize(sizeof(T));
+    return reinterpret_cast<const T*>(base + header->data_offset);
+  }
+
+  /** Check whether this is the given file. */
+  inline bool isFile(dev_t dev, ino_t ino) const
+  { return dev == device && ino == inode; }
+
+  /** Check whether the file has since been replaced by another
+      file with the same name. */
+  bool isReplaced() const;
+
+  /** Write a table file.
+      \param fname   Name of the file. An existing file is replaced.
+      \param ndims   Number of dimensions.
+      \param dims    Number of breakpoints for each dimension.
+      \param axes    Breakpoints for each dimension.
+      \param data    Table data, in row-major order.
+      \param elsize  Size of breakpoint and data values.
+      \param revision Revision number for the data.
+      \throws InterpTableFileError when writing fails. */
+  static void write(const std::string& fname, unsigned ndims,
+                    const int* dims, const void* const* axes,
+                    const void* data, unsigned elsize,
+                    uint32_t revision = 0U);
+
+  /** Write a table file, templated on the value type.
+      \param fname   Name of the file. An existing file is replaced.
+      \param ndims   Number of dimensions.
+      \param dims    Number of breakpoints for each dimension.
+      \param axes    Breakpoints for each dimension.
+      \param data    Table data, in row-major order.
+      \param revision Revision number for the data. */
+  template<class T>
+  static void write(const std::string& fname, unsigned ndims,
+                    const int* dims, const T* const* axes,
+                    const T* data, uint32_t revision = 0U)
+  {
+    write(fname, ndims, dims, reinterpret_cast<const void* const*>(axes),
+          data, sizeof(T), revision);
+  }
+};
+
+/** Access to a table file that may be replaced while running.
+
+    The current version of the file is obtained with get(). Calling
+    reload(), e.g. between simulation steps, or from a separate
+    activity, checks whether the file has been replaced, and maps the
+    new version. The switch to the new version is atomic; users of
+    the previous version keep that until they release it, and tables
+    created from it remain valid that long.
+
+    A new version is recognised by the pointer returned by get();
+    the revision number in the file is informative only, and need
+    not change when a file is rewritten.
+
+    \code
+    // once per step, switch to any new version
+    std::shared_ptr<const InterpTableFile> f = source.get();
+    if (f != current) {
+      table.reset(new InterpTable2<double, InterpIndex<double> >(*f));
+      current = f;
+    }
+    \endcode
+*/
+class InterpTableSource
+{
+  /** Name of the file */
+  std::string         fname;
+
+  /** Currently mapped file */
+  std::shared_ptr<const InterpTableFile> current;
+
+  /** Device of a new file that could not be used */
+  dev_t               rejected_device;
+
+  /** Inode of a new file that could not be used */
+  ino_t               rejected_inode;
+
+public:
+  /** Constructor, maps the file.
+      \param fname   Name of the file.
+      \throws InterpTableFileError when the file cannot be used. */
+  InterpTableSource(const std::string& fname);
+
+  /** Destructor. */
+  ~InterpTableSource();
+
+  /** Current version of the file. */
+  std::shared_ptr<const InterpTableFile> get() const;
+
+  /** Check whether the file has been replaced, and if so, map the
+      new version. Only call this from one thread at a time.
+      \returns       true if a new version is now in use. When the
+                     new file cannot be used, the old version is
+                     kept. */
+  bool reload();
+};
+
+DUECA_NS_END
+
+#endif
@@ -0,0 +1,238 @@
+/* ------------------------------------------------------------------   */
+/*      item            : LinearSystemN.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Linear system with fixed dimensions
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+        documentation   : DUECA_API
+*/
+
+#ifndef LinearSystemN_hxx
+#define LinearSystemN_hxx
+
+#include "LinearSystem.hxx"
+
+namespace dueca {
+
+/** A linear time-invariant (control) system, with the number of
+    states, inputs and outputs fixed at compile time.
+
+    The system matrices and vectors are fixed-size Eigen matrices,
+    which are stored in the object itself. Calculating a step does not
+    allocate memory, and for small systems this is considerably
+    faster than the LinearSystem class. The system can be created in
+    the same manner as a LinearSystem; the dimensions of the result
+    must match the template parameters.
+
+    \code
+    // second-order filter, one input, one output
+    LinearSystemN<2,1,1> filter(num, den, 0.01);
+    double y = filter.step(u)[0];
+    \endcode
+
+    \tparam NX     Number of states.
+    \tparam NU     Number of inputs.
+    \tparam NY     Number of outputs.
+*/
+template<int NX, int NU, int NY>
+class LinearSystemN
+{
+  static_assert(NX > 0 && NU > 0 && NY > 0,
+                "LinearSystemN needs fixed, non-zero dimensions");
+
+public:
+  /** Transition matrix type */
+  typedef Eigen::Matrix<double,NX,NX> PhiMatrix;
+
+  /** Input matrix type */
+  typedef Eigen::Matrix<double,NX,NU> PsiMatrix;
+
+  /** Output matrix type */
+  typedef Eigen::Matrix<double,NY,NX> CMatrix;
+
+  /** Feedthrough matrix type */
+  typedef Eigen::Matrix<double,NY,NU> DMatrix;
+
+  /** State vector type */
+  typedef Eigen::Matrix<double,NX,1> StateVector;
+
+  /** Input vector type */
+  typedef Eigen::Matrix<double,NU,1> InputVector;
+
+  /** Output vector type */
+  typedef Eigen::Matrix<double,NY,1> OutputVector;
+
+  /** States of a batch of systems, one per column */
+  typedef Eigen::Matrix<double,NX,Eigen::Dynamic> StateBatch;
+
+  /** Inputs for a batch of systems, one per column */
+  typedef Eigen::Matrix<double,NU,Eigen::Dynamic> InputBatch;
+
+  /** Outputs of a batch of systems, one per column */
+  typedef Eigen::Matrix<double,NY,Eigen::Dynamic> OutputBatch;
+
+protected:
+  /** Transition matrix. */
+  PhiMatrix Phi;
+
+  /** Input matrix. */
+  PsiMatrix Psi;
+
+  /** Output matrix. */
+  CMatrix C;
+
+  /** Feedthrough matrix. */
+  DMatrix D;
+
+  /** The state vector. */
+  StateVector x;
+
+  /** The output vector. */
+  OutputVector y;
+
+private:
+  /** Copy the matrices of a dynamically sized system. */
+  void copyFrom(const LinearSystem& sys)
+  {
+    if (sys.getPhi().rows() != NX || sys.getPsi().cols() != NU ||
+        sys.getC().rows() != NY) {
+      throw(LinSysException(__FILE__, __LINE__,
+                            "system dimensions do not match LinearSystemN"));
+    }
+    Phi = sys.getPhi();
+    Psi = sys.getPsi();
+    C = sys.getC();
+    D = sys.getD();
+    x = sys.getX();
+    y.setZero();
+  }
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /** Default constructor, all matrices zero. */
+  LinearSystemN()
+  {
+    Phi.setZero(); Psi.setZero(); C.setZero(); D.setZero();
+    x.setZero(); y.setZero();
+  }
+
+  /** Construct a SISO system from a continuous time transfer
+      function. The order of the denominator must match NX.
+      \param num   Numerator of the transfer function. Elements are
+      arranged as num[0]*s^0 + num[1]*s^1 etc.
+      \param den   Denominator.
+      \param dt    Size, in seconds, of the discrete time step. */
+  LinearSystemN(const Vector& num, const Vector& den, double dt)
+  { copyFrom(LinearSystem(num, den, dt)); }
+
+  /** Construct a system from a continuous time state space system.
+      \param A     A matrix
+      \param B     B matrix
+      \param C     C matrix
+      \param D     D matrix
+      \param dt    Size, in seconds, of the discrete time step. */
+  LinearSystemN(const Matrix& A, const Matrix& B,
+                const Matrix& C, const Matrix& D, double dt)
+  { copyFrom(LinearSystem(A, B, C, D, dt)); }
+
+  /** Construct a system from a discrete time state space system.
+      \param phi   phi matrix
+      \param psi   psi matrix
+      \param C     C matrix
+      \param D     D matrix */
+  LinearSystemN(const PhiMatrix& phi, const PsiMatrix& psi,
+                const CMatrix& C, const DMatrix& D) :
+    Phi(phi), Psi(psi), C(C), D(D)
+  { x.setZero(); y.setZero(); }
+
+  /** Construct from a dynamically sized system, which must have
+      matching dimensions. */
+  explicit LinearSystemN(const LinearSystem& sys)
+  { copyFrom(sys); }
+
+  /** Accept a new state
+      \param x_new  Vector with the new state. */
+  void acceptState(const StateVector& x_new)
+  {
+    y.noalias() += C * (x_new - x);
+    x = x_new;
+  }
+
+  /** Calculate a single time step, return the output vector.
+      \param u      Input vector. */
+  template<class V>
+  const OutputVector& step(const Eigen::MatrixBase<V>& u)
+  {
+    StateVector xn;
+    xn.noalias() = Phi * x;
+    xn.noalias() += Psi * u;
+    x = xn;
+    y.noalias() = C * x;
+    y.noalias() += D * u;
+    return y;
+  }
+
+  /** Calculate a single time step, return the output vector.
+      \param u      Input variable. Only valid for SI systems. */
+  const OutputVector& step(double u)
+  {
+    static_assert(NU == 1, "scalar step only for single-input systems");
+    return step(InputVector::Constant(u));
+  }
+
+  /** Calculate a time step for a batch of systems with the dynamics
+      of this system, e.g. the same filter applied to a number of
+      signals. The states of this system are not used.
+      \param X      States, one column for each system.
+      \param U      Inputs, one column for each system.
+      \param Y      Resulting outputs, sized to match. */
+  void stepBatch(StateBatch& X, const InputBatch& U, OutputBatch& Y) const
+  {
+    if (U.cols() != X.cols()) {
+      throw(LinSysException(__FILE__, __LINE__,
+                            "batch inputs do not match states"));
+    }
+    Y.resize(NY, X.cols());
+    for (Eigen::Index ii = 0; ii < X.cols(); ii++) {
+      StateVector xn;
+      xn.noalias() = Phi * X.col(ii);
+      xn.noalias() += Psi * U.col(ii);
+      X.col(ii) = xn;
+      Y.col(ii).noalias() = C * xn;
+      Y.col(ii).noalias() += D * U.col(ii);
+    }
+  }
+
+  /** Reset the state to 0; */
+  void reset()
+  { x.setZero(); y.setZero(); }
+
+  /** Obtain the output vector. */
+  inline const OutputVector& getY() const {return y;}
+
+  /** Obtain the state vector. */
+  inline const StateVector& getX() const {return x;}
+
+  /** Obtain the state vector for modification. */
+  inline StateVector& getX() {return x;}
+
+  /** Transition matrix. */
+  inline const PhiMatrix& getPhi() const {return Phi;}
+
+  /** Input matrix discrete system. */
+  inline const PsiMatrix& getPsi() const {return Psi;}
+
+  /** Output matrix. */
+  inline const CMatrix& getC() const {return C;}
+
+  /** Feedthrough matrix. */
+  inline const DMatrix& getD() const {return D;}
+};
+
+} // namespace dueca
+#endif
@@ -97,7 +97,7 @@ void RigidBody::initialize(double x, double y, double z,
     \param q     The quaternion, in the form of
                  (lambda_x, lambda_y, lambda_z, Lambda).
     \param Uq    Result, the rotation matrix. */
-static void u_quat(const Vector& q, Matrix3& Uq)
+static void u_quat(const Vector4& q, Matrix3& Uq)
 {
 
   double u = sqrt(q.dot(q));
@@ -137,42 +137,43 @@ void RigidBody::derivative(VectorE& xd, double unused)
 {
   // derivatives of u, v, w (x(0,2)
   // \dot{u} = force/mass - Omega u
-  xd.head(3) = -1.0 * Omega * x.head(3) + force / mass;
+  xd.head<3>() = -1.0 * Omega * x.head<3>() + force / mass;
 
   // add gravitational acceleration, Gravitation is in inertial, so
   // translate to the body, since we are considering body coordinate accel.
-  xd.head(3) += _A * einstein;
+  xd.head<3>() += _A * einstein;
 
   // derivative of the earth position, calculate from speed in body
   // coordinates, the speed in inertial coordinates, that is the
   // derivative
   // remember A is DCM, gives transformation from inertial to body,
   // have to go reverse here
-  xd.segment(3,3) = _A.transpose() * x.head(3);
+  xd.segment<3>(3) = _A.transpose() * x.head<3>();
 
   // derivative of the rotation speed vector \omega_b
   // \dot{\omega} = Jn^{-1} \left[ M - \Omega Jn \omega \right]
-  xd.segment(6,3) = Jninv * (-1.0 * Omega * (Jn * x.segment(6,3)) + moment / mass);
+  tmp0.noalias() = Jn * x.segment<3>(6);
+  xd.segment<3>(6) = Jninv * (-1.0 * Omega * tmp0 + moment / mass);
 
   // derivative of the attitude quaternion, from rotational speed
-  quat_der(x.segment(9,4), x.segment(6,3), dq);
+  quat_der(x.segment<4>(9), x.segment<3>(6), dq);
   // quat_der does not handle ranges
-  xd.segment(9,4) = dq;
+  xd.segment<4>(9) = dq;
 }
 
 void RigidBody::specific(Vector& sp)
 {
   // specific forces, in body ax, in elements 0 - 2
-  sp.head(3) = force / mass;
+  sp.head<3>() = force / mass;
 
   // specific moment, in body ax, in elements 3 - 5
-  sp.segment(3,3) = Jninv * moment / mass;
+  sp.segment<3>(3) = Jninv * moment / mass;
 }
 
 void RigidBody::prepare()
 {
   // calculate rotation matrix
-  u_quat(x.segment(9,4), _A);
+  u_quat(x.segment<4>(9), _A);
 
   // calculate cross-product matrix
   Omega <<  0.0, -x(8), x(7),
@@ -200,12 +201,24 @@ void RigidBody::changeState(const Vector& dx)
   prepare();
 }
 
+void RigidBody::changeState(const VectorE& dx)
+{
+  x += dx;
+  prepare();
+}
+
 void RigidBody::setState(const Vector& newx)
 {
   x = newx;
   prepare();
 }
 
+void RigidBody::setState(const VectorE& newx)
+{
+  x = newx;
+  prepare();
+}
+
 void RigidBody::changeMass(const double dm)
 {
   mass += dm;
@@ -223,7 +236,7 @@ void RigidBody::output()
   ibeta = atan2(x[1], x[0]);
 
   // on the side, also normalize the quaternion
-  Vector q = x.segment(9,4) / sqrt(x.segment(9,4).dot(x.segment(9,4)));
+  Vector4 q = x.segment<4>(9) / sqrt(x.segment<4>(9).dot(x.segment<4>(9)));
 
   double Au = q[0];
   double Bu = q[1];
@@ -247,19 +260,19 @@ void RigidBody::applyBodyForce(const Vector3& Fb, const Vector3& point)
   applyBodyMoment(tmp0);
 }
 
-void RigidBody::applyInertialForce(const Vector& Fi, const Vector& point)
+void RigidBody::applyInertialForce(const Vector3& Fi, const Vector3& point)
 {
   // translate to body axes and apply
   tmp1 = _A * Fi;
   applyBodyForce(tmp1, point);
 }
 
-void RigidBody::applyBodyMoment(const Vector& M)
+void RigidBody::applyBodyMoment(const Vector3& M)
 {
   moment += M;
 }
 
-void RigidBody::addInertialGravity(const Vector& g)
+void RigidBody::addInertialGravity(const Vector3& g)
 {
   einstein += g;
 }
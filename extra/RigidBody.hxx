@@ -47,6 +47,8 @@ typedef Eigen::Vector4d Vector4;
 typedef Eigen::VectorXd Vector;
 /// a vector that takes external storage
 typedef Eigen::Map<Eigen::VectorXd> VectorE;
+/// the 13-element state of a rigid body without additional states
+typedef Eigen::Matrix<double,13,1> Vector13;
 
 // quaternion derivative
 template<class V1, class V2, class V4>
@@ -100,6 +102,10 @@ static void quat_der(const V1& q, const V2& omega, V4& dq)
 
     Then call  RigidBody::derivative() to obtain the derivative.
 
+    All internal calculations use fixed-size vectors and matrices, and
+    do not allocate memory. For bodies without additional states, the
+    derivative can also be calculated into a fixed-size Vector13.
+
     RigidBody::specific(), RigidBody::X() and RigidBody::phi(),
     RigidBody::theta(), RigidBody::psi() can be used to get your
     outputs.
@@ -228,27 +234,28 @@ public:
   {
     // derivatives of u, v, w (x(0,2)
     // \dot{u} = force/mass - Omega u
-    xd.head(3) = -1.0 * Omega * x.head(3) + force / mass;
+    xd.template head<3>() = -1.0 * Omega * x.head<3>() + force / mass;
 
     // add gravitational acceleration, Gravitation is in inertial, so
     // translate to the body, since we are considering body coordinate accel.
-    xd.head(3) += _A * einstein;
+    xd.template head<3>() += _A * einstein;
 
     // derivative of the earth position, calculate from speed in body
     // coordinates, the speed in inertial coordinates, that is the
     // derivative
     // remember A is DCM, gives transformation from inertial to body,
     // have to go reverse here
-    xd.segment(3,3) = _A * x.head(3);
+    xd.template segment<3>(3) = _A.transpose() * x.head<3>();
 
     // derivative of the rotation speed vector \omega_b
     // \dot{\omega} = Jn^{-1} \left[ M - \Omega Jn \omega \right]
-    xd.segment(6,3) = Jninv * (-1.0 * Omega * (Jn * x.segment(6,3)) + moment / mass);
+    tmp0.noalias() = Jn * x.segment<3>(6);
+    xd.template segment<3>(6) = Jninv * (-1.0 * Omega * tmp0 + moment / mass);
 
     // derivative of the attitude quaternion, from rotational speed
-    quat_der(x.segment(9,4), x.segment(6,3), dq);
+    quat_der(x.segment<4>(9), x.segment<3>(6), dq);
     // quat_der does not handle ranges
-    xd.segment(9,4) = dq;
+    xd.template segment<4>(9) = dq;
   }
 
 
@@ -268,22 +275,30 @@ public:
 
   /** Apply a force expressed in inertial coordinates, at a specific
       body point, give in body coordinates. */
-  void applyInertialForce(const Vector& Fi, const Vector& point);
+  void applyInertialForce(const Vector3& Fi, const Vector3& point);
 
   /** Apply a moment expressed in body coordinates. */
-  void applyBodyMoment(const Vector& M);
+  void applyBodyMoment(const Vector3& M);
 
   /** Change the state vector by a quantity dx. */
   void changeState(const Vector& dx);
 
+  /** Change the state vector by a quantity dx, in external storage,
+      as used by the integration functions. */
+  void changeState(const VectorE& dx);
+
   /** Add a gravitational field; 3 element vector, gravitation
       expressed in the inertial system. */
-  void addInertialGravity(const Vector& g);
+  void addInertialGravity(const Vector3& g);
 
   /** Put in a new state vector. Note that you need a 13-element
       vector */
   void setState(const Vector& newx);
 
+  /** Put in a new state vector, in external storage, as used by the
+      integration functions. */
+  void setState(const VectorE& newx);
+
   /** Add to the mass of the body. */
   void changeMass(const double dm);
 
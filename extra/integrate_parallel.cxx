@@ -0,0 +1,114 @@
+/* ------------------------------------------------------------------   */
+/*      item            : integrate_parallel.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#include "integrate_parallel.hxx"
+
+IntegrationPool::IntegrationPool(unsigned nthreads) :
+  nthreads(nthreads),
+  generation(0U),
+  busy(0U),
+  stop(false),
+  job(NULL),
+  ctx(NULL),
+  njobs(0U),
+  chunk(1U),
+  next(0U)
+{
+  if (this->nthreads == 0U) {
+    unsigned ncpu = std::thread::hardware_concurrency();
+    this->nthreads = ncpu > 1U ? ncpu - 1U : 0U;
+  }
+}
+
+IntegrationPool::~IntegrationPool()
+{
+  {
+    std::unique_lock<std::mutex> l(mtx);
+    stop = true;
+  }
+  cv_start.notify_all();
+  for (auto &w: workers) {
+    w.join();
+  }
+}
+
+void IntegrationPool::work()
+{
+  for (unsigned idx = next.fetch_add(chunk, std::memory_order_relaxed);
+       idx < njobs;
+       idx = next.fetch_add(chunk, std::memory_order_relaxed)) {
+    const unsigned end = idx + chunk < njobs ? idx + chunk : njobs;
+    try {
+      for (; idx < end; idx++) {
+        job(ctx, idx);
+      }
+    }
+    catch (...) {
+      std::unique_lock<std::mutex> l(mtx);
+      if (!error) error = std::current_exception();
+    }
+  }
+}
+
+void IntegrationPool::worker()
+{
+  unsigned done = 0U;
+  std::unique_lock<std::mutex> l(mtx);
+  while (true) {
+    cv_start.wait(l, [this, done]() { return stop || generation != done; });
+    if (stop) return;
+    done = generation;
+    l.unlock();
+    work();
+    l.lock();
+    if (--busy == 0U) {
+      cv_done.notify_one();
+    }
+  }
+}
+
+void IntegrationPool::run(job_function job, void* ctx, unsigned njobs,
+                          unsigned chunk)
+{
+  // start the workers on first use, from the integrating thread
+  if (workers.size() < nthreads) {
+    for (unsigned ii = workers.size(); ii < nthreads; ii++) {
+      workers.emplace_back(&IntegrationPool::worker, this);
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> l(mtx);
+    this->job = job;
+    this->ctx = ctx;
+    this->njobs = njobs;
+    this->chunk = chunk ? chunk : 1U;
+    this->next.store(0U, std::memory_order_relaxed);
+    this->error = nullptr;
+    busy = nthreads;
+    generation++;
+  }
+  cv_start.notify_all();
+
+  // also work in this thread, then wait for the others
+  work();
+  std::exception_ptr e;
+  {
+    std::unique_lock<std::mutex> l(mtx);
+    cv_done.wait(l, [this]() { return busy == 0U; });
+    e = error;
+    error = nullptr;
+  }
+  if (e) {
+    std::rethrow_exception(e);
+  }
+}
@@ -0,0 +1,219 @@
+/* ------------------------------------------------------------------   */
+/*      item            : integrate_parallel.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        description     : Integration of a set of models, on a pool
+                          of worker threads.
+        api             : DUECA_API
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#ifndef integrate_parallel_hxx
+#define integrate_parallel_hxx
+
+#include "integrate_rungekutta.hxx"
+#include "integrate_euler.hxx"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+/** \file integrate_parallel.hxx
+    Integration of a number of models, e.g., RigidBody objects, in
+    parallel on a pool of worker threads. */
+
+/** A pool of worker threads, that run a number of independent jobs,
+    and return when all jobs are done.
+
+    The threads are started on the first run() call. They inherit the
+    scheduling policy and priority of the thread that makes that
+    call, normally the thread of the activity that does the
+    integration. The calling thread also takes jobs, so a pool with
+    n threads runs the jobs on n+1 threads.
+*/
+class IntegrationPool
+{
+public:
+  /** Function type for a job.
+      \param ctx     Context pointer, as passed to run().
+      \param idx     Index of the job. */
+  typedef void (*job_function)(void* ctx, unsigned idx);
+
+private:
+  /** Number of worker threads. */
+  unsigned            nthreads;
+
+  /** Worker threads. */
+  std::vector<std::thread> workers;
+
+  /** Protects the control variables. */
+  std::mutex          mtx;
+
+  /** Signals a new run, or stop. */
+  std::condition_variable cv_start;
+
+  /** Signals completion of the workers. */
+  std::condition_variable cv_done;
+
+  /** Number of the current run. */
+  unsigned            generation;
+
+  /** Workers still busy with the current run. */
+  unsigned            busy;
+
+  /** Stop flag, for destruction. */
+  bool                stop;
+
+  /** Job function of the current run. */
+  job_function        job;
+
+  /** Context of the current run. */
+  void*               ctx;
+
+  /** Number of jobs of the current run. */
+  unsigned            njobs;
+
+  /** Number of jobs taken at once. */
+  unsigned            chunk;
+
+  /** Next job to take. */
+  std::atomic<unsigned> next;
+
+  /** First exception thrown by a job. */
+  std::exception_ptr  error;
+
+  /** Worker thread loop. */
+  void worker();
+
+  /** Take and run jobs, until all are taken. */
+  void work();
+
+public:
+  /** Constructor.
+      \param nthreads   Number of worker threads. With 0, the number
+                        of processors minus one is used. */
+  IntegrationPool(unsigned nthreads = 0U);
+
+  /** Destructor, stops the worker threads. */
+  ~IntegrationPool();
+
+  /** Run a set of jobs, and return when all are done.
+      \param job        Function for the jobs.
+      \param ctx        Context pointer passed to the function.
+      \param njobs      Number of jobs, indices 0 to njobs-1.
+      \param chunk      Number of consecutive jobs taken at once.
+      \throws           The first exception thrown by a job, after all
+                        jobs are done. */
+  void run(job_function job, void* ctx, unsigned njobs, unsigned chunk = 1U);
+
+  /** Number of worker threads. */
+  inline unsigned size() const { return nthreads; }
+};
+
+/** Integration of a set of models, in parallel on an IntegrationPool.
+
+    Each model is integrated with the same integration function as
+    for a single model; integrate_rungekutta() when the workspace type
+    WS is RungeKuttaWorkspace, integrate_euler() for an
+    EulerWorkspace. The results are therefore identical to those of
+    integrating the models one by one.
+
+    The derivative calculation of a model may only modify that model,
+    since different models are calculated in different threads. Any
+    forces depending on other models should be determined before the
+    step, e.g.:
+
+    \code
+    IntegrationPool pool(3);
+    ParallelIntegration<Vehicle, RungeKuttaWorkspace> vehicles(pool);
+    for (auto &v: traffic) { vehicles.add(v); }
+
+    // in the activity
+    vehicles.step(dt);
+    \endcode
+
+    \tparam MOD    Model class, see integrate_rungekutta().
+    \tparam WS     Workspace type, RungeKuttaWorkspace or EulerWorkspace.
+*/
+template<class MOD, class WS>
+class ParallelIntegration
+{
+  /** Pool that does the work. */
+  IntegrationPool&    pool;
+
+  /** The models. */
+  std::vector<MOD*>   models;
+
+  /** Workspace for each model. */
+  std::vector<WS*>    workspaces;
+
+  /** Time step of the current step. */
+  double              dt;
+
+  /** Models integrated as one job. */
+  unsigned            chunk;
+
+  /** Integration step, Runge-Kutta */
+  static inline void integrate(MOD& model, RungeKuttaWorkspace& ws, double dt)
+  { integrate_rungekutta(model, ws, dt); }
+
+  /** Integration step, Euler */
+  static inline void integrate(MOD& model, EulerWorkspace& ws, double dt)
+  { integrate_euler(model, ws, dt); }
+
+  /** Job function, integrates one model. */
+  static void stepOne(void* ctx, unsigned idx)
+  {
+    ParallelIntegration* self = reinterpret_cast<ParallelIntegration*>(ctx);
+    integrate(*self->models[idx], *self->workspaces[idx], self->dt);
+  }
+
+public:
+  /** Constructor.
+      \param pool    Pool of threads for the integration.
+      \param chunk   Number of models integrated as one job. Use a
+                     larger number for cheap models. */
+  ParallelIntegration(IntegrationPool& pool, unsigned chunk = 4U) :
+    pool(pool), dt(0.0), chunk(chunk)
+  { }
+
+  /** Destructor. */
+  ~ParallelIntegration()
+  { for (auto ws: workspaces) { delete ws; } }
+
+  /** Copying is not possible, the workspaces are owned. */
+  ParallelIntegration(const ParallelIntegration&) = delete;
+
+  /** Nor is assignment. */
+  ParallelIntegration& operator = (const ParallelIntegration&) = delete;
+
+  /** Add a model. The model is not copied, and must remain valid.
+      \param model   Model, its state is integrated at each step. */
+  void add(MOD& model)
+  {
+    models.push_back(&model);
+    workspaces.push_back(new WS(model.X().size()));
+  }
+
+  /** Number of models. */
+  inline unsigned size() const { return models.size(); }
+
+  /** Access a model. */
+  inline MOD& operator [] (unsigned idx) { return *models[idx]; }
+
+  /** Integrate all models over one time step.
+      \param dt      Time step of the integration. */
+  void step(double dt)
+  {
+    this->dt = dt;
+    pool.run(&stepOne, this, models.size(), chunk);
+  }
+};
+
+#endif
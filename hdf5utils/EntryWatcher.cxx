@@ -213,10 +213,9 @@ void EntryWatcher::EntryData::createFunctor(std::weak_ptr<H5::H5File> nfile,
   dpath << path << "/e" << std::setw(6) << std::setfill('0') << eidx;
 
   DEB("Functor at " << dpath.str());
-  functor.reset(metafunctor.lock()->getWriteFunctor
-                (nfile.lock(), dpath.str(), chunksize,
-                 ei.entry_label, master->getOpTime(always_logging),
-                 compress));
+  functor.reset(master->createWriteFunctor
+                (metafunctor, nfile, dpath.str(), chunksize,
+                 ei.entry_label, always_logging, compress));
 }
 
 
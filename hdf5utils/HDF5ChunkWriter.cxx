@@ -0,0 +1,185 @@
+/* ------------------------------------------------------------------   */
+/*      item            : HDF5ChunkWriter.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define HDF5ChunkWriter_cxx
+#include "HDF5ChunkWriter.hxx"
+#include <debug.h>
+
+#define DEBPRINTLEVEL -1
+#include <debprint.h>
+
+STARTHDF5LOG;
+
+HDF5ChunkWriter::Disposable::~Disposable()
+{ }
+
+HDF5ChunkWriter::library_lock_t HDF5ChunkWriter::libraryLock()
+{
+  // one lock for the HDF5 library, shared by all writers and loggers
+  static std::recursive_mutex library;
+  return library_lock_t(library);
+}
+
+HDF5ChunkWriter::HDF5ChunkWriter() :
+  pool(),
+  jobs(),
+  stop(false),
+  failure(),
+  lock(),
+  work(),
+  writer()
+{
+  writer = std::thread(&HDF5ChunkWriter::run, this);
+}
+
+HDF5ChunkWriter::~HDF5ChunkWriter()
+{
+  {
+    std::unique_lock<std::mutex> l(lock);
+    stop = true;
+  }
+  work.notify_one();
+  writer.join();
+
+  if (failure.size()) {
+    /* DUECA hdf5.
+
+       Writing a chunk of data to the HDF5 file failed, and this could
+       not be reported earlier. Check disk space and the file system. */
+    E_XTR("HDF5 chunk write failure not reported: " << failure);
+  }
+  for (auto &sz: pool) {
+    for (auto b: sz.second) { delete[] b; }
+  }
+}
+
+char* HDF5ChunkWriter::getBuffer(size_t size)
+{
+  std::unique_lock<std::mutex> l(lock);
+  auto &spares = pool[size];
+  if (spares.size()) {
+    char* buf = spares.back();
+    spares.pop_back();
+    return buf;
+  }
+  return new char[size];
+}
+
+void HDF5ChunkWriter::returnBuffer(char* data, size_t size)
+{
+  std::unique_lock<std::mutex> l(lock);
+  pool[size].push_back(data);
+}
+
+void HDF5ChunkWriter::queue(const Job& j)
+{
+  std::unique_lock<std::mutex> l(lock);
+  const bool wake = jobs.empty();
+  jobs.push_back(j);
+  l.unlock();
+
+  if (wake) work.notify_one();
+}
+
+void HDF5ChunkWriter::write(H5::DataSet* dset, const H5::DataType* datatype,
+                            hsize_t row, hsize_t nrows, hsize_t ncols,
+                            char* data, size_t size)
+{
+  {
+    std::unique_lock<std::mutex> l(lock);
+    if (failure.size()) {
+      std::string msg;
+      msg.swap(failure);
+      pool[size].push_back(data);
+      throw H5::DataSetIException("HDF5ChunkWriter::write", msg);
+    }
+  }
+  Job j;
+  j.dset = dset; j.datatype = datatype;
+  j.row = row; j.nrows = nrows; j.ncols = ncols;
+  j.data = data; j.size = size;
+  queue(j);
+}
+
+void HDF5ChunkWriter::dispose(Disposable* d)
+{
+  Job j;
+  j.dset = NULL; j.datatype = NULL;
+  j.row = 0; j.nrows = 0; j.ncols = 0;
+  j.disposable = d; j.size = 0;
+  queue(j);
+}
+
+void HDF5ChunkWriter::writeChunk(const Job& j)
+{
+  H5::Exception::dontPrint();
+
+  // extend the dataset to include these rows
+  hsize_t newsize[2] = { j.row + j.nrows, j.ncols };
+  j.dset->extend(newsize);
+
+  // select the rows in the file, and write the complete chunk
+  const int ndims = j.ncols == 1 ? 1 : 2;
+  hsize_t offset[2] = { j.row, 0 };
+  hsize_t count[2] = { j.nrows, j.ncols };
+  H5::DataSpace filspace = j.dset->getSpace();
+  filspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+  H5::DataSpace memspace(ndims, count);
+  j.dset->write(j.data, *j.datatype, memspace, filspace);
+}
+
+void HDF5ChunkWriter::run()
+{
+  std::deque<Job> todo;
+
+  std::unique_lock<std::mutex> l(lock);
+  while (true) {
+    work.wait(l, [this]{ return stop || !jobs.empty(); });
+    if (jobs.empty()) break;
+
+    // take all current work, write without holding the job lock
+    todo.swap(jobs);
+    l.unlock();
+
+    for (const auto &j: todo) {
+
+      // lock per job, so the logging activity is not held up long
+      library_lock_t ll = libraryLock();
+      if (j.dset) {
+        try {
+          DEB("HDF5ChunkWriter, " << j.nrows << " rows at " << j.row);
+          writeChunk(j);
+        }
+        catch (const H5::Exception& e) {
+          std::unique_lock<std::mutex> f(lock);
+          if (failure.empty()) {
+            failure = e.getDetailMsg();
+          }
+        }
+      }
+      else {
+        delete j.disposable;
+      }
+    }
+
+    // recycle the buffers
+    l.lock();
+    for (const auto &j: todo) {
+      if (j.dset) {
+        pool[j.size].push_back(j.data);
+      }
+    }
+    todo.clear();
+  }
+}
+
+ENDHDF5LOG;
@@ -0,0 +1,172 @@
+/* ------------------------------------------------------------------   */
+/*      item            : HDF5ChunkWriter.hxx
+        made by         : Rene van Paassen
+        date            : 261017
+        category        : header file
+        api             : DUECA_API
+        description     : Asynchronous writing of HDF5 data chunks
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#ifndef HDF5ChunkWriter_hxx
+#define HDF5ChunkWriter_hxx
+
+#include "HdfLogNamespace.hxx"
+#include <H5Cpp.h>
+#include <string>
+#include <deque>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+STARTHDF5LOG;
+
+/** Asynchronous writer for chunks of HDF5 datasets.
+
+    Normally, the HDF5DCOWriteFunctor objects write each data row to
+    the HDF5 file directly, in the logging activity. With compressed
+    datasets, and when the HDF5 library flushes its chunk cache, this
+    may take considerable time.
+
+    With a chunk writer, the write functors copy the rows of datasets
+    with a fixed-size datatype into chunk buffers, with the size of a
+    dataset chunk. Full chunk buffers are passed to the writer thread,
+    which extends the dataset, and compresses and writes the chunk
+    with a single call, while the functor continues with a fresh
+    buffer from the pool.
+
+    Since the HDF5 library cannot be assumed to be thread-safe, all
+    other calls to the HDF5 library, e.g., for variable-size data,
+    creating datasets and opening files, must be made while holding
+    the library lock, see libraryLock(). The lock is process-wide,
+    since loggers with their own writer threads share the library.
+
+    Write errors are detected in the writer thread, and reported
+    with an H5::DataSetIException at the next write() call.
+*/
+class HDF5ChunkWriter
+{
+public:
+  /** Lock type for the HDF5 library access */
+  typedef std::unique_lock<std::recursive_mutex> library_lock_t;
+
+  /** Base class for objects that need to be cleaned up in the writer
+      thread, after all their chunks have been written. The
+      destructor is called with the library lock held. */
+  struct Disposable
+  {
+    /** Destructor */
+    virtual ~Disposable();
+  };
+
+private:
+  /** A single write job */
+  struct Job {
+    /** Dataset to write to, NULL for disposal */
+    H5::DataSet                                      *dset;
+    /** Datatype in memory */
+    const H5::DataType                               *datatype;
+    /** First row in the dataset */
+    hsize_t                                           row;
+    /** Number of rows */
+    hsize_t                                           nrows;
+    /** Number of columns */
+    hsize_t                                           ncols;
+    /** Chunk data, or object to dispose */
+    union {
+      char                                           *data;
+      Disposable                                     *disposable;
+    };
+    /** Size of the data buffer */
+    size_t                                            size;
+  };
+
+  /** Spare buffers, by size */
+  std::map<size_t,std::vector<char*> >                pool;
+
+  /** Jobs waiting for the writer thread */
+  std::deque<Job>                                     jobs;
+
+  /** Stop flag for the writer thread */
+  bool                                                stop;
+
+  /** Message of a failed write, empty if none */
+  std::string                                         failure;
+
+  /** Protection of jobs, pool and flags */
+  std::mutex                                          lock;
+
+  /** Wakes the writer thread */
+  std::condition_variable                             work;
+
+  /** Writer thread */
+  std::thread                                         writer;
+
+  /** Writer thread function */
+  void run();
+
+  /** Write a single chunk, library lock must be held */
+  void writeChunk(const Job& j);
+
+  /** Add a job to the queue */
+  void queue(const Job& j);
+
+public:
+  /** Constructor, starts the writer thread */
+  HDF5ChunkWriter();
+
+  /** Destructor, completes all writes and disposals */
+  ~HDF5ChunkWriter();
+
+  /** Get a chunk buffer.
+
+      @param size    Size in bytes.
+      @returns       Buffer, from the pool if possible.
+  */
+  char* getBuffer(size_t size);
+
+  /** Return an unused chunk buffer to the pool.
+
+      @param data    Buffer, obtained with getBuffer.
+      @param size    Size in bytes.
+  */
+  void returnBuffer(char* data, size_t size);
+
+  /** Write a chunk. The dataset is extended to fit the rows, and the
+      buffer is taken over, and returned to the pool after writing.
+
+      @param dset    Dataset, needs to remain valid until written;
+                     use dispose() to clean up.
+      @param datatype Datatype of the buffered data.
+      @param row     First row to write.
+      @param nrows   Number of rows.
+      @param ncols   Number of columns; one for a 1D dataset.
+      @param data    Buffer with nrows*ncols elements.
+      @param size    Size of the buffer.
+  */
+  void write(H5::DataSet* dset, const H5::DataType* datatype,
+             hsize_t row, hsize_t nrows, hsize_t ncols,
+             char* data, size_t size);
+
+  /** Dispose of an object, after completing all preceding writes.
+
+      @param d       Object to delete in the writer thread.
+  */
+  void dispose(Disposable* d);
+
+  /** Lock access to the HDF5 library, for all threads in the
+      process.
+
+      @returns       Lock on the library.
+  */
+  static library_lock_t libraryLock();
+};
+
+ENDHDF5LOG;
+
+#endif
@@ -17,6 +17,7 @@
 //#define I_XTR
 #include <debug.h>
 #include <algorithm>
+#include <cstring>
 
 STARTHDF5LOG;
 
@@ -32,6 +33,7 @@ HDF5DCOWriteFunctor(std::weak_ptr<H5::H5File>& file,
   compress(compress),
   chunksize(chunksize),
   chunkidx(0),
+  writer(NULL),
   sets(writeticks ? nelts+1 : nelts),
   basepath(path)
 {
@@ -58,14 +60,77 @@ HDF5DCOWriteFunctor(std::weak_ptr<H5::H5File>& file,
   }
 }
 
+struct HDF5DCOWriteFunctor::DisposeSets: public HDF5ChunkWriter::Disposable
+{
+  /** Data sets, written up to the final size */
+  std::vector<LogDataSet> sets;
+
+  /** Final size of the data sets */
+  unsigned finalsize;
+
+  /** Destructor, runs in the chunk writer, finalizes the file size */
+  ~DisposeSets()
+  {
+    try {
+      for (unsigned idx = sets.size(); idx--; ) {
+        sets[idx].finalize(finalsize);
+      }
+    }
+    catch (const H5::Exception&) {
+      // already reported in finalize
+    }
+  }
+};
+
 HDF5DCOWriteFunctor::~HDF5DCOWriteFunctor()
 {
+  if (writer) {
+
+    // hand over the last, partially filled, chunks
+    const size_t start = chunkidx ? (chunkidx - 1) / chunksize * chunksize : 0;
+    for (auto &s: sets) {
+      if (s.buffer == NULL) continue;
+      char* buf = s.buffer;
+      s.buffer = NULL;
+      if (chunkidx == 0) {
+        writer->returnBuffer(buf, s.rowsize * chunksize);
+        continue;
+      }
+      try {
+        writer->write(&s.dset, s.datatype, start, chunkidx - start, s.ncols,
+                      buf, s.rowsize * chunksize);
+      }
+      catch (const H5::Exception& e) {
+        std::cerr << "Trying to write final chunk for " << basepath
+                  << ", got " << e.getDetailMsg() << std::endl;
+      }
+    }
+
+    // the data sets are finalized and closed after the last writes
+    DisposeSets *d = new DisposeSets();
+    d->sets.swap(sets);
+    d->finalsize = chunkidx;
+    writer->dispose(d);
+    return;
+  }
+
   // finalize the file size
   for (unsigned idx = sets.size(); idx--; ) {
     sets[idx].finalize(chunkidx);
   }
 }
 
+void HDF5DCOWriteFunctor::setAsyncWriter(HDF5ChunkWriter* w)
+{
+  writer = w;
+  for (auto &s: sets) {
+    s.writer = w;
+    if (w && s.datatype != NULL && s.fixedsize) {
+      s.buffer = w->getBuffer(s.rowsize * chunksize);
+    }
+  }
+}
+
 H5::Group HDF5DCOWriteFunctor::createPath(const std::string& path)
 {
   try {
@@ -80,7 +145,7 @@ H5::Group HDF5DCOWriteFunctor::createPath(const std::string& path)
     // path does not exist. is there a subpath?
     size_t idxs = path.rfind("/");
 
-    if (idxs != 0) {
+    if (idxs != 0 && idxs != std::string::npos) {
       // parent path found recursively call to check
       createPath(path.substr(0, idxs));
     }
@@ -109,7 +174,7 @@ static bool isFixedSize(const H5::DataType& datatype);
 static bool isFixedSize(const H5::CompType& datatype)
 {
   for (int ii = datatype.getNmembers(); ii--; ) {
-    if (isFixedSize(datatype.getMemberDataType(ii))) return false;
+    if (!isFixedSize(datatype.getMemberDataType(ii))) return false;
   }
   return true;
 }
@@ -229,6 +294,8 @@ configureDataSet(unsigned idx,
 
     sets[idx].ncols = ncols;
     sets[idx].offset = offset;
+    sets[idx].rowsize = ncols * dsize;
+    sets[idx].fixedsize = isFixedSize(*datatype);
   }
   catch(const H5::Exception& e) {
     std::cerr << "Trying to configure dataset " << name
@@ -238,12 +305,27 @@ configureDataSet(unsigned idx,
 }
 
 HDF5DCOWriteFunctor::LogDataSet::LogDataSet() :
-  ncols(1), datatype(NULL), offset(0)
+  ncols(1), datatype(NULL), offset(0), rowsize(0), fixedsize(false),
+  writer(NULL), buffer(NULL), bufrow(0)
 { dspace_dims[0] = 1; dspace_dims[1] = 1; }
 
 void HDF5DCOWriteFunctor::LogDataSet::prepareRow(unsigned chunkidx,
                                                  unsigned chunksize, bool flush)
 {
+  if (buffer) {
+
+    // pass a full chunk to the writer, continue with a fresh buffer
+    if (flush) {
+      char* full = buffer;
+      buffer = writer->getBuffer(rowsize * chunksize);
+      writer->write(&dset, datatype, chunkidx - chunksize, chunksize, ncols,
+                    full, rowsize * chunksize);
+    }
+    bufrow = chunkidx % chunksize;
+    return;
+  }
+
+  HDF5ChunkWriter::library_lock_t l = HDF5ChunkWriter::libraryLock();
   try {
     H5::Exception::dontPrint();
 
@@ -303,6 +385,11 @@ void HDF5DCOWriteFunctor::LogDataSet::writeNew(const void* data)
 {
   if (datatype == NULL) return;
   union {const void* ptr; const char* data;} conv; conv.ptr = data;
+  if (buffer) {
+    std::memcpy(&buffer[bufrow * rowsize], &conv.data[offset], rowsize);
+    return;
+  }
+  HDF5ChunkWriter::library_lock_t l = HDF5ChunkWriter::libraryLock();
   try {
     H5::Exception::dontPrint();
     dset.write(&conv.data[offset], *datatype, memspace, filspace);
@@ -320,6 +407,7 @@ writeNew(const void* data, hsize_t chunkidx,
 {
   union {const char* ptr; const std::string* val;} conv;
   conv.ptr = reinterpret_cast<const char*>(data)+offset;
+  HDF5ChunkWriter::library_lock_t l = HDF5ChunkWriter::libraryLock();
   try {
     H5::Exception::dontPrint();
     dset.write(conv.val, *datatype, memspace, filspace);
@@ -17,6 +17,7 @@
 #define HDF5DCOWriteFunctor_hxx
 
 #include "HdfLogNamespace.hxx"
+#include "HDF5ChunkWriter.hxx"
 #include <DCOFunctor.hxx>
 #include <DataTimeSpec.hxx>
 #include <H5Cpp.h>
@@ -52,6 +53,11 @@ USING_DUECA_NS;
     Due to this structure, DCO classes can be nested in (containers of)
     other DCO classes only if they are fixed-size. For this they need
     code generation with the hdf5nest option.
+
+    With an HDF5ChunkWriter (setAsyncWriter), the rows for datasets
+    with a fixed-size datatype are copied into chunk buffers, and the
+    chunks are written by the writer's thread. Datasets with variable
+    size data are still written directly.
 */
 class HDF5DCOWriteFunctor: public DCOFunctor
 {
@@ -74,6 +80,9 @@ protected:
   /** Index in the chunk sets */
   size_t                      chunkidx;
 
+  /** Writer for buffered chunks, NULL when writing directly */
+  HDF5ChunkWriter            *writer;
+
 protected:
   /** Organize data per element */
   struct LogDataSet {
@@ -100,6 +109,21 @@ protected:
     /** Offset in the DCO object */
     unsigned                  offset;
 
+    /** Size of a row in memory, in bytes */
+    size_t                    rowsize;
+
+    /** Fixed-size datatype, can be buffered */
+    bool                      fixedsize;
+
+    /** Writer for buffered chunks, or NULL */
+    HDF5ChunkWriter          *writer;
+
+    /** Chunk buffer, if buffered */
+    char                     *buffer;
+
+    /** Current row in the chunk buffer */
+    size_t                    bufrow;
+
     /** Default constructor. */
     LogDataSet();
 
@@ -117,6 +141,8 @@ protected:
       union {const char* ptr;
         const dueca::fixvector<N,std::string>* val;} conv;
       conv.ptr = reinterpret_cast<const char*>(data)+offset;
+      HDF5ChunkWriter::library_lock_t l =
+        HDF5ChunkWriter::libraryLock();
       hsize_t ddims[2] = { 1, 1 };
       H5::DataSpace dataspace(H5S_SCALAR);
       for (hsize_t ii = ncols; ii--; ) {
@@ -147,6 +173,8 @@ protected:
            ii != conv.val->end(); ii++) {
         varlen.data[idx++] = ii->c_str();
       }
+      HDF5ChunkWriter::library_lock_t l =
+        HDF5ChunkWriter::libraryLock();
       dset.write(&varlen, *datatype, memspace, filspace);
     }
 
@@ -170,6 +198,8 @@ protected:
       for (const auto& vals: *conv.val) {
 	cpointers[idx++] = vals;
       }
+      HDF5ChunkWriter::library_lock_t l =
+        HDF5ChunkWriter::libraryLock();
       dset.write(&varlen, *datatype, memspace, filspace);
     }
 
@@ -195,6 +225,8 @@ protected:
            ii != conv.val->end(); ii++) {
         cpointers[idx++] = *ii;
       }
+      HDF5ChunkWriter::library_lock_t l =
+        HDF5ChunkWriter::libraryLock();
       dset.write(&varlen, *datatype, memspace, filspace);
     }
 
@@ -211,7 +243,7 @@ protected:
       this->writeNew(data);
     }
 
-    /** Write data */
+    /** Write data, or copy into the chunk buffer */
     void writeNew(const void* data);
 
     /** Flush the last bit */
@@ -221,6 +253,9 @@ protected:
   /** One set per element */
   std::vector<LogDataSet> sets;
 
+  /** Data sets handed to the chunk writer, finalized there */
+  struct DisposeSets;
+
   /** Base path for writing the data; under this a set of 1 + 2d
       vectors will be defined. */
   std::string             basepath;
@@ -248,6 +283,14 @@ protected:
 public:
   /** Destructor */
   virtual ~HDF5DCOWriteFunctor();
+
+  /** Write through an asynchronous chunk writer. Call directly after
+      creating the functor, with the library lock held.
+
+      @param w     Chunk writer, needs to remain valid until after
+                   this functor has been deleted.
+  */
+  virtual void setAsyncWriter(HDF5ChunkWriter* w);
 };
 
 ENDHDF5LOG;
@@ -90,6 +90,13 @@ const ParameterTable *HDF5Logger::getMyParameterTable()
       "Log compressed data sets; reduces file size and may increase\n"
       "computation time. In effect for all following entries." },
 
+    { "async-write",
+      new VarProbe<_ThisModule_, bool>(&_ThisModule_::async_write),
+      "Buffer chunks of fixed-size data, and extend, compress and write\n"
+      "these in a separate writer thread, so the logging activity only\n"
+      "copies data. Variable-size data is still written directly.\n"
+      "Default off." },
+
     { "reduction",
       new MemberCall<_ThisModule_, TimeSpec>(&_ThisModule_::setReduction),
       "Reduce the logging data rate according to the given time\n"
@@ -148,6 +155,8 @@ HDF5Logger::HDF5Logger(Entity *e, const char *part, const PrioritySpec &ps) :
   access_proplist(),
   chunksize(500),
   compress(false),
+  async_write(false),
+  chunkwriter(),
   lftemplate("datalog-%Y%m%d_%H%M%S.hdf5"),
   always_logging(false),
   immediate_start(false),
@@ -204,6 +213,10 @@ bool HDF5Logger::complete()
                              << rdcc_w0);
   access_proplist.setStdio();
 
+  if (async_write) {
+    chunkwriter.reset(new HDF5ChunkWriter());
+  }
+
   if (r_config) {
     // wait for hdf file name or start command
     /* DUECA hdf5.
@@ -341,9 +354,9 @@ void HDF5Logger::TargetedLog::createFunctor(std::weak_ptr<H5::H5File> nfile,
     std::weak_ptr<HDF5DCOMetaFunctor> metafunctor(
       r_token.getMetaFunctor<HDF5DCOMetaFunctor>("hdf5"));
 
-    functor.reset(metafunctor.lock()->getWriteFunctor(
-      nfile, prefix + logpath, chunksize, ei.entry_label,
-      master->getOpTime(always_logging), compress));
+    functor.reset(master->createWriteFunctor(
+      metafunctor, nfile, prefix + logpath, chunksize, ei.entry_label,
+      always_logging, compress));
   }
   catch (const std::exception &e) {
     /* DUECA hdf5.
@@ -400,6 +413,22 @@ HDF5Logger::TargetedLog::~TargetedLog()
   //
 }
 
+HDF5DCOWriteFunctor *
+HDF5Logger::createWriteFunctor(std::weak_ptr<HDF5DCOMetaFunctor> metafunctor,
+                               std::weak_ptr<H5::H5File> nfile,
+                               const std::string &path, unsigned chunksize,
+                               const std::string &label, bool always_logging,
+                               bool compress) const
+{
+  HDF5ChunkWriter::library_lock_t l = lockLibrary();
+  HDF5DCOWriteFunctor *functor = metafunctor.lock()->getWriteFunctor(
+    nfile, path, chunksize, label, getOpTime(always_logging), compress);
+  if (chunkwriter) {
+    functor->setAsyncWriter(chunkwriter.get());
+  }
+  return functor;
+}
+
 bool HDF5Logger::logChannel(const vector<string> &i)
 {
   targeted_list_t::value_type newtarget;
@@ -613,6 +642,8 @@ void HDF5Logger::doCalculation(const TimeSpec &ts)
   // events with new instructions
   if (r_config && r_config->getNumVisibleSets(ts.getValidityStart())) {
 
+    // file and functor changes, keep the chunk writer out
+    HDF5ChunkWriter::library_lock_t l = lockLibrary();
     DataReader<DUECALogConfig> cnf(*r_config, ts);
     std::shared_ptr<H5::H5File> nfile;
     std::string filename = FormatTime(
@@ -769,6 +800,7 @@ void HDF5Logger::sendStatus(const std::string &msg, bool error,
                             TimeTickType moment)
 {
   if (w_status) {
+    HDF5ChunkWriter::library_lock_t l = lockLibrary();
     if (w_status->isValid()) {
       while (statusstack.size()) {
         DataWriter<DUECALogStatus> sts(*w_status, statusstack.front().first);
@@ -35,6 +35,7 @@
 #include "HdfLogNamespace.hxx"
 #include "HDF5DCOWriteFunctor.hxx"
 #include "HDF5DCOMetaFunctor.hxx"
+#include "HDF5ChunkWriter.hxx"
 #include <list>
 #include <string>
 #include <memory>
@@ -91,6 +92,12 @@ private: // simulation data
   // compress datasets
   bool compress;
 
+  // write chunks in a separate thread
+  bool async_write;
+
+  // writer for chunks, destroyed after the log functors
+  boost::scoped_ptr<HDF5ChunkWriter> chunkwriter;
+
   // filename template
   std::string lftemplate;
 
@@ -293,6 +300,17 @@ private: // the member functions that are called for activities
   /** access the file object */
   inline std::weak_ptr<H5::H5File> getFile() const { return hfile; }
 
+  /** lock the HDF5 library against the chunk writers */
+  inline HDF5ChunkWriter::library_lock_t lockLibrary() const
+  { return HDF5ChunkWriter::libraryLock(); }
+
+  /** create a write functor, writing through the chunk writer if used */
+  HDF5DCOWriteFunctor*
+  createWriteFunctor(std::weak_ptr<HDF5DCOMetaFunctor> metafunctor,
+                     std::weak_ptr<H5::H5File> nfile, const std::string &path,
+                     unsigned chunksize, const std::string &label,
+                     bool always_logging, bool compress) const;
+
   /** get the chunk size */
   inline unsigned getChunkSize() const { return chunksize; }
 
@@ -190,7 +190,7 @@ namespace %(name)s_space {
                         const dueca::DataTimeSpec* startend);
 
     // the functor member used by channel reading code
-    bool operator() (const void* dpointer, const dueca::DataTimeSpec& ts);
+    bool operator() (const void* dpointer, const dueca::DataTimeSpec& ts);%(parentasync)s
   };
 
   // reads from file, writing to channel
@@ -210,6 +210,14 @@ namespace %(name)s_space {
 """ % joindict(
     { 'parentdecwrite' : (self.parent and """;
     %s_space::HDF5DCOWriteFunctor __parent__""" % self.parent) or "",
+      'parentasync' : (self.parent and """
+
+    // also pass the chunk writer to the parent's functor
+    void setAsyncWriter(dueca::hdf5log::HDF5ChunkWriter* w) override
+    {
+      dueca::hdf5log::HDF5DCOWriteFunctor::setAsyncWriter(w);
+      __parent__.setAsyncWriter(w);
+    }""") or "",
       'parentdecread' : (self.parent and """;
     %s_space::HDF5DCOReadFunctor __parent__""" % self.parent) or "" },
     self.__dict__))
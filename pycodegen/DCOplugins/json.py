@@ -0,0 +1,217 @@
+# AddOn for json option
+"""     item            : json.py
+        made by         : RvP
+        date            : 2026
+        category        : python program
+        description     : Code generation of DUECA Communication Objects (DCO)
+                          typed JSON and msgpack coding extension
+        language        : python
+        changes         : 261017 RvP first version
+        copyright       : (c) 2026 René van Paassen
+
+AddOn objects extend the code generation by the dueca-codegen program
+
+This file adds (Option json) to DCO files. It specializes the
+dueca::dco_typed_coder template for the DCO object, so that the object
+can be coded to JSON (or the msgpack variant of the websocket server)
+member by member, with the member types known at compile time, instead
+of through introspection. Metafunctors "tojson" and "tomsgpack" are
+added to the class' functor table; DCOtoJSONcompact, DCOtoJSONstrict
+and the websocket server use these when available, and fall back to
+introspection otherwise.
+
+The "tomsgpack" metafunctor is only added when compiling with
+DUECA_CONFIG_MSGPACK or DUECA_CONFIG_WEBSOCK defined; the pkg-config
+file of dueca-websock defines the latter.
+
+The parent class, if any, needs the json option too.
+"""
+
+from jinja2 import Environment, BaseLoader
+
+env = Environment(loader=BaseLoader)
+
+headercode_tmpl = """
+#ifndef __CUSTOM_TYPED_CODER_{{ name }}
+namespace dueca {
+{%- for m in members %}
+{%- if m.isEnum() and m.getMembers()|length != 0 and eclasses.firstSeen(m.getType()) %}
+
+/** Typed coding for enum {{ m.getType() }} */
+template <>
+struct dco_enum_coder<{{ m.getType() }}>
+{
+  template<class W>
+  static void code(W& w, const {{ m.getType() }}& v)
+  { w.String(getString(v)); }
+};
+{%- endif %}
+{%- endfor %}
+
+/** Typed coding for {{ name }} */
+template <>
+struct dco_typed_coder<{{ nsprefix }}{{ name }}>
+{
+  /** Number of members, including those of the parent */
+  {%- if parent %}
+  static constexpr unsigned n_members =
+    {{ members|length }}U + dco_typed_coder<{{ parent }}>::n_members;
+  {%- else %}
+  static constexpr unsigned n_members = {{ members|length }}U;
+  {%- endif %}
+
+  /** Code the object */
+  template<class W>
+  static void code(W& w, const {{ nsprefix }}{{ name }}& v)
+  {
+    w.StartObject(n_members);
+    code_members(w, v);
+    w.EndObject();
+  }
+
+  /** Code the members only */
+  template<class W>
+  static void code_members(W& w, const {{ nsprefix }}{{ name }}& v)
+  {
+    {%- if parent %}
+    dco_typed_coder<{{ parent }}>::code_members(w, v);
+    {%- endif %}
+    {%- for m in members %}
+    dco_code_member(w, "{{ m.getName() }}", v.{{ m.getName() }});
+    {%- endfor %}
+  }
+};
+
+} // namespace dueca
+#endif
+"""
+
+bodycode_tmpl = """
+#if !defined(__DCO_STANDALONE)
+namespace {{ name }}_space {
+  // loads the typed coding metafunctors in the table
+  static dueca::LoadMetaFunctor
+  <dueca::DCOJSONMetaFunctorImp<{{ nsprefix }}{{ name }}> >
+    load_functor_tojson({{ nsprefix }}functortable, "tojson");
+#if defined(DUECA_CONFIG_MSGPACK) || defined(DUECA_CONFIG_WEBSOCK)
+  static dueca::LoadMetaFunctor
+  <dueca::DCOMsgpackMetaFunctorImp<{{ nsprefix }}{{ name }}> >
+    load_functor_tomsgpack({{ nsprefix }}functortable, "tomsgpack");
+#endif
+} // end namespace {{ name }}_space
+#endif
+"""
+
+
+class CheckSeen:
+    """ Remember seen objects, return true on first occurrence
+    """
+
+    def __init__(self):
+        self.seen = set()
+
+    def firstSeen(self, s: str):
+        if s in self.seen:
+            return False
+        self.seen.add(s)
+        return True
+
+
+class AddOn(object):
+    """ Print typed JSON/msgpack coding code for a DCO object.
+
+    - include section of header (printHeaderInclude)
+    - in class definition, at end, but just before extra include
+      (printHeaderClassCode)
+    - in header, outside class (printHeaderCode)
+    - include in body file (printBodyInclude)
+    - in the body file, in a check section executed when custom body
+      code is included (printBodyCheck)
+    - in the body (printBodyCode)
+
+    """
+
+    def __init__(self, namespace, name, parent, members, nest=False):
+        """ Initialisation of an AddOn object
+
+        namespace -  name space of the DCO object
+        name      -  class name of DCO object
+        parent    -  parent class name
+        members   -  list with MemberSummary objects describing data members
+        """
+
+        self.namespace = namespace
+        self.nsprefix = (namespace and namespace+'::') or ''
+        self.name = name
+        self.parent = parent
+        self.members = members
+        self.dueca_typed_coder_version = 1
+
+    def printHeaderInclude(self):
+        """ print the lines that will be added to the header's include area
+        """
+        return """
+#include <dueca/DCOTypedCoding.hxx>"""
+
+    def printBodyInclude(self):
+        """ print the lines that will be added to the body's include area
+        """
+        return """
+#include <dueca/DCOtoJSON.hxx>
+#if defined(DUECA_CONFIG_MSGPACK) || defined(DUECA_CONFIG_WEBSOCK)
+#include <dueca/DCOtoMsgpack.hxx>
+#endif"""
+
+    def printBodyCheck(self):
+        """print the lines *after* a possible include of custom body code to
+        check that any custom-built typed coding code is compatible with
+        the version it was designed for.
+        """
+
+        return r"""
+# define DUECA_TYPED_CODER_CODEGEN_VERSION {version}
+# if defined({customdefines})
+# ifndef __CUSTOM_COMPATLEVEL_TYPED_CODER_{version}
+# error "Verify custom typed coder compatibility with version {version}.\
+ Then define __CUSTOM_COMPATLEVEL_TYPED_CODER_{version}"
+# endif
+# endif
+""".format(version=self.dueca_typed_coder_version,
+           customdefines=r""") || \
+    defined(""".join(self.getCustomDefines()))
+
+    def printHeaderClassCode(self):
+        """code that will be inserted in the definition of the class. Assumes
+        public, and inserted at the end"""
+
+        return ""
+
+    def printHeaderCode(self):
+        """code that will be inserted in the header after the class
+        definition. Starts outside any namespace directive.
+        """
+        return env.from_string(headercode_tmpl).render(
+            eclasses=CheckSeen(),
+            members=self.members,
+            name=self.name,
+            parent=self.parent,
+            nsprefix=self.nsprefix
+        )
+
+    def printBodyCode(self):
+        """code that is inserted in the body file. After all regular
+        code, assumes global namespace"""
+
+        return env.from_string(bodycode_tmpl).render(
+            nsprefix=self.nsprefix,
+            name=self.name
+        )
+
+    def getCustomDefines(self):
+        """these defines guard the implementation in the header, and can be
+        used to override the standard implementation. When overridden,
+        define __CUSTOM_COMPATLEVEL_TYPED_CODER_# to indicate
+        compatibility with a specific version of the code.
+        """
+
+        return [f'__CUSTOM_TYPED_CODER_{self.name}']
@@ -2243,6 +2243,44 @@ const dueca::ParameterTable* %(name)s::getParameterTable()
             [ r.enumTraits(self.name, self.objprefix) for r in iter(self.types.values())
               if r.enumTraits(self.name, self.objprefix) ])
 
+        # raw copy trait, objects can be copied as memory when all
+        # members can. Not for derived classes, or classes with
+        # custom code, since that might add data
+        if self.parent or self.include:
+            self.rawcopytrait = ''
+        else:
+            self.rawcopytrait = '''
+/** Template specialization, defines whether %(name)s can be copied
+    as raw memory. */
+template <>
+struct dco_rawcopy<%(objprefix)s%(name)s> :
+  public std::integral_constant<bool,
+    %(check)s> { };''' % dict(
+      name=self.name, objprefix=self.objprefix,
+      check=' &&\n    '.join(
+          [ 'dco_rawcopy<decltype(%s%s::%s)>::value' %
+            (self.objprefix, self.name, r.name)
+            for r in self.members ]) or 'true')
+
+        # packed size trait, objects of which all members have a
+        # fixed packed size can be packed in a single block. Same
+        # restrictions as for the raw copy
+        self.fixedpack = bool(self.rawcopytrait and self.members)
+        self.packsizetrait = ''
+        if self.fixedpack:
+            self.packsizetrait = '''
+
+/** Template specialization, gives the packed size of %(name)s, or 0
+    if that is not fixed. */
+template <>
+struct dco_packsize<%(objprefix)s%(name)s> :
+  public dco_packsize_all<
+    %(members)s> { };''' % dict(
+      name=self.name, objprefix=self.objprefix,
+      members=',\n    '.join(
+          [ 'decltype(%s%s::%s)' % (self.objprefix, self.name, r.name)
+            for r in self.members ]))
+
         # access objects to get the relative addresses and names of members
         self.accessstatics = ''.join(
             [r.staticAccessObject() for r in self.members
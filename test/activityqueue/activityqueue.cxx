@@ -0,0 +1,129 @@
+// compare the ordered list used for scheduling in ActivityManager with
+// the ActivityHeap alternative; checks that both give the same order,
+// and times insertion+removal at different queue sizes
+
+#include <ActivityHeap.hxx>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <cassert>
+#include <cstdint>
+
+using namespace std;
+using namespace dueca;
+
+const int time_weight = 100;
+const unsigned NCYCLES = 200000;
+
+// mimics ActivityItem, with order, time and list links
+struct MyItem
+{
+  int order;
+  uint32_t tick;
+  unsigned id;
+  MyItem *prev;
+  MyItem *next;
+
+  MyItem(int order = 0, uint32_t tick = 0, unsigned id = 0) :
+    order(order), tick(tick), id(id), prev(NULL), next(NULL) { }
+
+  // same comparison as ActivityItem::operator<
+  bool operator < (const MyItem& other) const
+  {
+    if (tick > other.tick)
+      return (order - other.order - time_weight*int(tick - other.tick)) < 0;
+    return (order - other.order + time_weight*int(other.tick - tick)) < 0;
+  }
+};
+
+struct MyItemPtrLess
+{
+  bool operator() (const MyItem* a, const MyItem* b) const
+  { return *a < *b; }
+};
+
+// list with sentinels, insertion as in ActivityManager::schedule
+struct MyList
+{
+  MyItem head, tail;
+  MyList() { head.next = &tail; tail.prev = &head; }
+  bool empty() const { return head.next == &tail; }
+  void push(MyItem* item)
+  {
+    MyItem *tmp = tail.prev;
+    while (tmp != &head && *tmp < *item) tmp = tmp->prev;
+    item->prev = tmp; item->next = tmp->next;
+    tmp->next->prev = item; tmp->next = item;
+  }
+  MyItem* pop()
+  {
+    MyItem* res = head.next;
+    head.next = res->next; res->next->prev = &head;
+    return res;
+  }
+};
+
+typedef ActivityHeap<MyItem*,MyItemPtrLess> MyHeap;
+
+// random item stream; orders from a small set, ticks advancing once
+// every "burst" items
+static void makeItems(vector<MyItem>& items, unsigned seed, unsigned burst)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> order(-100, 100);
+  std::uniform_int_distribution<unsigned> step(0, burst - 1);
+  uint32_t tick = 1000;
+  for (unsigned ii = 0; ii < items.size(); ii++) {
+    if (step(gen) == 0) tick += 10;
+    items[ii] = MyItem(order(gen), tick, ii);
+  }
+}
+
+template<class Q>
+static double runCycles(Q& q, vector<MyItem>& items, unsigned qsize,
+                        vector<unsigned>& popped)
+{
+  // fill up to the queue size, then pop one, push one
+  unsigned ii = 0;
+  for (; ii < qsize; ii++) q.push(&items[ii]);
+  auto t0 = chrono::steady_clock::now();
+  for (; ii < items.size(); ii++) {
+    popped.push_back(q.pop()->id);
+    q.push(&items[ii]);
+  }
+  auto t1 = chrono::steady_clock::now();
+  while (!q.empty()) popped.push_back(q.pop()->id);
+  return chrono::duration<double,nano>(t1 - t0).count() /
+    (items.size() - qsize);
+}
+
+int main()
+{
+  cout << setw(8) << "burst" << setw(8) << "queued" << setw(14) << "list ns/op"
+       << setw(14) << "heap ns/op" << endl;
+
+  for (unsigned burst: { 4U, 1000U })
+  for (unsigned qsize: { 10U, 100U, 1000U }) {
+    vector<MyItem> litems(qsize + NCYCLES), hitems(qsize + NCYCLES);
+    makeItems(litems, qsize, burst);
+    makeItems(hitems, qsize, burst);
+    vector<unsigned> lorder, horder;
+    lorder.reserve(litems.size()); horder.reserve(hitems.size());
+
+    MyList list;
+    MyHeap heap(qsize);
+    double tlist = runCycles(list, litems, qsize, lorder);
+    double theap = runCycles(heap, hitems, qsize, horder);
+
+    // the heap must give exactly the same order as the list
+    if (lorder != horder) {
+      cerr << "heap order differs from list at queue size " << qsize << endl;
+      return 1;
+    }
+    cout << setw(8) << burst << setw(8) << qsize << setw(14) << fixed << setprecision(1) << tlist
+         << setw(14) << theap << endl;
+  }
+  return 0;
+}
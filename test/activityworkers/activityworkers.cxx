@@ -0,0 +1,196 @@
+// test for an ActivityManager with multiple threads. Priority level 1
+// gets three threads, through the "priority-workers" setting, and
+// DUECA starts these in its normal start-up. A number of activities
+// is triggered many times; the activities must run in parallel, but
+// each activation of an activity must run after the previous one of
+// that activity has completed, and in the order of triggering.
+
+#include <dueca/ObjectManager.hxx>
+#include <dueca/Environment.hxx>
+#include <dueca/PackerManager.hxx>
+#include <dueca/ChannelManager.hxx>
+#include <dueca/Ticker.hxx>
+#include <dueca/ScriptInterpret.hxx>
+#include <dueca/ScriptHelper.hxx>
+#include <dueca/GuiHandler.hxx>
+#include <dueca/ActivityManager.hxx>
+#include <dueca/Activity.hxx>
+#include <dueca/Callback.hxx>
+#include <dueca/Callback.ixx>
+#include <dueca/Trigger.hxx>
+#include <iostream>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <unistd.h>
+
+using namespace std;
+using namespace dueca;
+
+const unsigned NWORKERS = 3;
+const unsigned NACTIVITIES = 6;
+const unsigned NTRIGGERS = 200;
+
+// no script language; the interpreter goes through the start-up
+// stages, as the script would
+struct NoScript: public ScriptHelper
+{
+  NoScript() : ScriptHelper("", "", "", "") { }
+  void initiate() final { }
+  void interpreter() final;
+  bool readline(std::string& line) final { return false; }
+  bool writeline(const std::string& line) final { return true; }
+};
+
+// create the DUECA core objects, as dueca_cnf.py does, with two
+// priority levels, and multiple threads for level 1
+static void startDueca()
+{
+  static GuiHandler nogui(std::string("none"));
+  ScriptInterpret::single(new NoScript());
+  (new ObjectManager(0, 1))->complete();
+  Environment* env = new Environment();
+  env->setAMNice(vector<int>{ 0 });
+  env->setAMWorkers(vector<int>{ 1, NWORKERS });
+  env->complete();
+  (new PackerManager())->complete();
+  (new ChannelManager())->complete();
+  (new Ticker())->complete();
+}
+
+// triggering from the test
+struct TestTrigger: public TriggerPuller
+{
+  TestTrigger() : TriggerPuller("test trigger") { }
+  void fire(TimeTickType t) { pull(DataTimeSpec(t, t + 1)); }
+};
+
+// activities running at the same time
+static std::atomic<unsigned> nrunning(0);
+static std::atomic<unsigned> maxrunning(0);
+
+// threads that ran activities
+static std::mutex threads_lock;
+static std::set<std::thread::id> threads;
+
+// an activity, checks overlap and order of its own activations
+struct Counter
+{
+  std::atomic<bool> running;
+  TimeTickType last;
+  std::atomic<unsigned> count;
+  unsigned overlaps;
+  unsigned disorders;
+  Callback<Counter> cb;
+  ActivityCallback activity;
+
+  Counter(unsigned id, TestTrigger& trigger) :
+    running(false), last(0), count(0), overlaps(0), disorders(0),
+    cb(this, &Counter::run),
+    activity(getId(),
+             (std::string("counter ") + std::to_string(id)).c_str(),
+             &cb, PrioritySpec(1, 0))
+  {
+    activity.setTrigger(trigger);
+    activity.switchOn(0);
+  }
+
+  // the activities are owned by the object manager
+  const GlobalId& getId() const { return ObjectManager::single()->getId(); }
+
+  void run(const TimeSpec& ts)
+  {
+    if (running.exchange(true)) overlaps++;
+    if (count && ts.getValidityStart() <= last) disorders++;
+    last = ts.getValidityStart();
+    unsigned n = ++nrunning;
+    for (unsigned m = maxrunning; n > m && !maxrunning.compare_exchange_weak(m, n); ) { }
+    {
+      std::lock_guard<std::mutex> l(threads_lock);
+      threads.insert(std::this_thread::get_id());
+    }
+    usleep(200);
+    --nrunning;
+    count++;
+    running = false;
+  }
+};
+
+static TestTrigger* trigger = NULL;
+static vector<unique_ptr<Counter> > counters;
+
+// trigger the activities when the Environment has started the level 1
+// threads, and stop DUECA when all activations are done
+static void fireTriggers()
+{
+  Environment* env = Environment::getInstance();
+  for (int ii = 10000; ii-- && !env->runningMultiThread(); ) {
+    usleep(1000);
+  }
+  for (TimeTickType t = 1; t <= NTRIGGERS; t++) {
+    trigger->fire(t);
+    env->wakeActivityManager(1);
+    usleep(500);
+  }
+
+  // wait until all activations are done
+  bool complete = false;
+  for (int ii = 10000; ii-- && !complete; ) {
+    usleep(1000);
+    complete = true;
+    for (const auto& c: counters) {
+      complete = complete && c->count == NTRIGGERS && !c->running;
+    }
+  }
+  env->quit();
+}
+
+void NoScript::interpreter()
+{
+  // complete the DUECA objects, and create the activities, as the
+  // modules would be created
+  Environment::getInstance()->proceed(1);
+  trigger = new TestTrigger();
+  for (unsigned ii = 0; ii < NACTIVITIES; ii++) {
+    counters.emplace_back(new Counter(ii, *trigger));
+  }
+
+  // run; the Environment starts the threads, and this returns after
+  // the quit
+  std::thread firing(fireTriggers);
+  Environment::getInstance()->proceed(2);
+  firing.join();
+}
+
+int main(int argc, char* argv[])
+{
+  startDueca();
+  ScriptInterpret::single()->startScript();
+
+  unsigned errors = 0;
+  for (unsigned ii = 0; ii < NACTIVITIES; ii++) {
+    const Counter& c = *counters[ii];
+    if (c.count != NTRIGGERS || c.overlaps || c.disorders) {
+      cerr << "activity " << ii << " ran " << c.count << " times, "
+           << c.overlaps << " overlapping, " << c.disorders
+           << " out of order" << endl;
+      errors++;
+    }
+  }
+  if (threads.size() != NWORKERS || maxrunning < 2U) {
+    cerr << "activities ran on " << threads.size() << " threads, at most "
+         << maxrunning << " in parallel" << endl;
+    errors++;
+  }
+  cout << "Activities ran on " << threads.size() << " threads, at most "
+       << maxrunning << " in parallel" << endl;
+
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  return 0;
+}
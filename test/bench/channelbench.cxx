@@ -0,0 +1,270 @@
+// benchmark for channel communication. Drives ChannelWriteToken and
+// ChannelReadToken on a UnifiedChannel in a single process, with a
+// minimal DUECA environment (one node, no script, no gui).
+//
+// One operation is a write by the writer, followed by a read of that
+// data by each of the readers, all in this thread. Measured for stream
+// and event entries, 1..N readers, different object sizes, and
+// sequential (ReadAllData) or latest (JumpToMatchTime) reading.
+// Reports ns per operation, heap allocations (calls to the global
+// operator new, DCO objects from the arenas are not counted) per
+// operation, and the latency distribution of single operations.
+// With -c, stream entries keep a copy of the latest value for the
+// "latest" readers (Environment option latest-value-copy).
+//
+// usage: channelbench.x [-n operations] [-r max readers] [-c]
+
+#include <dueca/ObjectManager.hxx>
+#include <dueca/Environment.hxx>
+#include <dueca/PackerManager.hxx>
+#include <dueca/ChannelManager.hxx>
+#include <dueca/Ticker.hxx>
+#include <dueca/ScriptInterpret.hxx>
+#include <dueca/ScriptHelper.hxx>
+#include <dueca/GuiHandler.hxx>
+#include <dueca/ActivityManager.hxx>
+#include <dueca/ChannelWriteToken.hxx>
+#include <dueca/ChannelReadToken.hxx>
+#include <dueca/DataWriter.hxx>
+#include <dueca/DataReader.hxx>
+#include <dueca/UChannelEntry.hxx>
+#include "BenchSmall.hxx"
+#include "BenchMedium.hxx"
+#include "BenchLarge.hxx"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <unistd.h>
+
+using namespace std;
+using namespace dueca;
+
+// count all heap allocations; not inlined, to keep gcc from
+// flagging new/free mismatches
+static std::atomic<size_t> n_alloc(0);
+
+__attribute__((noinline)) void* operator new(size_t size)
+{
+  n_alloc.fetch_add(1, std::memory_order_relaxed);
+  void* p = std::malloc(size ? size : 1);
+  if (p == NULL) throw std::bad_alloc();
+  return p;
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{ std::free(p); }
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept
+{ std::free(p); }
+
+// no script language, the objects are created in startDueca
+struct NoScript: public ScriptHelper
+{
+  NoScript() : ScriptHelper("", "", "", "") { }
+  void initiate() final { }
+  void interpreter() final { }
+  bool readline(std::string& line) final { return false; }
+  bool writeline(const std::string& line) final { return true; }
+};
+
+// create the DUECA core objects, as dueca_cnf.py does for a single node
+static void startDueca()
+{
+  static GuiHandler nogui(std::string("none"));
+  ScriptInterpret::single(new NoScript());
+  (new ObjectManager(0, 1))->complete();
+  (new Environment())->complete();
+  (new PackerManager())->complete();
+  (new ChannelManager())->complete();
+  (new Ticker())->complete();
+
+  ObjectManager::single()->completeCreation();
+  ChannelManager::single()->completeCreation();
+  for (int prio = 0; prio <= ActivityManager::getMaxPrio(); prio++) {
+    Environment::getInstance()->getActivityManager(prio)->completeCreation();
+  }
+}
+
+// run the environment until the channel configuration has settled
+static void runUntilValid(ChannelWriteToken& w,
+                          vector<unique_ptr<ChannelReadToken> >& r)
+{
+  for (int ii = 1000; ii--; ) {
+    Environment::getInstance()->update();
+    bool valid = w.isValid();
+    for (auto &t: r) { valid = valid && t->isValid(); }
+    if (valid) return;
+    usleep(1000);
+  }
+  cerr << "tokens for " << w.getName() << " not valid" << endl;
+  std::exit(1);
+}
+
+struct Result
+{
+  double ns_op;
+  double allocs_op;
+  int64_t p50, p99, p999, pmax;
+  unsigned errors;
+};
+
+template<class T>
+static void writeOne(ChannelWriteToken& w, Channel::EntryTimeAspect aspect,
+                     TimeTickType tick, uint32_t seq)
+{
+  if (aspect == Channel::Continuous) {
+    DataWriter<T> dw(w, DataTimeSpec(tick, tick + 1));
+    dw.data().seq = seq;
+  }
+  else {
+    DataWriter<T> dw(w, tick);
+    dw.data().seq = seq;
+  }
+}
+
+template<class T>
+static bool readOne(ChannelReadToken& r, bool latest,
+                    TimeTickType tick, uint32_t seq)
+{
+  try {
+    if (latest) {
+      DataReader<T, MatchIntervalStartOrEarlier> dr(r);
+      return dr.data().seq == seq;
+    }
+    DataReader<T, MatchIntervalStart> dr(r, tick);
+    return dr.data().seq == seq;
+  }
+  catch (const NoDataAvailable& e) {
+    return false;
+  }
+}
+
+template<class T>
+static Result runScenario(Channel::EntryTimeAspect aspect, unsigned nreaders,
+                          bool latest, unsigned nops, unsigned& index)
+{
+  const GlobalId owner = ObjectManager::single()->getId();
+  const NameSet cname("bench", getclassname<T>(), index++);
+  ChannelWriteToken w(owner, cname, getclassname<T>(), "bench", aspect);
+  vector<unique_ptr<ChannelReadToken> > r;
+  for (unsigned ii = 0; ii < nreaders; ii++) {
+    r.emplace_back(new ChannelReadToken
+                   (owner, cname, getclassname<T>(), 0, aspect,
+                    Channel::OnlyOneEntry, latest ? Channel::JumpToMatchTime :
+                    Channel::ReadAllData));
+  }
+  runUntilValid(w, r);
+
+  Result res;
+  res.errors = 0;
+  TimeTickType tick = 1;
+  uint32_t seq = 0;
+  auto op = [&]() {
+    writeOne<T>(w, aspect, tick, seq);
+    for (auto &t: r) {
+      if (!readOne<T>(*t, latest, tick, seq)) res.errors++;
+    }
+    tick++; seq++;
+  };
+
+  // warm up, fills any caches and recycling rings
+  for (unsigned ii = nops / 10 + 10; ii--; ) op();
+
+  // throughput
+  size_t a0 = n_alloc.load();
+  auto t0 = chrono::steady_clock::now();
+  for (unsigned ii = nops; ii--; ) op();
+  auto t1 = chrono::steady_clock::now();
+  res.allocs_op = double(n_alloc.load() - a0) / nops;
+  res.ns_op = chrono::duration<double, std::nano>(t1 - t0).count() / nops;
+
+  // latency of individual operations
+  vector<int64_t> lat(nops);
+  for (unsigned ii = 0; ii < nops; ii++) {
+    auto ts = chrono::steady_clock::now();
+    op();
+    lat[ii] = chrono::duration_cast<chrono::nanoseconds>
+      (chrono::steady_clock::now() - ts).count();
+  }
+  sort(lat.begin(), lat.end());
+  res.p50 = lat[nops / 2];
+  res.p99 = lat[size_t(nops * 0.99)];
+  res.p999 = lat[size_t(nops * 0.999)];
+  res.pmax = lat.back();
+
+  // tokens are removed, let the channel process this
+  r.clear();
+  return res;
+}
+
+static unsigned total_errors = 0;
+
+template<class T>
+static void runClass(unsigned nops, unsigned maxreaders, unsigned& index)
+{
+  for (auto aspect: { Channel::Continuous, Channel::Events }) {
+    for (bool latest: { false, true }) {
+      for (unsigned nr = 1; nr <= maxreaders; nr *= 2) {
+        Result res = runScenario<T>(aspect, nr, latest, nops, index);
+        total_errors += res.errors;
+        cout << setw(6) << (aspect == Channel::Continuous ? "stream" : "event")
+             << ' ' << setw(12) << getclassname<T>()
+             << ' ' << setw(6) << sizeof(T)
+             << ' ' << setw(3) << nr
+             << ' ' << setw(10) << (latest ? "latest" : "sequential")
+             << fixed << setprecision(1)
+             << ' ' << setw(9) << res.ns_op
+             << setprecision(2)
+             << ' ' << setw(8) << res.allocs_op
+             << ' ' << setw(8) << res.p50
+             << ' ' << setw(8) << res.p99
+             << ' ' << setw(8) << res.p999
+             << ' ' << setw(9) << res.pmax;
+        if (res.errors) cout << "  read errors " << res.errors;
+        cout << endl;
+      }
+    }
+  }
+  for (int ii = 10; ii--; ) Environment::getInstance()->update();
+}
+
+int main(int argc, char* argv[])
+{
+  unsigned nops = 100000;
+  unsigned maxreaders = 8;
+  bool latestcopy = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "n:r:c")) != -1) {
+    switch (opt) {
+    case 'n': nops = std::max(100UL, strtoul(optarg, NULL, 10)); break;
+    case 'r': maxreaders = std::max(1UL, strtoul(optarg, NULL, 10)); break;
+    case 'c': latestcopy = true; break;
+    default:
+      cerr << "usage: " << argv[0]
+           << " [-n operations] [-r max readers] [-c]" << endl;
+      return 1;
+    }
+  }
+
+  startDueca();
+  UChannelEntry::setLatestCopy(latestcopy);
+
+  cout << " entry        class  bytes  rd       mode     ns/op "
+       << "alloc/op  p50(ns)  p99(ns) p999(ns)   max(ns)" << endl;
+  unsigned index = 0;
+  runClass<BenchSmall>(nops, maxreaders, index);
+  runClass<BenchMedium>(nops, maxreaders, index);
+  runClass<BenchLarge>(nops, maxreaders, index);
+
+  if (total_errors) {
+    cerr << "Failed reads: " << total_errors << endl;
+    return 1;
+  }
+  return 0;
+}
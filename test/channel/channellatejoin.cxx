@@ -0,0 +1,300 @@
+// test for differential packing of channel data, with receiving ends
+// that join late. The writing entry is packed by a loop-back packer,
+// and the packed messages are unpacked into remote entries in two
+// other channels. Both receivers start in the middle of a series of
+// differential packs. The first one requests a full pack, which is
+// passed back to the writing end; the second one does not pass on
+// its request, and catches up with the periodic full pack.
+
+#include <dueca/ObjectManager.hxx>
+#include <dueca/Environment.hxx>
+#include <dueca/PackerManager.hxx>
+#include <dueca/ChannelManager.hxx>
+#include <dueca/Ticker.hxx>
+#include <dueca/ScriptInterpret.hxx>
+#include <dueca/ScriptHelper.hxx>
+#include <dueca/GuiHandler.hxx>
+#include <dueca/ActivityManager.hxx>
+#include <dueca/ChannelWriteToken.hxx>
+#include <dueca/ChannelReadToken.hxx>
+#include <dueca/DataUpdater.hxx>
+#include <dueca/DataReader.hxx>
+#include <dueca/GenericPacker.hxx>
+#include <dueca/UnifiedChannel.hxx>
+#include <dueca/UChannelEntry.hxx>
+#include <dueca/AmorphStore.hxx>
+#include "ChannelTestObject.hxx"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+using namespace dueca;
+
+const unsigned NWRITES = 60;
+const unsigned NX = 16;
+const unsigned FULL_INTERVAL = 10;
+const uint32_t JOIN1 = 13;
+const uint32_t JOIN2 = 32;
+
+// no script language, the objects are created in startDueca
+struct NoScript: public ScriptHelper
+{
+  NoScript() : ScriptHelper("", "", "", "") { }
+  void initiate() final { }
+  void interpreter() final { }
+  bool readline(std::string& line) final { return false; }
+  bool writeline(const std::string& line) final { return true; }
+};
+
+// create the DUECA core objects, as dueca_cnf.py does for a single node
+static void startDueca()
+{
+  static GuiHandler nogui(std::string("none"));
+  ScriptInterpret::single(new NoScript());
+  (new ObjectManager(0, 1))->complete();
+  (new Environment())->complete();
+  (new PackerManager())->complete();
+  (new ChannelManager())->complete();
+  (new Ticker())->complete();
+
+  ObjectManager::single()->completeCreation();
+  ChannelManager::single()->completeCreation();
+  for (int prio = 0; prio <= ActivityManager::getMaxPrio(); prio++) {
+    Environment::getInstance()->getActivityManager(prio)->completeCreation();
+  }
+}
+
+// run the environment until the tokens are valid
+static void runUntilValid(vector<ChannelReadToken*> r, ChannelWriteToken* w)
+{
+  for (int ii = 1000; ii--; ) {
+    Environment::getInstance()->update();
+    bool valid = (w == NULL || w->isValid());
+    for (auto t: r) { valid = valid && t->isValid(); }
+    if (valid) return;
+    usleep(1000);
+  }
+  cerr << "tokens not valid" << endl;
+  std::exit(1);
+}
+
+// packer that only collects the notifications
+struct LoopPacker: public GenericPacker
+{
+  typedef PackUnit Unit;
+  LoopPacker() : GenericPacker("LoopPacker") { }
+  AsyncQueueMT<Unit>& work() { return work_queue; }
+};
+
+// a packed message
+struct Message
+{
+  char buffer[1024];
+  unsigned size;
+  UChannelCommRequest::UChannelMessageType type;
+};
+
+// channel end created by the test, which takes the place of the
+// transport; it unpacks messages as an unpacker would, hands out the
+// full data requests that would be sent to the other ends, and adds
+// the loop-back packer as transporter
+struct LoopChannel: public UnifiedChannel
+{
+  LoopChannel(const NameSet& name_set) : UnifiedChannel(name_set) { }
+
+  // unpack a message, sent from node 1
+  void deliver(const Message& m)
+  {
+    AmorphReStore s(m.buffer, m.size);
+    unPackData(s, 1, m.size);
+    assert(s.getIndex() == m.size);
+  }
+
+  // deliver a configuration or data request message
+  void deliver(const UChannelCommRequest& req)
+  {
+    Message m;
+    AmorphStore store(m.buffer, sizeof(m.buffer));
+    req.packData(store);
+    m.size = store.getSize();
+    deliver(m);
+  }
+
+  // take the full data requests from the configuration queue
+  vector<UChannelCommRequest> requests()
+  {
+    vector<UChannelCommRequest> res;
+    while (config_requests.notEmpty()) {
+      AsyncQueueReader<UChannelCommRequest> r(config_requests);
+      if (r.data().type == UChannelCommRequest::FullDataReq) {
+        res.push_back(r.data());
+      }
+    }
+    return res;
+  }
+
+  // configure a remote entry, written in node 1
+  void remoteEntry(entryid_type entry)
+  {
+    deliver(UChannelCommRequest(UChannelCommRequest::NewEntryConf, 0x00,
+                                entry, (1U << 8) | 1U, GlobalId(1, 1),
+                                "ChannelTestObject", "remote"));
+  }
+
+  // transport an entry through a packer
+  void addTransporter(entryid_type entry, GenericPacker* packer)
+  {
+    transporters.push_back(packer);
+    entries[entry]->refreshTransporters();
+  }
+};
+
+// pack the pending work of the writing entry
+static vector<Message> packAll(LoopPacker& packer)
+{
+  vector<Message> res;
+  while (packer.work().notEmpty()) {
+    AsyncQueueReader<LoopPacker::Unit> r(packer.work());
+    res.push_back(Message());
+    AmorphStore store(res.back().buffer, sizeof(res.back().buffer));
+    r.data().entry->packData(store, r.data().idx, r.data().tick);
+    r.data().entry->packComplete(r.data().idx);
+    res.back().size = store.getSize();
+    AmorphReStore s(res.back().buffer, res.back().size);
+    res.back().type = UChannelCommRequest(s).type;
+  }
+  return res;
+}
+
+static unsigned errors = 0;
+
+// the receiver should have the data from write s
+static void check(ChannelReadToken& r, uint32_t s, const char* what)
+{
+  try {
+    DataReader<ChannelTestObject, MatchIntervalStartOrEarlier> dr(r, s + 1);
+    bool ok = dr.data().seq == s;
+    for (unsigned ii = 0; ii < NX; ii++) {
+      ok = ok && dr.data().x[ii] == (s < ii ? 0.0 : s - (s - ii) % NX);
+    }
+    if (!ok && errors++ < 10) {
+      cerr << what << " mismatch for write " << s << ": " << dr.data()
+           << endl;
+    }
+  }
+  catch (const NoDataAvailable& e) {
+    if (errors++ < 10) cerr << what << " no data for write " << s << endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  startDueca();
+  UChannelEntry::setFullPackInterval(FULL_INTERVAL);
+
+  // the channels are created here, before the tokens find them
+  const GlobalId owner = ObjectManager::single()->getId();
+  const NameSet wname("test", "ChannelTestObject", "latejoin");
+  const NameSet rname1("test", "ChannelTestObject", "latejoin1");
+  const NameSet rname2("test", "ChannelTestObject", "latejoin2");
+  LoopChannel& wchn = *(new LoopChannel(wname));
+  LoopChannel& rchn1 = *(new LoopChannel(rname1));
+  LoopChannel& rchn2 = *(new LoopChannel(rname2));
+  ChannelWriteToken w(owner, wname, "ChannelTestObject", "source",
+                      Channel::Continuous, Channel::OnlyOneEntry,
+                      Channel::MixedPacking);
+  ChannelReadToken r1(owner, rname1, "ChannelTestObject", 0,
+                      Channel::Continuous, Channel::OnlyOneEntry,
+                      Channel::JumpToMatchTime, UCallbackOrActivity(), 2);
+  ChannelReadToken r2(owner, rname2, "ChannelTestObject", 0,
+                      Channel::Continuous, Channel::OnlyOneEntry,
+                      Channel::JumpToMatchTime, UCallbackOrActivity(), 2);
+  for (int ii = 20; ii--; ) Environment::getInstance()->update();
+  runUntilValid({ }, &w);
+
+  // the receiving channels get a remote entry with the writer's id
+  const entryid_type entry = w.getEntryId();
+  rchn1.remoteEntry(entry);
+  rchn2.remoteEntry(entry);
+  runUntilValid({ &r1, &r2 }, NULL);
+  rchn1.requests(); rchn2.requests();
+
+  // transport the writing entry through the loop-back packer, which
+  // stays in the channel until the end
+  LoopPacker& packer = *(new LoopPacker());
+  wchn.addTransporter(entry, &packer);
+
+  unsigned nfull = 0, ndiff = 0, nreq1 = 0;
+  bool joined1 = false, joined2 = false;
+  uint32_t synced1 = NWRITES, synced2 = NWRITES;
+  for (uint32_t s = 0; s < NWRITES; s++) {
+
+    // change one element, the others come from the previous write
+    {
+      DataUpdater<ChannelTestObject> dw(w, DataTimeSpec(s + 1, s + 2));
+      dw.data().seq = s;
+      dw.data().x[s % NX] = s;
+    }
+
+    for (const auto& m: packAll(packer)) {
+      if (m.type == UChannelCommRequest::FullData) nfull++;
+      if (m.type == UChannelCommRequest::DiffData) ndiff++;
+
+      // the receivers join late, in a series of differential packs
+      joined1 = joined1 || s == JOIN1;
+      joined2 = joined2 || s == JOIN2;
+      if (joined1) {
+        assert(s != JOIN1 || m.type == UChannelCommRequest::DiffData);
+        rchn1.deliver(m);
+        if (synced1 == NWRITES && m.type == UChannelCommRequest::FullData) {
+          synced1 = s;
+        }
+      }
+      if (joined2) {
+        assert(s != JOIN2 || m.type == UChannelCommRequest::DiffData);
+        rchn2.deliver(m);
+        if (synced2 == NWRITES && m.type == UChannelCommRequest::FullData) {
+          synced2 = s;
+        }
+      }
+    }
+
+    // the first receiver's requests are passed to the writing end
+    for (const auto& req: rchn1.requests()) {
+      assert(req.data0 == entry);
+      nreq1++;
+      wchn.deliver(req);
+    }
+    rchn2.requests();
+
+    if (s >= synced1) check(r1, s, "receiver 1");
+    if (s >= synced2) check(r2, s, "receiver 2");
+  }
+
+  // the request gives a full pack with the next write
+  if (synced1 != JOIN1 + 1) {
+    cerr << "receiver 1 synchronised at " << synced1 << endl;
+    errors++;
+  }
+  if (nreq1 != 1) {
+    cerr << "receiver 1 made " << nreq1 << " requests" << endl;
+    errors++;
+  }
+
+  // the second receiver waits for the periodic full pack
+  if (synced2 <= JOIN2 || synced2 > JOIN2 + FULL_INTERVAL + 1) {
+    cerr << "receiver 2 synchronised at " << synced2 << endl;
+    errors++;
+  }
+  cout << "Full packs " << nfull << ", differential packs " << ndiff
+       << ", synchronised at " << synced1 << " and " << synced2 << endl;
+
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,177 @@
+// test for the recycling of data points and data objects in stream
+// channel entries. A writer changes one array element per write with
+// a DataUpdater, so each written object is a (recycled) copy of the
+// previous one with a single change; stale contents of recycled
+// objects show up as a mismatch. A time-based reader with depth reads older data, a
+// sequential reader lags behind the writer, and a reader with a larger
+// depth is added and removed halfway, changing the recycling ring size.
+
+#include <dueca/ObjectManager.hxx>
+#include <dueca/Environment.hxx>
+#include <dueca/PackerManager.hxx>
+#include <dueca/ChannelManager.hxx>
+#include <dueca/Ticker.hxx>
+#include <dueca/ScriptInterpret.hxx>
+#include <dueca/ScriptHelper.hxx>
+#include <dueca/GuiHandler.hxx>
+#include <dueca/ActivityManager.hxx>
+#include <dueca/ChannelWriteToken.hxx>
+#include <dueca/ChannelReadToken.hxx>
+#include <dueca/DataUpdater.hxx>
+#include <dueca/DataReader.hxx>
+#include "ChannelTestObject.hxx"
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+using namespace dueca;
+
+const unsigned NWRITES = 5000;
+const unsigned NX = 16;
+const unsigned DEPTH = 5;
+
+// no script language, the objects are created in startDueca
+struct NoScript: public ScriptHelper
+{
+  NoScript() : ScriptHelper("", "", "", "") { }
+  void initiate() final { }
+  void interpreter() final { }
+  bool readline(std::string& line) final { return false; }
+  bool writeline(const std::string& line) final { return true; }
+};
+
+// create the DUECA core objects, as dueca_cnf.py does for a single node
+static void startDueca()
+{
+  static GuiHandler nogui(std::string("none"));
+  ScriptInterpret::single(new NoScript());
+  (new ObjectManager(0, 1))->complete();
+  (new Environment())->complete();
+  (new PackerManager())->complete();
+  (new ChannelManager())->complete();
+  (new Ticker())->complete();
+
+  ObjectManager::single()->completeCreation();
+  ChannelManager::single()->completeCreation();
+  for (int prio = 0; prio <= ActivityManager::getMaxPrio(); prio++) {
+    Environment::getInstance()->getActivityManager(prio)->completeCreation();
+  }
+}
+
+// run the environment until the tokens are valid
+static void runUntilValid(vector<ChannelReadToken*> r, ChannelWriteToken* w)
+{
+  for (int ii = 1000; ii--; ) {
+    Environment::getInstance()->update();
+    bool valid = (w == NULL || w->isValid());
+    for (auto t: r) { valid = valid && t->isValid(); }
+    if (valid) return;
+    usleep(1000);
+  }
+  cerr << "tokens not valid" << endl;
+  std::exit(1);
+}
+
+// expected value of element i after write s
+static double expected(uint32_t s, unsigned i)
+{
+  return s < i ? 0.0 : double(s - (s - i) % NX);
+}
+
+static unsigned errors = 0;
+
+static void check(const ChannelTestObject& d, uint32_t s, const char* what)
+{
+  bool ok = d.seq == s;
+  for (unsigned ii = 0; ii < NX; ii++) {
+    ok = ok && d.x[ii] == expected(s, ii);
+  }
+  if (!ok && errors++ < 10) {
+    cerr << what << " mismatch for write " << s << ": " << d << endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  startDueca();
+
+  const GlobalId owner = ObjectManager::single()->getId();
+  const NameSet cname("test", "ChannelTestObject", "recycle");
+  ChannelWriteToken w(owner, cname, "ChannelTestObject", "recycle",
+                      Channel::Continuous);
+  ChannelReadToken rtime(owner, cname, "ChannelTestObject", 0,
+                         Channel::Continuous, Channel::OnlyOneEntry,
+                         Channel::JumpToMatchTime, UCallbackOrActivity(),
+                         DEPTH);
+  ChannelReadToken rseq(owner, cname, "ChannelTestObject", 0,
+                        Channel::Continuous, Channel::OnlyOneEntry,
+                        Channel::ReadAllData);
+  runUntilValid({ &rtime, &rseq }, &w);
+
+  unique_ptr<ChannelReadToken> rdeep;
+  uint32_t nextseq = 0;
+  for (uint32_t s = 0; s < NWRITES; s++) {
+
+    // a reader with a larger depth during the middle part
+    if (s == NWRITES / 3) {
+      rdeep.reset(new ChannelReadToken
+                  (owner, cname, "ChannelTestObject", 0,
+                   Channel::Continuous, Channel::OnlyOneEntry,
+                   Channel::JumpToMatchTime, UCallbackOrActivity(),
+                   4 * DEPTH));
+      runUntilValid({ rdeep.get() }, NULL);
+    }
+    if (s == 2 * NWRITES / 3) {
+      rdeep.reset();
+      for (int ii = 10; ii--; ) Environment::getInstance()->update();
+    }
+
+    // change one element, the others come from the previous write
+    {
+      DataUpdater<ChannelTestObject> dw(w, DataTimeSpec(s + 1, s + 2));
+      dw.data().seq = s;
+      dw.data().x[s % NX] = s;
+    }
+
+    // the latest and older data, within the depth
+    for (uint32_t k = 0; k < DEPTH && k <= s; k++) {
+      try {
+        DataReader<ChannelTestObject, MatchIntervalStart>
+          dr(rtime, s + 1 - k);
+        check(dr.data(), s - k, "time-based");
+      }
+      catch (const NoDataAvailable& e) {
+        if (errors++ < 10) cerr << "no data " << s - k << endl;
+      }
+    }
+
+    // the deep reader sees older data still
+    if (rdeep && s >= NWRITES / 3 + 4 * DEPTH) {
+      DataReader<ChannelTestObject, MatchIntervalStart>
+        dr(*rdeep, s + 2 - 4 * DEPTH);
+      check(dr.data(), s + 1 - 4 * DEPTH, "deep");
+    }
+
+    // sequential reader catches up every 7 writes
+    if (s % 7 == 6 || s == NWRITES - 1) {
+      while (rseq.getNumVisibleSets()) {
+        DataReader<ChannelTestObject, MatchIntervalStartOrEarlier> dr(rseq);
+        check(dr.data(), nextseq++, "sequential");
+      }
+    }
+  }
+
+  if (nextseq != NWRITES) {
+    cerr << "sequential reader got " << nextseq << " of " << NWRITES << endl;
+    errors++;
+  }
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Checked " << NWRITES << " writes" << endl;
+  return 0;
+}
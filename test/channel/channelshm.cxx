@@ -0,0 +1,424 @@
+// test for transport of channel data through shared memory rings.
+// First two rings, for two entries of a channel, are written and read
+// directly; a ring is not created over an existing one, readers
+// attach late, after the rings have wrapped, and data that has been
+// overrun can no longer be read. Then a writing
+// entry is packed by a loop-back packer into notifications, which are
+// unpacked into remote entries in two other channels. The first
+// receiver uses the writer's ring, joins late and is overrun once;
+// the second one cannot map a ring, and falls back to full packs.
+
+#include <dueca/ObjectManager.hxx>
+#include <dueca/Environment.hxx>
+#include <dueca/PackerManager.hxx>
+#include <dueca/ChannelManager.hxx>
+#include <dueca/Ticker.hxx>
+#include <dueca/ScriptInterpret.hxx>
+#include <dueca/ScriptHelper.hxx>
+#include <dueca/GuiHandler.hxx>
+#include <dueca/ActivityManager.hxx>
+#include <dueca/ChannelWriteToken.hxx>
+#include <dueca/ChannelReadToken.hxx>
+#include <dueca/DataUpdater.hxx>
+#include <dueca/DataReader.hxx>
+#include <dueca/GenericPacker.hxx>
+#include <dueca/UnifiedChannel.hxx>
+#include <dueca/UChannelEntry.hxx>
+#include <dueca/ShmChannelRing.hxx>
+#include <dueca/AmorphStore.hxx>
+#include "ChannelTestObject.hxx"
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/mman.h>
+
+using namespace std;
+using namespace dueca;
+
+const unsigned NWRITES = 60;
+const unsigned NX = 16;
+const unsigned NSLOTS = 4;
+const uint32_t JOIN1 = 13;
+const uint32_t HOLD1 = 30;
+const uint32_t JOIN2 = 20;
+
+static unsigned errors = 0;
+
+// data object written for entry e, sequence s
+static ChannelTestObject ringData(unsigned e, uint32_t s)
+{
+  ChannelTestObject o;
+  o.seq = s;
+  for (unsigned ii = 0; ii < NX; ii++) o.x[ii] = e * 1000.0 + s + ii;
+  return o;
+}
+
+// write and read rings for two entries directly
+static void testRings()
+{
+  const NameSet name("test", "ChannelTestObject", "rings");
+  const uint32_t magic = ChannelTestObject::magic_check_number;
+  const uint32_t size = sizeof(ChannelTestObject);
+  const uint32_t key = ShmChannelRing::sessionKey();
+  ShmChannelRing* w[2];
+  ShmChannelRing* r[2];
+  for (unsigned e = 0; e < 2; e++) {
+    w[e] = ShmChannelRing::create(ShmChannelRing::ringName(name, e, key),
+                                  magic, size, NSLOTS);
+    assert(w[e] != NULL);
+  }
+
+  // nothing in the ring before data is published, and no data from
+  // before the first publish
+  const uint32_t first = 100;
+  if (w[0]->holds(first) || w[0]->holds(0)) {
+    cerr << "empty ring holds data" << endl;
+    errors++;
+  }
+  for (uint32_t s = first; s < first + 3 * NSLOTS; s++) {
+    for (unsigned e = 0; e < 2; e++) {
+      ChannelTestObject o = ringData(e, s);
+      w[e]->publish(s, &o);
+    }
+    if (s < first + NSLOTS && w[0]->holds(first - 1)) {
+      cerr << "ring holds data from before the first write" << endl;
+      errors++;
+    }
+  }
+  const uint32_t latest = first + 3 * NSLOTS - 1;
+
+  // another session's ring has a different name, and an existing ring
+  // is not taken over; its data must remain readable
+  if (ShmChannelRing::ringName(name, 0, key) ==
+      ShmChannelRing::ringName(name, 0, key + 1U)) {
+    cerr << "ring names do not depend on the session" << endl;
+    errors++;
+  }
+  if (ShmChannelRing::create(ShmChannelRing::ringName(name, 0, key),
+                             magic, size, NSLOTS) != NULL) {
+    cerr << "created a ring over an existing one" << endl;
+    errors++;
+  }
+
+  // readers attach after the rings have wrapped, with the right class
+  for (unsigned e = 0; e < 2; e++) {
+    r[e] = ShmChannelRing::attach(ShmChannelRing::ringName(name, e, key),
+                                  magic, size);
+    assert(r[e] != NULL);
+  }
+  if (ShmChannelRing::attach(ShmChannelRing::ringName(name, 0, key),
+                             magic + 1U, size) != NULL) {
+    cerr << "attached with the wrong data class" << endl;
+    errors++;
+  }
+
+  // the last NSLOTS writes can be read, older ones are overrun
+  for (uint32_t s = first; s <= latest; s++) {
+    const bool inring = latest - s < NSLOTS;
+    if (w[0]->holds(s) != inring || w[1]->holds(s) != inring) {
+      cerr << "ring holds " << s << " incorrect" << endl;
+      errors++;
+    }
+    for (unsigned e = 0; e < 2; e++) {
+      ChannelTestObject o;
+      const bool ok = r[e]->read(s, &o);
+      if (ok != inring || (ok && !(o == ringData(e, s)))) {
+        cerr << "entry " << e << " read " << s << " incorrect" << endl;
+        errors++;
+      }
+    }
+  }
+
+  for (unsigned e = 0; e < 2; e++) {
+    delete r[e];
+    delete w[e];
+  }
+}
+
+// no script language, the objects are created in startDueca
+struct NoScript: public ScriptHelper
+{
+  NoScript() : ScriptHelper("", "", "", "") { }
+  void initiate() final { }
+  void interpreter() final { }
+  bool readline(std::string& line) final { return false; }
+  bool writeline(const std::string& line) final { return true; }
+};
+
+// create the DUECA core objects, as dueca_cnf.py does for a single node
+static void startDueca()
+{
+  static GuiHandler nogui(std::string("none"));
+  ScriptInterpret::single(new NoScript());
+  (new ObjectManager(0, 1))->complete();
+  (new Environment())->complete();
+  (new PackerManager())->complete();
+  (new ChannelManager())->complete();
+  (new Ticker())->complete();
+
+  ObjectManager::single()->completeCreation();
+  ChannelManager::single()->completeCreation();
+  for (int prio = 0; prio <= ActivityManager::getMaxPrio(); prio++) {
+    Environment::getInstance()->getActivityManager(prio)->completeCreation();
+  }
+}
+
+// run the environment until the tokens are valid
+static void runUntilValid(vector<ChannelReadToken*> r, ChannelWriteToken* w)
+{
+  for (int ii = 1000; ii--; ) {
+    Environment::getInstance()->update();
+    bool valid = (w == NULL || w->isValid());
+    for (auto t: r) { valid = valid && t->isValid(); }
+    if (valid) return;
+    usleep(1000);
+  }
+  cerr << "tokens not valid" << endl;
+  std::exit(1);
+}
+
+// packer that only collects the notifications
+struct LoopPacker: public GenericPacker
+{
+  typedef PackUnit Unit;
+  LoopPacker() : GenericPacker("LoopPacker") { }
+  AsyncQueueMT<Unit>& work() { return work_queue; }
+};
+
+// a packed message
+struct Message
+{
+  char buffer[1024];
+  unsigned size;
+  UChannelCommRequest::UChannelMessageType type;
+};
+
+// channel end created by the test, which takes the place of the
+// transport; it unpacks messages as an unpacker would, hands out the
+// full data requests that would be sent to the other ends, and adds
+// the loop-back packer as transporter
+struct LoopChannel: public UnifiedChannel
+{
+  LoopChannel(const NameSet& name_set) : UnifiedChannel(name_set) { }
+
+  // unpack a message, sent from node 1
+  void deliver(const Message& m)
+  {
+    AmorphReStore s(m.buffer, m.size);
+    unPackData(s, 1, m.size);
+    assert(s.getIndex() == m.size);
+  }
+
+  // deliver a configuration or data request message
+  void deliver(const UChannelCommRequest& req)
+  {
+    Message m;
+    AmorphStore store(m.buffer, sizeof(m.buffer));
+    req.packData(store);
+    m.size = store.getSize();
+    deliver(m);
+  }
+
+  // take the full data requests from the configuration queue
+  vector<UChannelCommRequest> requests()
+  {
+    vector<UChannelCommRequest> res;
+    while (config_requests.notEmpty()) {
+      AsyncQueueReader<UChannelCommRequest> r(config_requests);
+      if (r.data().type == UChannelCommRequest::FullDataReq) {
+        res.push_back(r.data());
+      }
+    }
+    return res;
+  }
+
+  // configure a remote entry, written in node 1
+  void remoteEntry(entryid_type entry)
+  {
+    deliver(UChannelCommRequest(UChannelCommRequest::NewEntryConf, 0x00,
+                                entry, (1U << 8) | 1U, GlobalId(1, 1),
+                                "ChannelTestObject", "remote"));
+  }
+
+  // transport an entry through a packer
+  void addTransporter(entryid_type entry, GenericPacker* packer)
+  {
+    transporters.push_back(packer);
+    entries[entry]->refreshTransporters();
+  }
+};
+
+// pack the pending work of the writing entry
+static vector<Message> packAll(LoopPacker& packer)
+{
+  vector<Message> res;
+  while (packer.work().notEmpty()) {
+    AsyncQueueReader<LoopPacker::Unit> r(packer.work());
+    res.push_back(Message());
+    AmorphStore store(res.back().buffer, sizeof(res.back().buffer));
+    r.data().entry->packData(store, r.data().idx, r.data().tick);
+    r.data().entry->packComplete(r.data().idx);
+    res.back().size = store.getSize();
+    AmorphReStore s(res.back().buffer, res.back().size);
+    res.back().type = UChannelCommRequest(s).type;
+  }
+  return res;
+}
+
+// the receiver should have the data from write s
+static void check(ChannelReadToken& r, uint32_t s, const char* what)
+{
+  try {
+    DataReader<ChannelTestObject, MatchIntervalStartOrEarlier> dr(r, s + 1);
+    bool ok = dr.data().seq == s;
+    for (unsigned ii = 0; ii < NX; ii++) {
+      ok = ok && dr.data().x[ii] == (s < ii ? 0.0 : s - (s - ii) % NX);
+    }
+    if (!ok && errors++ < 10) {
+      cerr << what << " mismatch for write " << s << ": " << dr.data()
+           << endl;
+    }
+  }
+  catch (const NoDataAvailable& e) {
+    if (errors++ < 10) cerr << what << " no data for write " << s << endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  testRings();
+
+  startDueca();
+  UChannelEntry::setShmSlots(NSLOTS);
+
+  // the channels are created here, before the tokens find them
+  const GlobalId owner = ObjectManager::single()->getId();
+  const NameSet wname("test", "ChannelTestObject", "shm");
+  const NameSet rname1("test", "ChannelTestObject", "shm1");
+  const NameSet rname2("test", "ChannelTestObject", "shm2");
+  LoopChannel& wchn = *(new LoopChannel(wname));
+  LoopChannel& rchn1 = *(new LoopChannel(rname1));
+  LoopChannel& rchn2 = *(new LoopChannel(rname2));
+  ChannelWriteToken w(owner, wname, "ChannelTestObject", "source",
+                      Channel::Continuous, Channel::OnlyOneEntry,
+                      Channel::MixedPacking);
+  ChannelReadToken r1(owner, rname1, "ChannelTestObject", 0,
+                      Channel::Continuous, Channel::OnlyOneEntry,
+                      Channel::JumpToMatchTime, UCallbackOrActivity(), 2);
+  ChannelReadToken r2(owner, rname2, "ChannelTestObject", 0,
+                      Channel::Continuous, Channel::OnlyOneEntry,
+                      Channel::JumpToMatchTime, UCallbackOrActivity(), 2);
+  for (int ii = 20; ii--; ) Environment::getInstance()->update();
+  runUntilValid({ }, &w);
+
+  // the receiving channels get a remote entry with the writer's id
+  const entryid_type entry = w.getEntryId();
+  rchn1.remoteEntry(entry);
+  rchn2.remoteEntry(entry);
+  runUntilValid({ &r1, &r2 }, NULL);
+  rchn1.requests(); rchn2.requests();
+
+  // transport the writing entry through the loop-back packer, which
+  // stays in the channel until the end
+  LoopPacker& packer = *(new LoopPacker());
+  wchn.addTransporter(entry, &packer);
+
+  // in one process, the first receiver finds the writer's ring under
+  // its own channel name
+  const uint32_t key = ShmChannelRing::sessionKey();
+  const string wring = ShmChannelRing::ringName(wname, entry, key);
+  const string rring1 = ShmChannelRing::ringName(rname1, entry, key);
+
+  unsigned nfull = 0, nshm = 0, nreq1 = 0, nlate1 = 0, nreq2 = 0;
+  uint32_t synced2 = NWRITES;
+  vector<Message> held;
+  for (uint32_t s = 0; s < NWRITES; s++) {
+
+    // change one element, the others come from the previous write
+    {
+      DataUpdater<ChannelTestObject> dw(w, DataTimeSpec(s + 1, s + 2));
+      dw.data().seq = s;
+      dw.data().x[s % NX] = s;
+    }
+    if (s == 0) {
+      assert(link(("/dev/shm" + wring).c_str(),
+                  ("/dev/shm" + rring1).c_str()) == 0);
+    }
+
+    bool full2 = false;
+    for (const auto& m: packAll(packer)) {
+      if (m.type == UChannelCommRequest::FullData) nfull++;
+      if (m.type == UChannelCommRequest::ShmData) nshm++;
+      if (s > 0 && m.type == UChannelCommRequest::DiffData) {
+        cerr << "differential pack at write " << s << endl;
+        errors++;
+      }
+
+      // the first receiver joins late, and once falls behind by more
+      // than the ring size
+      if (s >= JOIN1) {
+        if (s >= HOLD1 && s < HOLD1 + NSLOTS + 2) {
+          held.push_back(m);
+        }
+        else {
+          for (const auto& h: held) rchn1.deliver(h);
+          held.clear();
+          rchn1.deliver(m);
+        }
+      }
+      if (s >= JOIN2) {
+        rchn2.deliver(m);
+        full2 = full2 || m.type == UChannelCommRequest::FullData;
+      }
+    }
+
+    // requests are passed to the writing end
+    for (const auto& req: rchn1.requests()) {
+      assert(req.data0 == entry);
+      if (s < HOLD1) nlate1++;
+      nreq1++;
+      wchn.deliver(req);
+    }
+    for (const auto& req: rchn2.requests()) {
+      assert(req.data0 == entry);
+      nreq2++;
+      wchn.deliver(req);
+    }
+
+    // the first receiver reads directly from the ring when joining,
+    // and the second only gets full packs
+    if (s >= JOIN1 && (s < HOLD1 || s >= HOLD1 + NSLOTS + 2)) {
+      check(r1, s, "receiver 1");
+    }
+    if (full2) {
+      if (synced2 == NWRITES) synced2 = s;
+      check(r2, s, "receiver 2");
+    }
+  }
+
+  // only the overrun needs a full pack for the first receiver
+  if (nlate1 != 0 || nreq1 == 0) {
+    cerr << "receiver 1 made " << nlate1 << " requests after joining and "
+         << nreq1 - nlate1 << " after overrun" << endl;
+    errors++;
+  }
+
+  // the second receiver asks for full data after joining
+  if (synced2 != JOIN2 + 1 || nreq2 == 0) {
+    cerr << "receiver 2 synchronised at " << synced2 << ", "
+         << nreq2 << " requests" << endl;
+    errors++;
+  }
+  cout << "Full packs " << nfull << ", shared memory " << nshm
+       << ", requests " << nreq1 << " and " << nreq2 << endl;
+
+  shm_unlink(rring1.c_str());
+  shm_unlink(wring.c_str());
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  return 0;
+}
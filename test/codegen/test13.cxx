@@ -0,0 +1,69 @@
+/* ------------------------------------------------------------------   */
+/*      item            : test13.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define test13_cxx
+#include <cassert>
+#include <cstring>
+#include "Object13.hxx"
+#include <AmorphStore.hxx>
+#include <PackUnpackTemplates.hxx>
+
+USING_DUECA_NS;
+
+static_assert(dco_packsize<Object13>::value == 8 + 4 + 1 + 2 + 3 * 4,
+              "Object13 should have a fixed packed size");
+
+int main()
+{
+  char buff[1000], buff2[1000];
+
+  // pack in a single block, and member by member
+  Object13 o1;
+  o1.x = -0.5; o1.i = 123456; o1.b = false; o1.u = 0xbeef;
+  o1.v[1] = -1.25f;
+  AmorphStore st(buff, 1000);
+  packData(st, o1);
+  AmorphStore st2(buff2, 1000);
+  packobject(st2, o1.x, pack_single());
+  packobject(st2, o1.i, pack_single());
+  packobject(st2, o1.b, pack_single());
+  packobject(st2, o1.u, pack_single());
+  packobject(st2, o1.v, pack_constant_size());
+  assert(st.getSize() == dco_packsize<Object13>::value);
+  assert(st2.getSize() == st.getSize());
+  assert(std::memcmp(buff, buff2, st.getSize()) == 0);
+
+  // difference packing is unchanged
+  Object13 o2(o1);
+  o2.u = 5;
+  packDataDiff(st, o2, o1);
+
+  AmorphReStore re(buff, st.getSize());
+  Object13 o1c(re);
+  Object13 o2c(o1c);
+  unPackDataDiff(re, o2c);
+  assert(o1 == o1c);
+  assert(o2 == o2c);
+
+  // a store that is too small is not partially filled
+  AmorphStore st3(buff, 10);
+  bool full = false;
+  try {
+    packData(st3, o1);
+  }
+  catch (const AmorphStoreBoundary&) {
+    full = true;
+  }
+  assert(full && st3.getSize() == 0);
+
+  return 0;
+}
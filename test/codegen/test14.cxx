@@ -0,0 +1,99 @@
+/* ------------------------------------------------------------------   */
+/*      item            : test14.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define test14_cxx
+#include <cassert>
+#include <cstring>
+#include <cmath>
+#include "Object14.hxx"
+#include "Object15.hxx"
+#include <dueca/DCOtoJSON.hxx>
+#include <dueca/smartstring.hxx>
+#include <dueca/CommObjectReader.hxx>
+#ifdef DUECA_CONFIG_WEBSOCK
+#include <websock/msgpackpacker.hxx>
+#include <sstream>
+#endif
+
+USING_DUECA_NS;
+
+int main()
+{
+  // Object14 has typed coding, Object15 has the same members, and is
+  // coded introspectively
+  Object14 o1;
+  o1.i = 5;
+  o1.v.push_back(1.5);
+  o1.v.push_back(-2.0);
+  o1.v.push_back(NAN);
+  o1.v.push_back(-INFINITY);
+  o1.m = Object14::Off;
+  o1.mp["one"] = 1;
+  o1.mp["two"] = -2;
+  o1.o13.x = 3.5;
+
+  Object15 o3;
+  o3.i = o1.i;
+  o3.v = o1.v;
+  o3.m = Object15::Off;
+  o3.mp = o1.mp;
+  o3.o13 = o1.o13;
+
+  // typed coding is available through the registry
+  CommObjectReader r(getclassname<Object14>(), &o1);
+  assert(r.findMetaFunctor("tojson") != NULL);
+  CommObjectReader r3(getclassname<Object15>(), &o3);
+  assert(r3.findMetaFunctor("tojson") == NULL);
+
+  // typed coding gives the same JSON as introspection, strict and compact
+  rapidjson::StringBuffer d1, d3;
+  DCOtoJSONstrict(d1, getclassname<Object14>(), &o1);
+  DCOtoJSONstrict(d3, getclassname<Object15>(), &o3);
+  cout << d1.GetString() << endl;
+  assert(std::string(d1.GetString()) == d3.GetString());
+  assert(std::strstr(d1.GetString(), "\"m\":\"Off\"") != NULL);
+  assert(std::strstr(d1.GetString(), "\"key\":\"two\",\"value\":-2") != NULL);
+
+  rapidjson::StringBuffer c1, c3;
+  DCOtoJSONcompact(c1, getclassname<Object14>(), &o1);
+  DCOtoJSONcompact(c3, getclassname<Object15>(), &o3);
+  cout << c1.GetString() << endl;
+  assert(std::string(c1.GetString()) == c3.GetString());
+
+  // templated coding, directly typed, is strict
+  rapidjson::StringBuffer doc;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(doc);
+  dco_to_json(writer, o1);
+  assert(std::string(doc.GetString()) == d3.GetString());
+
+#ifdef DUECA_CONFIG_WEBSOCK
+  // typed msgpack coding of the websocket server, against introspection
+  assert(r.findMetaFunctor("tomsgpack") != NULL);
+  std::stringstream m1, m3;
+  msgpack::packer<std::ostream> p1(m1), p3(m3);
+  websock::code_dco(p1, r);
+  websock::code_dco(p3, r3);
+  assert(m1.str().size() > 0);
+  assert(m1.str() == m3.str());
+#endif
+
+  // without NaN and infinity, the strict coding can be read back
+  o1.v.resize(2);
+  smartstring s1;
+  s1.encodejson(o1);
+  cout << s1 << endl;
+  Object14 o2;
+  s1.decodejson(o2);
+  cout << o2 << endl;
+  assert(o1 == o2);
+  return 0;
+}
@@ -0,0 +1,120 @@
+/* ------------------------------------------------------------------   */
+/*      item            : test15.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     :
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define test15_cxx
+#include <cassert>
+#include <iostream>
+#include <set>
+#include "Object1.hxx"
+#include "Object2.hxx"
+#include "Object3.hxx"
+#include "Object4.hxx"
+#include "Object5.hxx"
+#include <DataClassRegistry.hxx>
+#include <DataClassRegistrar.hxx>
+
+USING_DUECA_NS;
+using namespace std;
+
+// compatibility as determined with the class names only, following
+// the parent names up
+static bool compatibleByName(const std::string& tryclass,
+                             const std::string& classname)
+{
+  if (tryclass == classname) return true;
+  DataClassRegistry& reg = DataClassRegistry::single();
+  for (std::string c = classname; c.size(); c = reg.getParent(c)) {
+    if (reg.getParent(c) == tryclass) return true;
+  }
+  return false;
+}
+
+int main()
+{
+  DataClassRegistry& reg = DataClassRegistry::single();
+  const vector<string> names{ Object1::classname, Object2::classname,
+      Object3::classname, Object4::classname, Object5::classname };
+  unsigned errors = 0;
+
+  // lookup by id and by name give the same entry
+  set<DataClassRegistry_id_type> ids;
+  for (const auto& n: names) {
+    assert(reg.isRegistered(n));
+    const DataClassRegistry_id_type id = reg.getClassId(n);
+    ids.insert(id);
+    DataClassRegistry_entry_type ix = reg.getEntry(id);
+    if (ix != reg.getEntry(n) || n != reg.getEntryClassname(ix) ||
+        reg.getConverter(id) != reg.getConverter(n)) {
+      cerr << "lookup by id and name differ for " << n << endl;
+      errors++;
+    }
+  }
+  if (ids.size() != names.size() || ids.count(dataclass_noid)) {
+    cerr << "class ids not unique" << endl;
+    errors++;
+  }
+
+  // the parent is found by name and by id
+  if (reg.getParent(Object5::classname) != Object3::classname ||
+      reg.getParentId(reg.getClassId(Object5::classname)) !=
+      reg.getClassId(Object3::classname) ||
+      reg.getParentId(reg.getClassId(Object3::classname)) != dataclass_noid) {
+    cerr << "parent lookup incorrect" << endl;
+    errors++;
+  }
+
+  // compatibility, by name, by id, and by following the names
+  for (const auto& t: names) {
+    for (const auto& c: names) {
+      const bool expect = compatibleByName(t, c);
+      if (reg.isCompatible(t, c) != expect ||
+          reg.isCompatible(reg.getClassId(t), reg.getClassId(c)) != expect) {
+        cerr << "compatibility of " << t << " with " << c
+             << " incorrect" << endl;
+        errors++;
+      }
+    }
+  }
+  if (!reg.isCompatible(Object3::classname, Object5::classname) ||
+      reg.isCompatible(Object5::classname, Object3::classname) ||
+      reg.isCompatible("NoSuchClass", Object5::classname)) {
+    cerr << "compatibility with parent incorrect" << endl;
+    errors++;
+  }
+
+  // unknown classes are not found
+  if (reg.isRegistered("NoSuchClass")) {
+    cerr << "unknown class registered" << endl;
+    errors++;
+  }
+  try {
+    reg.getClassId("NoSuchClass");
+    cerr << "id for unknown class" << endl;
+    errors++;
+  }
+  catch (const DataObjectClassNotFound&) { }
+
+  // a class cannot be registered twice
+  try {
+    DataClassRegistrar again(Object1::classname, NULL, NULL, NULL, NULL);
+    cerr << "class registered twice" << endl;
+    errors++;
+  }
+  catch (const DataObjectClassDoubleEntry&) { }
+
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Class ids and names agree" << endl;
+  return 0;
+}
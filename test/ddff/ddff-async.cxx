@@ -0,0 +1,125 @@
+// test for asynchronous writing of ddff blocks. The same data is
+// written to one file with the normal writes, and to another file
+// with the asynchronous block writer. Both files are read back while
+// writing, and must be identical in the end.
+
+#include <FileHandler.hxx>
+#include <FileStreamWrite.hxx>
+#include <FileStreamRead.hxx>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <cassert>
+
+using namespace dueca::ddff;
+
+const unsigned NSTREAMS = 3;
+const unsigned NROUNDS = 200;
+
+static std::string item(unsigned stream, unsigned round)
+{
+  std::stringstream s;
+  s << "stream " << stream << " round " << round << ' '
+    << std::string((round * 7 + stream * 13) % 90, char('a' + stream));
+  return s.str();
+}
+
+static std::string readFile(const char* fname)
+{
+  std::ifstream f(fname, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(f),
+                     std::istreambuf_iterator<char>());
+}
+
+static unsigned writeFile(const char* fname, bool async)
+{
+  unsigned errors = 0;
+  FileHandler::pointer file
+    (new FileHandler(fname, FileHandler::Mode::Truncate, 256U));
+  file->setAsyncWriting(async);
+
+  FileStreamWrite::pointer write[NSTREAMS];
+  for (unsigned ii = 0; ii < NSTREAMS; ii++) {
+    write[ii] = file->createWrite();
+  }
+  FileStreamRead::pointer read0(file->createRead(0));
+  std::string written0;
+
+  for (unsigned round = 0; round < NROUNDS; round++) {
+    for (unsigned ii = 0; ii < NSTREAMS; ii++) {
+      const std::string data = item(ii, round);
+      write[ii]->markItemStart();
+      std::copy(data.begin(), data.end(), write[ii]->iterator());
+      if (ii == 0) written0 += data;
+    }
+
+    // blocks are written in batches, several blocks at a time
+    if (round % 5 == 4) {
+      file->processWrites();
+    }
+
+    // halfway, read back all that has been written; requires the
+    // writes to be completed
+    if (round == NROUNDS / 2) {
+      file->syncToFile();
+      file->runLoads();
+      const std::string read(read0->iterator(), read0->end());
+      if (read != written0) {
+        std::cerr << fname << " read back mismatch at round " << round
+                  << std::endl;
+        errors++;
+      }
+    }
+  }
+
+  // flushing remaining data happens in the destructors
+  for (auto& w: write) { w.reset(); }
+  read0.reset();
+  return errors;
+}
+
+int main()
+{
+  unsigned errors = writeFile("testsync.ddff", false);
+  errors += writeFile("testasync.ddff", true);
+
+  const std::string sync = readFile("testsync.ddff");
+  const std::string async = readFile("testasync.ddff");
+  if (sync.size() == 0 || sync != async) {
+    std::cerr << "async written file differs, sizes " << sync.size()
+              << " and " << async.size() << std::endl;
+    errors++;
+  }
+
+  // the asynchronously written file can be read normally
+  {
+    FileHandler::pointer file
+      (new FileHandler("testasync.ddff", FileHandler::Mode::Read, 256U));
+    FileStreamRead::pointer read[NSTREAMS];
+    for (unsigned ii = 0; ii < NSTREAMS; ii++) {
+      read[ii] = file->createRead(ii);
+    }
+    file->checkIndices();
+    file->runLoads();
+    for (unsigned ii = 0; ii < NSTREAMS; ii++) {
+      std::string expect;
+      for (unsigned round = 0; round < NROUNDS; round++) {
+        expect += item(ii, round);
+      }
+      std::string data(read[ii]->iterator(), read[ii]->end());
+      if (data != expect) {
+        std::cerr << "stream " << ii << " differs" << std::endl;
+        errors++;
+      }
+    }
+  }
+
+  if (errors) {
+    std::cerr << "Errors: " << errors << std::endl;
+    return 1;
+  }
+  std::cout << "Async and normal writes identical, " << sync.size()
+            << " bytes" << std::endl;
+  return 0;
+}
@@ -0,0 +1,115 @@
+// test for the native conversion of ddff logs to hdf5, as done by
+// dueca-ddff-convert. A recorded log is converted, and the result is
+// compared to the conversion by the Python ddff_convert.py script; the
+// tick and data sets of all streams must contain the same values. The
+// chunk size does not divide the number of rows, so the last chunk is
+// a partial one.
+//
+// usage: ddff-hdf5.x <file.ddff> <python-converted.hdf5>
+
+#include <DDFFToHDF5.hxx>
+#include <H5Cpp.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace dueca::ddff;
+
+static const size_t CHUNKSIZE = 100;
+
+static unsigned errors = 0;
+
+// read a complete data set, converted to the given type
+template<typename T>
+static std::vector<T> readSet(H5::H5File& file, const std::string& path,
+                              const H5::PredType& type)
+{
+  H5::DataSet dset = file.openDataSet(path);
+  H5::DataSpace space = dset.getSpace();
+  std::vector<T> res(space.getSimpleExtentNpoints());
+  if (res.size()) {
+    dset.read(res.data(), type);
+  }
+  return res;
+}
+
+// compare a data set in the converted and the reference file
+template<typename T>
+static void compareSet(H5::H5File& out, H5::H5File& ref,
+                       const std::string& path, const H5::PredType& type,
+                       size_t nrows)
+{
+  try {
+    auto a = readSet<T>(out, path, type);
+    auto b = readSet<T>(ref, path, type);
+    if (a.size() != nrows || b.size() != nrows) {
+      std::cerr << path << ": " << a.size() << " converted and "
+                << b.size() << " reference values, expected "
+                << nrows << std::endl;
+      errors++;
+      return;
+    }
+    for (size_t ii = 0; ii < nrows; ii++) {
+      if (a[ii] != b[ii]) {
+        std::cerr << path << ": row " << ii << " converted " << a[ii]
+                  << ", reference " << b[ii] << std::endl;
+        errors++;
+        return;
+      }
+    }
+  }
+  catch (const H5::Exception& e) {
+    std::cerr << path << ": " << e.getDetailMsg() << std::endl;
+    errors++;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " file.ddff reference.hdf5"
+              << std::endl;
+    return 1;
+  }
+
+  const std::string outfile("ddff-hdf5.hdf5");
+  DDFFToHDF5 converter(argv[1], CHUNKSIZE, false, 2U);
+  auto results = converter.convert(outfile);
+  if (results.size() != converter.getEntries().size() ||
+      results.empty()) {
+    std::cerr << "Converted " << results.size() << " streams" << std::endl;
+    errors++;
+  }
+
+  H5::Exception::dontPrint();
+  H5::H5File out(outfile, H5F_ACC_RDONLY);
+  H5::H5File ref(argv[2], H5F_ACC_RDONLY);
+
+  for (const auto &r: results) {
+    if (r.error.size()) {
+      std::cerr << "Stream " << r.key << ", error " << r.error << std::endl;
+      errors++;
+      continue;
+    }
+    // the time ticks
+    compareSet<uint64_t>(out, ref, r.key + "/tick",
+                         H5::PredType::NATIVE_UINT64, r.nrows);
+
+    // and all data members present in the reference
+    H5::Group data = ref.openGroup(r.key + "/data");
+    for (hsize_t ii = 0; ii < data.getNumObjs(); ii++) {
+      compareSet<double>(out, ref, r.key + "/data/" +
+                         data.getObjnameByIdx(ii),
+                         H5::PredType::NATIVE_DOUBLE, r.nrows);
+    }
+  }
+
+  if (errors) {
+    std::cerr << "Errors: " << errors << std::endl;
+    return 1;
+  }
+  std::cout << "Converted " << results.size()
+            << " streams, equal to the Python conversion" << std::endl;
+  return 0;
+}
@@ -0,0 +1,107 @@
+// test for reading ddff blocks from a file mapping. Data read through
+// the mapping must equal data read with normal file access. A stream
+// is read back while the file is written, and a second stream is read
+// after the file has grown, which extends the mapping.
+
+#include <FileHandler.hxx>
+#include <FileStreamWrite.hxx>
+#include <FileStreamRead.hxx>
+#include <iostream>
+#include <sstream>
+#include <cassert>
+
+using namespace dueca::ddff;
+
+const unsigned NSTREAMS = 3;
+const unsigned NITEMS = 300;
+
+static std::string item(unsigned stream, unsigned ii)
+{
+  std::stringstream s;
+  s << "stream " << stream << " item " << ii << ' '
+    << std::string((ii * 11 + stream * 5) % 120, char('a' + stream));
+  return s.str();
+}
+
+static std::string expected(unsigned stream)
+{
+  std::string res;
+  for (unsigned ii = 0; ii < NITEMS; ii++) {
+    res += item(stream, ii);
+  }
+  return res;
+}
+
+static void writeStream(FileStreamWrite::pointer& w, unsigned stream)
+{
+  for (unsigned ii = 0; ii < NITEMS; ii++) {
+    const std::string data = item(stream, ii);
+    w->markItemStart();
+    std::copy(data.begin(), data.end(), w->iterator());
+  }
+}
+
+// read all streams of the file
+static unsigned readFile(const char* fname, bool mapped, bool sequential)
+{
+  unsigned errors = 0;
+  FileHandler::pointer file
+    (new FileHandler(fname, FileHandler::Mode::Read, 256U));
+  file->setMappedReading(mapped, sequential);
+  FileStreamRead::pointer read[NSTREAMS];
+  for (unsigned ii = 0; ii < NSTREAMS; ii++) {
+    read[ii] = file->createRead(ii);
+  }
+  file->checkIndices();
+  file->runLoads();
+  for (unsigned ii = 0; ii < NSTREAMS; ii++) {
+    const std::string data(read[ii]->iterator(), read[ii]->end());
+    if (data != expected(ii)) {
+      std::cerr << "stream " << ii << (mapped ? " mapped" : " normal")
+                << " read differs" << std::endl;
+      errors++;
+    }
+  }
+  return errors;
+}
+
+int main()
+{
+  unsigned errors = 0;
+
+  // write the streams one by one, and read each back after writing
+  {
+    FileHandler::pointer file
+      (new FileHandler("testmapped.ddff", FileHandler::Mode::Truncate, 256U));
+    file->setMappedReading(true);
+    FileStreamWrite::pointer write[NSTREAMS];
+    for (unsigned ii = 0; ii < NSTREAMS; ii++) {
+      write[ii] = file->createWrite();
+    }
+    FileStreamRead::pointer read[NSTREAMS];
+    for (unsigned ii = 0; ii < NSTREAMS; ii++) {
+      writeStream(write[ii], ii);
+      file->syncToFile();
+      read[ii] = file->createRead(ii);
+      file->runLoads();
+      const std::string data(read[ii]->iterator(), read[ii]->end());
+      if (data != expected(ii)) {
+        std::cerr << "stream " << ii << " read back differs" << std::endl;
+        errors++;
+      }
+    }
+    for (auto& w: write) { w.reset(); }
+  }
+
+  // read the complete file, with and without mapping
+  errors += readFile("testmapped.ddff", false, false);
+  errors += readFile("testmapped.ddff", true, false);
+  errors += readFile("testmapped.ddff", true, true);
+
+  if (errors) {
+    std::cerr << "Errors: " << errors << std::endl;
+    return 1;
+  }
+  std::cout << "Mapped and normal reading identical" << std::endl;
+  return 0;
+}
@@ -0,0 +1,210 @@
+/* ------------------------------------------------------------------   */
+/*      item            : ddff-replaymaster.cxx
+        made by         : Rene' van Paassen
+        date            : 261017
+        category        : body file
+        description     : Replay from the middle of a recorded stretch,
+                          selected with the ReplayMaster, and spooled by
+                          the ReplayFiler
+        changes         : 261017 first version
+        language        : C++
+        copyright       : (c) 2026 René van Paassen
+        license         : EUPL-1.2
+*/
+
+#define ddff_replaymaster_cxx
+#include <FileWithSegments.hxx>
+#include <DDFFDataRecorder.hxx>
+#include <dusime/ReplayMaster.hxx>
+#include <dusime/ReplayFiler.hxx>
+#include <dusime/ReplayReport.hxx>
+#include <dueca/ObjectManager.hxx>
+#include <dueca/NodeManager.hxx>
+#include <dueca/Environment.hxx>
+#include <dueca/PackerManager.hxx>
+#include <dueca/ChannelManager.hxx>
+#include <dueca/Ticker.hxx>
+#include <dueca/ScriptInterpret.hxx>
+#include <dueca/ScriptHelper.hxx>
+#include <dueca/GuiHandler.hxx>
+#include <dueca/ActivityManager.hxx>
+#include <dueca/ChannelWriteToken.hxx>
+#include <dueca/CommObjectWriter.hxx>
+#include <dueca/ChronoTimePoint.hxx>
+#include <dueca/SimTime.hxx>
+#include "Objectx.hxx"
+#include <iostream>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace dueca::ddff;
+using namespace dueca;
+
+// no script language, the objects are created in startDueca
+struct NoScript: public ScriptHelper
+{
+  NoScript() : ScriptHelper("", "", "", "") { }
+  void initiate() final { }
+  void interpreter() final { }
+  bool readline(std::string& line) final { return false; }
+  bool writeline(const std::string& line) final { return true; }
+};
+
+// create the DUECA core objects, as dueca_cnf.py does for a single node
+static void startDueca()
+{
+  static GuiHandler nogui(std::string("none"));
+  ScriptInterpret::single(new NoScript());
+  (new ObjectManager(0, 1))->complete();
+  (new Environment())->complete();
+  (new PackerManager())->complete();
+  (new ChannelManager())->complete();
+  (new Ticker())->complete();
+
+  ObjectManager::single()->completeCreation();
+  ChannelManager::single()->completeCreation();
+  for (int prio = 0; prio <= ActivityManager::getMaxPrio(); prio++) {
+    Environment::getInstance()->getActivityManager(prio)->completeCreation();
+  }
+  new NodeManager(0, 1);
+}
+
+// replay master that gets the replay information and the start of the
+// replay from the test, instead of from the ReplayFiler's reports and
+// the DUSIME state changes
+struct TestReplayMaster: public ReplayMaster
+{
+  TestReplayMaster(const char* entity) : ReplayMaster(entity) { }
+
+  void addTag(const FileWithSegments::Tag& tag)
+  {
+    ReplayReport info;
+    info.status = ReplayReport::Status::TagInformation;
+    info.label = tag.label;
+    info.time = timePointToString(tag.time);
+    info.inco_name = tag.inco_name;
+    info.number = tag.cycle;
+    info.tick0 = tag.index0;
+    info.tick1 = tag.index1;
+    addTagInformation(0, info, false);
+  }
+
+  void start(TimeTickType tick) { startReplay(TimeSpec(tick, tick)); }
+
+  TimeTickType replayStop() const { return getReplayStop(); }
+};
+
+// run the environment until the condition holds
+template <typename F>
+static void runUntil(const F& valid, const char* what)
+{
+  for (int ii = 1000; ii--; ) {
+    Environment::getInstance()->update();
+    if (valid()) return;
+    usleep(1000);
+  }
+  std::cerr << what << " not valid" << std::endl;
+  std::exit(1);
+}
+
+int main()
+{
+  unsigned errors = 0;
+  startDueca();
+
+  // filer for the entity, and a channel whose data is recorded
+  FileWithSegments::findFiler("replayed")->
+    openFile(std::string("recorder-replaymaster.ddff"), std::string(), 128U);
+  auto filer = FileWithSegments::findFiler("replayed", false);
+  ChannelWriteToken w_obj(ObjectManager::single()->getId(),
+                          NameSet("Objectx://replayed"), "Objectx",
+                          "recorded", Channel::Continuous,
+                          Channel::OnlyOneEntry);
+  runUntil([&w_obj]() { return w_obj.isValid(); }, "write token");
+
+  // rec1 records with the channel functor, rec2 with the DCO record call
+  DDFFDataRecorder rec1, rec2;
+  runUntil([&]() {
+      rec1.complete("replayed", w_obj);
+      rec2.complete("replayed", "key for rec2", "Objectx");
+      return rec1.isValid() && rec2.isValid(); }, "recorders");
+
+  // replay control, connected over the replay command channel
+  ReplayFiler& replay_filer = *(new ReplayFiler("replayed"));
+  TestReplayMaster& master = *(new TestReplayMaster("replayed"));
+  runUntil([&]() {
+      return replay_filer.r_replaycommand.isValid() &&
+        replay_filer.w_replayresult.isValid(); }, "replay filer tokens");
+
+  std::cout << "-- Recording a stretch from 100 to 400" << std::endl;
+  filer->nameRecording("record1", "inco1");
+  filer->startStretch(100);
+  DataTimeSpec ts(80, 100);
+  for (int ii = 40; ii--; ) {
+    Objectx data; data.i[0] = ii;
+    CommObjectWriter writer("Objectx", &data);
+    rec1.channelRecord(ts, writer);
+    rec2.record(ts, data);
+    ts += 20;
+    if (ts.getValidityStart() == 400) {
+      filer->stopStretch(400);
+      if (filer->completeStretch(400)) break;
+    }
+  }
+  if (filer->allTags().size() != 1 || filer->allTags()[0].index1 != 300) {
+    std::cerr << "Recorded stretch not complete" << std::endl;
+    return 1;
+  }
+  master.addTag(filer->allTags()[0]);
+
+  std::cout << "-- Replaying from 160 into the stretch" << std::endl;
+
+  // select the stretch, with a start point in its middle; the
+  // ReplayMaster commands the spooling, the ReplayFiler performs it
+  master.changeSelection(0, 160);
+  master.sendSelected();
+  replay_filer.runCommand(TimeSpec(SimTime::getTimeTick()));
+
+  // the replay starts at 2000, and stops at the end of the stretch
+  master.start(2000);
+  replay_filer.runCommand(TimeSpec(SimTime::getTimeTick()));
+  if (master.replayStop() != 2000 + 300 - 160) {
+    std::cerr << "Replay stop at " << master.replayStop()
+              << std::endl;
+    errors++;
+  }
+
+  // data was recorded from tick 0 of the stretch, counting down from 38
+  filer->replayLoad();
+  DataTimeSpec tsr(2000, 2020), tso;
+  int expect = 38 - 160/20;
+  while (tsr.getValidityEnd() <= master.replayStop()) {
+    Objectx data1, data2;
+    DataTimeSpec tso2;
+    if (!rec1.replay(tsr, data1, tso) || !rec2.replay(tsr, data2, tso2)) {
+      std::cerr << "No data at " << tsr << std::endl;
+      errors++;
+    }
+    else if (data1.i[0] != expect || data2.i[0] != expect ||
+             tso != tsr || tso2 != tsr) {
+      std::cerr << "Expected " << expect << " at " << tsr << ", got "
+                << data1.i[0] << " at " << tso << " and "
+                << data2.i[0] << " at " << tso2 << std::endl;
+      errors++;
+    }
+    expect--;
+    tsr += 20;
+    filer->replayLoad();
+  }
+  if (expect != 38 - 300/20) {
+    std::cerr << "Replay ended before the end of the stretch" << std::endl;
+    errors++;
+  }
+
+  if (errors) {
+    std::cerr << "Errors: " << errors << std::endl;
+    return 1;
+  }
+  std::cout << "Replay from the middle of the stretch correct" << std::endl;
+  return 0;
+}
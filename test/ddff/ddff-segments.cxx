@@ -26,6 +26,7 @@ using namespace dueca;
 
 int main()
 {
+  unsigned errors = 0;
 
   // step 1, create a fresh file, should be created through the DDFFDataRecorder
   {
@@ -169,6 +170,44 @@ int main()
       }
     }
 
+    std::cout << "-- Replaying 0 from the middle" << std::endl;
+
+    // spool to a tick halfway the recording; data was recorded from
+    // tick 0 of the stretch to 280, with a step of 20, counting down
+    // from 38
+    FileWithSegments::findFiler("entity")->spoolForReplay(0, 160);
+    FileWithSegments::findFiler("entity")->startTickReplay(2000);
+
+    tsr = DataTimeSpec(2000, 2020);
+    int expect = 38 - 160/20;
+    while (tsr.getValidityEnd() <= 2140) {
+      Objectx data;
+
+      if (rec1.replay(tsr, data, tso)) {
+        std::cout << "Data replay, " << tso << " verif "
+                  << data.i[0] << std::endl;
+        if (data.i[0] != expect || tso.getValidityStart() !=
+            tsr.getValidityStart()) {
+          std::cerr << "Expected " << expect << " at " << tsr << std::endl;
+          errors++;
+        }
+      }
+      else {
+        std::cerr << "No data at " << tsr << std::endl;
+        errors++;
+      }
+      expect--;
+      rec2.replay(tsr, data, tso);
+      tsr += 20;
+      FileWithSegments::findFiler("entity")->replayLoad();
+    }
+
+    // the existing file is replayed through the file mapping
+    if (FileWithSegments::findFiler("entity")->getMappedSize() == 0) {
+      std::cerr << "Replay did not read through the mapping" << std::endl;
+      errors++;
+    }
+
     std::cout << "-- Write additional recording" << std::endl;
 
     // create an additional recording
@@ -226,5 +265,9 @@ int main()
     }
   }
 
+  if (errors) {
+    std::cerr << "Errors: " << errors << std::endl;
+    return 1;
+  }
   return 0;
 }
@@ -0,0 +1,92 @@
+// test of the EventCount, as used for lock-free wake-up of the
+// activity managers. Producer threads write into an AsyncQueueMT and
+// notify, pausing now and then so the consumer parks. The consumer
+// waits with the prepareWait/re-check/wait pattern. A lost wake-up
+// leaves the consumer parked, and is caught by a time-out.
+
+#include <EventCount.hxx>
+#include <AsyncQueueMT.hxx>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cassert>
+
+using namespace std;
+using namespace dueca;
+
+const int NTHREADS = 4;
+const int NMESG = 200000;
+
+// type to send around
+struct MyData
+{
+  int threadno;
+  int messageno;
+};
+
+int main()
+{
+  AsyncQueueMT<MyData> queue;
+  EventCount ec;
+  atomic<bool> done(false);
+  atomic<int> nreceived(0);
+  int nwaits = 0, ndisorder = 0;
+
+  // consumer, checks the order of the messages from each producer
+  thread consumer([&]() {
+      vector<int> latest(NTHREADS, -1);
+      while (nreceived < NTHREADS * NMESG) {
+        while (!queue.notEmpty()) {
+          uint32_t key = ec.prepareWait();
+          if (queue.notEmpty()) { ec.cancelWait(); break; }
+          nwaits++;
+          ec.wait(key);
+        }
+        AsyncQueueReader<MyData> r(queue);
+        if (r.valid()) {
+          if (latest[r.data().threadno] >= r.data().messageno) ndisorder++;
+          latest[r.data().threadno] = r.data().messageno;
+          nreceived++;
+        }
+      }
+      done = true;
+    });
+
+  vector<thread> producers;
+  for (int t = 0; t < NTHREADS; t++) {
+    producers.emplace_back([&, t]() {
+        for (int msg = 0; msg < NMESG; msg++) {
+          {
+            AsyncQueueWriter<MyData> w(queue);
+            w.data().threadno = t;
+            w.data().messageno = msg;
+          }
+          ec.notify();
+          if (msg % (97 + t) == 0) {
+            this_thread::sleep_for(chrono::microseconds(20));
+          }
+        }
+      });
+  }
+  for (auto &p: producers) { p.join(); }
+
+  // all has been written, the consumer must finish
+  for (int ii = 1000; ii-- && !done; ) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  if (!done) {
+    cerr << "consumer stuck after " << nreceived << " messages" << endl;
+    consumer.detach();
+    return 1;
+  }
+  consumer.join();
+
+  cout << "received " << nreceived << ", consumer parked " << nwaits
+       << " times" << endl;
+  assert(ndisorder == 0);
+  assert(nwaits > 0);
+  assert(!queue.notEmpty());
+  return 0;
+}
@@ -0,0 +1,155 @@
+// test for writing HDF5 data through the HDF5ChunkWriter. Rows are
+// copied into chunk buffers, and full chunks are written by the
+// writer thread. When a write functor is deleted, its last, partially
+// filled, chunk is handed to the writer, and the datasets are
+// finalized there. The writer is deleted directly after the functors,
+// its destructor must complete all writes. The data read back must
+// equal the data written, with and without the chunk writer.
+
+#include "HdfChunkObject.hxx"
+#include <HDF5ChunkWriter.hxx>
+#include <HDF5DCOMetaFunctor.hxx>
+#include <dueca/DataClassRegistry.hxx>
+#include <dueca/TimeSpec.hxx>
+#include <H5Cpp.h>
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdio>
+
+using namespace std;
+using namespace dueca;
+using namespace dueca::hdf5log;
+
+const char* FNAME = "testchunks.hdf5";
+const unsigned CHUNKSIZE = 8;
+
+// paths and number of rows; full chunks only, a partial last chunk,
+// less than one chunk, and no data. Written through the chunk writer,
+// or directly for comparison
+struct Case
+{
+  const char* path;
+  unsigned nrows;
+  bool async;
+};
+
+static const Case cases[] = {
+  { "/full", 5 * CHUNKSIZE, true },
+  { "/partial", 5 * CHUNKSIZE + 3, true },
+  { "/short", CHUNKSIZE - 1, true },
+  { "/empty", 0, true },
+  { "/direct", 5 * CHUNKSIZE + 3, false },
+  { "/emptydirect", 0, false },
+};
+
+// data for a row
+static HdfChunkObject row(unsigned ii)
+{
+  HdfChunkObject o;
+  o.i = int32_t(ii) - 7;
+  o.x = 0.25 * ii;
+  for (unsigned jj = 0; jj < 3; jj++) { o.v[jj] = ii + 0.5f * jj; }
+  return o;
+}
+
+// read a dataset, and check its number of rows
+template<typename T>
+static vector<T> readSet(H5::H5File& file, const string& name,
+                         const H5::PredType& type, unsigned nrows,
+                         unsigned ncols, unsigned& errors)
+{
+  H5::DataSet dset = file.openDataSet(name);
+  hsize_t dims[2] = { 0, 0 };
+  dset.getSpace().getSimpleExtentDims(dims);
+  vector<T> res(dims[0] * ncols);
+  if (dims[0] != nrows) {
+    cerr << name << " has " << dims[0] << " rows, expected " << nrows << endl;
+    errors++;
+    return res;
+  }
+  if (nrows) { dset.read(res.data(), type); }
+  return res;
+}
+
+static unsigned checkCase(H5::H5File& file, const Case& c)
+{
+  unsigned errors = 0;
+  const string p(c.path);
+
+  // an unused dataset keeps its initial size of one chunk
+  const unsigned nrows = c.nrows ? c.nrows : CHUNKSIZE;
+  auto i = readSet<int32_t>(file, p + "/data/i", H5::PredType::NATIVE_INT32,
+                            nrows, 1, errors);
+  auto x = readSet<double>(file, p + "/data/x", H5::PredType::NATIVE_DOUBLE,
+                           nrows, 1, errors);
+  auto v = readSet<float>(file, p + "/data/v", H5::PredType::NATIVE_FLOAT,
+                          nrows, 3, errors);
+  auto t = readSet<uint32_t>(file, p + "/tick", H5::PredType::NATIVE_UINT32,
+                             nrows, 1, errors);
+  if (errors) return errors;
+
+  for (unsigned ii = 0; ii < c.nrows; ii++) {
+    const HdfChunkObject o = row(ii);
+    if (i[ii] != o.i || x[ii] != o.x || t[ii] != 10 * ii ||
+        v[3*ii] != o.v[0] || v[3*ii+1] != o.v[1] || v[3*ii+2] != o.v[2]) {
+      cerr << p << " row " << ii << " differs" << endl;
+      return errors + 1;
+    }
+  }
+  return errors;
+}
+
+int main()
+{
+  unsigned errors = 0;
+  std::remove(FNAME);
+
+  std::shared_ptr<HDF5DCOMetaFunctor> meta
+    (std::dynamic_pointer_cast<HDF5DCOMetaFunctor>
+     (DataClassRegistry::single().getMetaFunctor
+      (getclassname<HdfChunkObject>(), "hdf5").lock()));
+  std::shared_ptr<H5::H5File> file
+    (new H5::H5File(FNAME, H5F_ACC_TRUNC));
+  static const DataTimeSpec always(0, MAX_TIMETICK);
+
+  HDF5ChunkWriter* writer = new HDF5ChunkWriter();
+  vector<HDF5DCOWriteFunctor*> functors;
+  {
+    HDF5ChunkWriter::library_lock_t l = HDF5ChunkWriter::libraryLock();
+    for (const auto& c: cases) {
+      functors.push_back(meta->getWriteFunctor(file, c.path, CHUNKSIZE,
+                                               c.path, &always, true));
+      if (c.async) { functors.back()->setAsyncWriter(writer); }
+    }
+  }
+
+  // write the rows, interleaved over the functors
+  for (unsigned ii = 0; ii < 5 * CHUNKSIZE + 3; ii++) {
+    const HdfChunkObject o = row(ii);
+    for (unsigned jj = 0; jj < functors.size(); jj++) {
+      if (ii < cases[jj].nrows) {
+        (*functors[jj])(&o, DataTimeSpec(10 * ii, 10 * ii + 10));
+      }
+    }
+  }
+
+  // deleting the functors hands over the partial chunks, and deleting
+  // the writer completes the writes and the disposal of the datasets
+  for (auto f: functors) { delete f; }
+  delete writer;
+  file.reset();
+
+  // read back
+  H5::H5File rfile(FNAME, H5F_ACC_RDONLY);
+  for (const auto& c: cases) {
+    errors += checkCase(rfile, c);
+  }
+
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Chunked HDF5 data read back" << endl;
+  return 0;
+}
@@ -0,0 +1,122 @@
+// test for parallel integration. A set of non-linear models is
+// integrated one by one, and in parallel on a pool of worker threads,
+// with Runge-Kutta and with Euler integration. The results must be
+// bit-identical. An exception in a model is passed to the caller.
+
+#include <integrate_parallel.hxx>
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+
+using namespace std;
+
+const unsigned NMODELS = 37;
+const unsigned NSTEPS = 500;
+const double DT = 0.01;
+
+// damped pendulum with a driving force, parameters per model
+struct Pendulum
+{
+  Eigen::VectorXd x;
+  double omega2, damping, drive;
+  bool fail;
+
+  Pendulum(unsigned ii) :
+    x(2), omega2(1.0 + 0.1 * ii), damping(0.01 * ii), drive(0.3 * ii),
+    fail(false)
+  { x << 0.1 * ii, 0.0; }
+
+  void derivative(VectorE& xd, double dt)
+  {
+    if (fail) throw std::runtime_error("model failure");
+    xd[0] = x[1];
+    xd[1] = -omega2 * std::sin(x[0]) - damping * x[1] +
+      drive * std::cos(x[0] * x[1]);
+  }
+  const Eigen::VectorXd& X() const { return x; }
+  void setState(const VectorE& newx) { x = newx; }
+  void changeState(const VectorE& dx) { x += dx; }
+};
+
+// a single step, one by one
+static void integrate(Pendulum& p, RungeKuttaWorkspace& ws)
+{ integrate_rungekutta(p, ws, DT); }
+
+static void integrate(Pendulum& p, EulerWorkspace& ws)
+{ integrate_euler(p, ws, DT); }
+
+// integrate one by one and in parallel, compare the states
+template<class WS>
+static unsigned compare(IntegrationPool& pool, unsigned chunk,
+                        const char* what)
+{
+  vector<Pendulum> serial, parallel;
+  for (unsigned ii = 0; ii < NMODELS; ii++) {
+    serial.emplace_back(ii);
+    parallel.emplace_back(ii);
+  }
+  vector<WS*> ws;
+  ParallelIntegration<Pendulum, WS> integration(pool, chunk);
+  for (auto &p: parallel) {
+    integration.add(p);
+    ws.push_back(new WS(2));
+  }
+
+  for (unsigned step = 0; step < NSTEPS; step++) {
+    for (unsigned ii = 0; ii < NMODELS; ii++) {
+      integrate(serial[ii], *ws[ii]);
+    }
+    integration.step(DT);
+  }
+  for (auto w: ws) { delete w; }
+
+  unsigned errors = 0;
+  for (unsigned ii = 0; ii < NMODELS; ii++) {
+    if (std::memcmp(serial[ii].x.data(), parallel[ii].x.data(),
+                    2 * sizeof(double))) {
+      cerr << what << " model " << ii << " differs, "
+           << serial[ii].x.transpose() << " and "
+           << parallel[ii].x.transpose() << endl;
+      errors++;
+    }
+  }
+  return errors;
+}
+
+int main()
+{
+  IntegrationPool pool(3);
+  unsigned errors = 0;
+  errors += compare<RungeKuttaWorkspace>(pool, 1U, "Runge-Kutta chunk 1");
+  errors += compare<RungeKuttaWorkspace>(pool, 4U, "Runge-Kutta chunk 4");
+  errors += compare<EulerWorkspace>(pool, 3U, "Euler chunk 3");
+
+  // an exception in one of the models reaches the caller
+  {
+    vector<Pendulum> models;
+    for (unsigned ii = 0; ii < NMODELS; ii++) models.emplace_back(ii);
+    models[NMODELS / 2].fail = true;
+    ParallelIntegration<Pendulum, RungeKuttaWorkspace> integration(pool);
+    for (auto &m: models) integration.add(m);
+    try {
+      integration.step(DT);
+      cerr << "model exception not passed" << endl;
+      errors++;
+    }
+    catch (const std::runtime_error&) { }
+
+    // and the pool can be used again
+    models[NMODELS / 2].fail = false;
+    integration.step(DT);
+  }
+
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Parallel integration identical on " << pool.size() + 1
+       << " threads" << endl;
+  return 0;
+}
@@ -0,0 +1,148 @@
+// test for batch interpolation in tables. Batches of points are
+// interpolated with InterpTable1..4::getValues, and compared to the
+// point-by-point results of Interpolator1..4. The points include
+// values outside the tables, infinite values and NaN, and the tables
+// have both equally spaced and irregular breakpoints.
+
+#define INCLUDE_TEMPLATE_SOURCE
+#define DO_INSTANTIATE
+#include <InterpIndex.hxx>
+#include <InterpTable1.hxx>
+#include <InterpTable2.hxx>
+#include <InterpTable3.hxx>
+#include <InterpTable4.hxx>
+#include <Interpolator1.hxx>
+#include <Interpolator2.hxx>
+#include <Interpolator3.hxx>
+#include <Interpolator4.hxx>
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+
+using namespace std;
+using namespace dueca;
+
+const unsigned NPOINTS = 200;
+
+// equally spaced, and irregular breakpoints
+static const double iu[] = { -1.0, 0.0, 1.0, 2.0, 3.0 };
+static const double ir[] = { -1.0, -0.2, 0.5, 2.0, 3.0 };
+
+static unsigned errors = 0;
+
+// values for one axis; in and outside the table, and special values
+static vector<double> testValues(unsigned seed)
+{
+  vector<double> v(NPOINTS);
+  for (unsigned ii = 0; ii < NPOINTS; ii++) {
+    seed = seed * 1103515245U + 12345U;
+    v[ii] = -3.0 + 8.0 * ((seed >> 8) % 10000U) / 10000.0;
+  }
+  v[seed % 20] = numeric_limits<double>::quiet_NaN();
+  v[20 + seed % 20] = numeric_limits<double>::infinity();
+  v[40 + seed % 20] = -numeric_limits<double>::infinity();
+  v[60] = 3.0; v[61] = -1.0; v[62] = 2.0; v[63] = 0.5;
+  return v;
+}
+
+// batch and scalar results must be equal, or both NaN
+static void compare(const vector<double>& batch,
+                    const vector<double>& scalar, const char* what)
+{
+  for (unsigned ii = 0; ii < NPOINTS; ii++) {
+    const bool same = (std::isnan(batch[ii]) && std::isnan(scalar[ii])) ||
+      std::fabs(batch[ii] - scalar[ii]) <= 1e-12;
+    if (!same && errors++ < 10) {
+      cerr << what << " point " << ii << " batch " << batch[ii]
+           << " scalar " << scalar[ii] << endl;
+    }
+  }
+}
+
+int main()
+{
+  InterpIndex<double> uniform(5, iu);
+  InterpIndex<double> irregular(5, ir);
+  if (!uniform.isUniform() || irregular.isUniform()) {
+    cerr << "equal spacing not detected" << endl;
+    errors++;
+  }
+
+  // an index needs at least one interval
+  try {
+    InterpIndex<double> single(1, iu);
+    cerr << "index with one point accepted" << endl;
+    errors++;
+  }
+  catch (const std::invalid_argument&) { }
+
+  // table data, 5^4 values
+  vector<double> data(625);
+  for (unsigned ii = 0; ii < data.size(); ii++) {
+    data[ii] = std::sin(0.37 * ii) + 0.01 * ii;
+  }
+  const vector<double> v1 = testValues(1), v2 = testValues(2),
+    v3 = testValues(3), v4 = testValues(4);
+  vector<double> batch(NPOINTS), scalar(NPOINTS);
+
+  for (const auto idx: { &uniform, &irregular }) {
+    const InterpIndex<double>& i1 = *idx;
+    const InterpIndex<double>& i2 = (idx == &uniform) ? irregular : uniform;
+
+    InterpTable1<double, InterpIndex<double> > t1(i1, data.data());
+    Interpolator1<double> p1(i1);
+    t1.getValues(batch.data(), v1.data(), NPOINTS);
+    for (unsigned ii = 0; ii < NPOINTS; ii++) {
+      p1.updateIndices(v1[ii]);
+      scalar[ii] = p1.getValue(t1);
+    }
+    compare(batch, scalar, "table 1");
+
+    InterpTable2<double, InterpIndex<double> > t2(i1, i2, data.data());
+    Interpolator2<double> p2(i1, i2);
+    t2.getValues(batch.data(), v1.data(), v2.data(), NPOINTS);
+    for (unsigned ii = 0; ii < NPOINTS; ii++) {
+      p2.updateIndices(v1[ii], v2[ii]);
+      scalar[ii] = p2.getValue(t2);
+    }
+    compare(batch, scalar, "table 2");
+
+    InterpTable3<double, InterpIndex<double> > t3(i1, i2, i1, data.data());
+    Interpolator3<double> p3(i1, i2, i1);
+    t3.getValues(batch.data(), v1.data(), v2.data(), v3.data(), NPOINTS);
+    for (unsigned ii = 0; ii < NPOINTS; ii++) {
+      p3.updateIndices(v1[ii], v2[ii], v3[ii]);
+      scalar[ii] = p3.getValue(t3);
+    }
+    compare(batch, scalar, "table 3");
+
+    InterpTable4<double, InterpIndex<double> >
+      t4(i1, i2, i1, i2, data.data());
+    Interpolator4<double> p4(i1, i2, i1, i2);
+    t4.getValues(batch.data(), v1.data(), v2.data(), v3.data(), v4.data(),
+                 NPOINTS);
+    for (unsigned ii = 0; ii < NPOINTS; ii++) {
+      p4.updateIndices(v1[ii], v2[ii], v3[ii], v4[ii]);
+      scalar[ii] = p4.getValue(t4);
+    }
+    compare(batch, scalar, "table 4");
+
+    // points outside the table give the edge values
+    const double out[] = { -10.0, 10.0 };
+    double res[2];
+    t1.getValues(res, out, 2);
+    if (res[0] != data[0] || res[1] != data[4]) {
+      cerr << "edge values " << res[0] << ' ' << res[1] << endl;
+      errors++;
+    }
+  }
+
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Batch and point interpolation identical" << endl;
+  return 0;
+}
@@ -0,0 +1,136 @@
+// test for table files. A table is written, mapped and compared to
+// the original data, also through an interpolation table. The file
+// is then replaced by an updated version, which a table source picks
+// up, while the previous version stays valid for its users.
+
+#define INCLUDE_TEMPLATE_SOURCE
+#define DO_INSTANTIATE
+#include <InterpTableFile.hxx>
+#include <InterpIndex.hxx>
+#include <InterpTable2.hxx>
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <dirent.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace dueca;
+
+static const char* fname = "interpfile.itb";
+static const int dims[] = { 3, 5 };
+static const double ax0[] = { 0.0, 1.0, 2.5 };
+static const double ax1[] = { -2.0, -1.0, 0.0, 1.0, 2.0 };
+static const double* const axes[] = { ax0, ax1 };
+
+static unsigned errors = 0;
+
+// table data for a revision
+static vector<double> tableData(uint32_t revision)
+{
+  vector<double> d(dims[0] * dims[1]);
+  for (unsigned ii = 0; ii < d.size(); ii++) {
+    d[ii] = 0.5 * ii + 100.0 * revision;
+  }
+  return d;
+}
+
+// the mapped file must equal the written data
+static void compare(const InterpTableFile& f, uint32_t revision)
+{
+  const vector<double> d = tableData(revision);
+  bool ok = f.nDims() == 2U && f.getRevision() == revision &&
+    f.dim(0) == dims[0] && f.dim(1) == dims[1];
+  for (unsigned dd = 0; ok && dd < 2; dd++) {
+    for (int ii = 0; ii < dims[dd]; ii++) {
+      ok = ok && f.axis<double>(dd)[ii] == axes[dd][ii];
+    }
+  }
+  for (unsigned ii = 0; ok && ii < d.size(); ii++) {
+    ok = ok && f.data<double>()[ii] == d[ii];
+  }
+
+  // through a table, at the breakpoints
+  InterpTable2<double, InterpIndex<double> > table(f);
+  for (int ii = 0; ok && ii < dims[0]; ii++) {
+    for (int jj = 0; ok && jj < dims[1]; jj++) {
+      double r;
+      table.getValues(&r, &ax0[ii], &ax1[jj], 1);
+      ok = r == d[ii * dims[1] + jj];
+    }
+  }
+  if (!ok) {
+    cerr << "table file revision " << revision << " differs" << endl;
+    errors++;
+  }
+}
+
+// no temporary files may be left
+static void checkNoTemporary()
+{
+  DIR* dir = opendir(".");
+  for (struct dirent* e = readdir(dir); e != NULL; e = readdir(dir)) {
+    const string name(e->d_name);
+    if (name.size() > string(fname).size() &&
+        name.compare(0, string(fname).size(), fname) == 0) {
+      cerr << "temporary file " << name << " left" << endl;
+      errors++;
+    }
+  }
+  closedir(dir);
+}
+
+int main()
+{
+  // write and map
+  InterpTableFile::write(fname, 2U, dims, axes, tableData(1).data(), 1U);
+  checkNoTemporary();
+  InterpTableSource source(fname);
+  shared_ptr<const InterpTableFile> f1 = source.get();
+  compare(*f1, 1U);
+  if (source.reload() || f1->isReplaced()) {
+    cerr << "unchanged file reloaded" << endl;
+    errors++;
+  }
+
+  // replace with an update, the source switches to the new version
+  InterpTableFile::write(fname, 2U, dims, axes, tableData(2).data(), 2U);
+  checkNoTemporary();
+  if (!f1->isReplaced() || !source.reload()) {
+    cerr << "updated file not picked up" << endl;
+    errors++;
+  }
+  compare(*source.get(), 2U);
+
+  // the previous version is still mapped for its user
+  compare(*f1, 1U);
+
+  // a rewrite with the same revision is also a new version, seen as
+  // a new pointer from get()
+  shared_ptr<const InterpTableFile> f2 = source.get();
+  InterpTableFile::write(fname, 2U, dims, axes, tableData(2).data(), 2U);
+  if (!source.reload() || source.get() == f2) {
+    cerr << "rewritten file not picked up" << endl;
+    errors++;
+  }
+  f2.reset();
+
+  // a table with a single breakpoint cannot be written
+  try {
+    const int bad[] = { 1, 5 };
+    InterpTableFile::write(fname, 2U, bad, axes, tableData(3).data(), 3U);
+    cerr << "table with one breakpoint written" << endl;
+    errors++;
+  }
+  catch (const InterpTableFileError&) { }
+  compare(InterpTableFile(fname), 2U);
+
+  f1.reset();
+  unlink(fname);
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Table file written and read back" << endl;
+  return 0;
+}
@@ -0,0 +1,132 @@
+// test of the LatestValueSlot, the sequence-locked copy of the latest
+// data in a stream entry. A single writer publishes objects of which
+// all words equal the sequence number, with a matching time span.
+// Several readers copy the slot concurrently; each accepted copy must
+// be consistent, and the sequence numbers seen by a reader may not go
+// back. The object size is not a multiple of the word size, so the
+// copy of the last, partial word is also checked.
+
+#include <LatestValueSlot.hxx>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+using namespace std;
+using namespace dueca;
+
+const int NREADERS = 4;
+const uint32_t NPUBLISH = 1000000;
+const unsigned NWORDS = 67;
+
+// object to copy around
+struct Payload
+{
+  uint32_t w[NWORDS];
+};
+
+static atomic<unsigned> errors(0);
+
+// check a copy, all words and the time span follow the sequence number
+static bool consistent(const Payload& p, uint32_t seqid,
+                       const DataTimeSpec& ts)
+{
+  for (unsigned ii = 0; ii < NWORDS; ii++) {
+    if (p.w[ii] != seqid) return false;
+  }
+  return ts.getValidityStart() == 10U * seqid &&
+    ts.getValidityEnd() == 10U * seqid + 10U;
+}
+
+struct ReadResult
+{
+  unsigned accepted = 0;
+  unsigned rejected = 0;
+  uint32_t last = 0;
+};
+
+static void reader(const LatestValueSlot* slot, const atomic<bool>* done,
+                   ReadResult* res)
+{
+  Payload p;
+  uint32_t seqid;
+  DataTimeSpec ts;
+  while (!done->load() || res->accepted == 0) {
+    if (!slot->read(&p, seqid, ts)) {
+      res->rejected++;
+      continue;
+    }
+    res->accepted++;
+    if (!consistent(p, seqid, ts)) {
+      cerr << "inconsistent copy, seqid " << seqid << " word 0 "
+           << p.w[0] << " word " << NWORDS - 1 << ' ' << p.w[NWORDS - 1]
+           << " time " << ts << endl;
+      errors++;
+      return;
+    }
+    if (seqid < res->last) {
+      cerr << "sequence went back, from " << res->last << " to "
+           << seqid << endl;
+      errors++;
+      return;
+    }
+    res->last = seqid;
+  }
+}
+
+int main()
+{
+  LatestValueSlot slot(sizeof(Payload));
+  Payload p;
+  uint32_t seqid;
+  DataTimeSpec ts;
+
+  // no data yet
+  if (slot.read(&p, seqid, ts)) {
+    cerr << "read from an empty slot" << endl;
+    errors++;
+  }
+
+  atomic<bool> done(false);
+  vector<ReadResult> results(NREADERS);
+  vector<thread> readers;
+  for (int t = 0; t < NREADERS; t++) {
+    readers.emplace_back(reader, &slot, &done, &results[t]);
+  }
+
+  // the single writer
+  thread writer([&slot]() {
+    Payload data;
+    for (uint32_t s = 1; s <= NPUBLISH; s++) {
+      for (auto &w: data.w) { w = s; }
+      slot.publish(s, DataTimeSpec(10U * s, 10U * s + 10U), &data);
+    }
+  });
+  writer.join();
+  done = true;
+  for (auto &r: readers) { r.join(); }
+
+  for (int t = 0; t < NREADERS; t++) {
+    cout << "reader " << t << " accepted " << results[t].accepted
+         << " rejected " << results[t].rejected
+         << " last " << results[t].last << endl;
+    if (results[t].accepted == 0) {
+      cerr << "reader " << t << " got no data" << endl;
+      errors++;
+    }
+  }
+
+  // after the writer is done, the latest data is read
+  if (!slot.read(&p, seqid, ts) || seqid != NPUBLISH ||
+      !consistent(p, seqid, ts)) {
+    cerr << "final read failed" << endl;
+    errors++;
+  }
+
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Latest value slot checked" << endl;
+  return 0;
+}
@@ -10,10 +10,20 @@
 
 #define linearsystem_cxx
 #include <LinearSystem.hxx>
+#include <LinearSystemN.hxx>
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 using namespace std;
 using namespace dueca;
 
+// equal within a relative tolerance; the fixed-size and dynamic
+// calculations may differ in rounding, e.g. with FMA contraction
+static bool near(double a, double b)
+{
+  return std::abs(a - b) <= 1e-10 * std::max(1.0, std::abs(b));
+}
+
 int main()
 {
   double dt = 0.02;
@@ -62,5 +72,35 @@ int main()
   cout << "  C " << notch_filter2->getC() << endl;
   cout << "  D " << notch_filter2->getD() << endl;
  #endif
+
+  // fixed-size version should give the same response
+  LinearSystemN<2,1,1> notch_n(numnf, dennf, dt);
+  LinearSystemN<2,1,1>::StateBatch X(2, 3); X.setZero();
+  LinearSystemN<2,1,1>::InputBatch U(1, 3);
+  LinearSystemN<2,1,1>::OutputBatch Y;
+  for (int ii = 0; ii < 200; ii++) {
+    double u = sin(0.1*ii);
+    double y = notch_filter1->step(u)[0];
+    if (!near(notch_n.step(u)[0], y)) {
+      cerr << "LinearSystemN differs at step " << ii << endl;
+      return 1;
+    }
+    U << u, 0.0, 2.0*u;
+    notch_n.stepBatch(X, U, Y);
+    if (!near(Y(0,0), y) || !near(Y(0,1), 0.0) || !near(Y(0,2), 2.0*y)) {
+      cerr << "LinearSystemN batch differs at step " << ii << endl;
+      return 1;
+    }
+  }
+
+  // dimension mismatch should be detected
+  try {
+    LinearSystemN<3,1,1> wrong(numnf, dennf, dt);
+    cerr << "LinearSystemN dimension error not detected" << endl;
+    return 1;
+  }
+  catch (const LinSysException& e) {
+    cout << "expected exception " << e.what() << endl;
+  }
   return 0;
 }
@@ -0,0 +1,139 @@
+// test for deferred logging. With the per-thread rings switched on,
+// log messages are copied in binary form, and only appear when the
+// log concentrator formats them. Checks the formatting of the
+// different argument types, dropping of messages when a ring is full,
+// messages from another thread, removal of that thread's ring after
+// it exits, and direct formatting of errors after the messages that
+// were waiting.
+
+#include <dueca/LogConcentrator.hxx>
+#include <dueca/LogRing.hxx>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <string>
+#include <vector>
+#include <dueca/debug.h>
+
+using namespace std;
+using namespace dueca;
+
+const unsigned NSLOTS = 4;
+
+// an argument with its own stream operator
+struct Custom
+{
+  int v;
+};
+
+ostream& operator<< (ostream& os, const Custom& c)
+{
+  return os << "custom(" << c.v << ')';
+}
+
+static unsigned errors = 0;
+
+// number of rings in the list
+static unsigned countRings()
+{
+  unsigned n = 0;
+  for (LogRing* r = LogRing::first(); r != NULL; r = r->next) n++;
+  return n;
+}
+
+// check the captured log output, and clear it
+static void check(stringstream& log, const vector<string>& expect,
+                  const char* what)
+{
+  const string text = log.str();
+  size_t pos = 0;
+  for (const auto& e: expect) {
+    size_t found = text.find(e, pos);
+    if (found == string::npos) {
+      cout << what << ": missing \"" << e << "\" in:" << endl
+           << text << endl;
+      errors++;
+      break;
+    }
+    pos = found + e.size();
+  }
+  log.str("");
+}
+
+int main()
+{
+  // capture the printed log messages
+  stringstream log;
+  streambuf* original = cerr.rdbuf(log.rdbuf());
+
+  LogRing::setRingSize(NSLOTS);
+
+  // the arguments are copied, and formatted later
+  const unsigned char ustr[] = "unsigned";
+  const string str("string");
+  Custom c{ 3 };
+  W_MOD("args " << 42 << ' ' << -7 << ' ' << 2.5 << ' ' << true << ' '
+        << str << ' ' << ustr << ' ' << nullptr << ' ' << c << ' '
+        << std::hex << 255 << ' ' << c);
+  if (log.str().find("args") != string::npos) {
+    cout << "message formatted before the flush" << endl;
+    errors++;
+  }
+  LogConcentrator::single().flushDeferred();
+  check(log, { "args 42 -7 2.5 1 string unsigned nullptr custom(3) ff "
+               "custom(3)" }, "deferred arguments");
+
+  // the formatting state does not carry over to the next message
+  W_MOD("decimal " << 255);
+  LogConcentrator::single().flushDeferred();
+  check(log, { "decimal 255" }, "format reset");
+
+  // a full ring drops messages
+  for (unsigned ii = 0; ii < NSLOTS + 3; ii++) {
+    W_MOD("message " << ii);
+  }
+  LogConcentrator::single().flushDeferred();
+  check(log, { "message 0", "message 3", "3 messages dropped" },
+        "dropping");
+
+  // another thread has its own ring, created when the thread starts,
+  // and removed after the thread exits and its messages are formatted
+  const unsigned nrings = countRings();
+  unsigned nrings_thread = 0;
+  std::thread other([&nrings_thread]() {
+    LogRing::prepare();
+    nrings_thread = countRings();
+    for (unsigned ii = 0; ii < NSLOTS; ii++) {
+      W_MOD("thread message " << ii);
+    }
+  });
+  other.join();
+  if (nrings_thread != nrings + 1 || countRings() != nrings + 1) {
+    cout << "thread ring not prepared, or removed too early" << endl;
+    errors++;
+  }
+  LogConcentrator::single().flushDeferred();
+  check(log, { "thread message 0", "thread message 3" }, "other thread");
+  if (countRings() != nrings) {
+    cout << "ring of an exited thread not removed" << endl;
+    errors++;
+  }
+
+  // an error is formatted directly, after the waiting messages
+  W_MOD("before the error");
+  E_MOD("the error " << 1);
+  check(log, { "before the error", "the error 1" }, "error path");
+
+  // and normal formatting when the rings are off
+  LogRing::setRingSize(0);
+  W_MOD("direct " << 2.5 << ' ' << ustr << ' ' << c);
+  check(log, { "direct 2.5 unsigned custom(3)" }, "direct");
+
+  cerr.rdbuf(original);
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Deferred logging checked" << endl;
+  return 0;
+}
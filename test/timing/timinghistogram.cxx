@@ -0,0 +1,120 @@
+// test for the log-linear timing histograms of TimingCheck. Checks
+// that each time falls in a bucket whose range contains it, that the
+// bucket width stays within 1/16 of the value, and that percentiles,
+// merging and resetting agree with the recorded samples.
+
+#include <dueca/TimingHistogram.hxx>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace dueca;
+
+// exact percentile of a set of samples
+static int32_t exactPercentile(vector<int32_t> v, double p)
+{
+  sort(v.begin(), v.end());
+  size_t idx = size_t(ceil(p * v.size()));
+  return v[idx ? idx - 1 : 0];
+}
+
+int main()
+{
+  unsigned errors = 0;
+  const int32_t tmax = (1 << 25) - 1;
+
+  // small times have their own bucket
+  for (int32_t t = 0; t < 16; t++) {
+    if (TimingHistogram::bucketIndex(t) != unsigned(t) ||
+        TimingHistogram::bucketHigh(t) != t) {
+      cerr << "time " << t << " not in its own bucket" << endl;
+      errors++;
+    }
+  }
+
+  // each time lies between the previous bucket's and its bucket's
+  // upper limit, and buckets are not wider than 1/16 of the value
+  unsigned previdx = 0;
+  for (int32_t t = 1; t <= tmax && errors < 10; t += 1 + t / 37) {
+    const unsigned idx = TimingHistogram::bucketIndex(t);
+    const int32_t high = TimingHistogram::bucketHigh(idx);
+    const int32_t low = TimingHistogram::bucketHigh(idx - 1) + 1;
+    if (idx < previdx || t < low || t > high ||
+        high - low + 1 > max(1, low / 16)) {
+      cerr << "time " << t << " bucket " << idx << " range " << low
+           << " to " << high << endl;
+      errors++;
+    }
+    previdx = idx;
+  }
+
+  // limits of the range
+  if (TimingHistogram::bucketIndex(-5) != 0U ||
+      TimingHistogram::bucketIndex(tmax) != TimingHistogram::n_buckets - 1U ||
+      TimingHistogram::bucketIndex(tmax + 1) != TimingHistogram::n_buckets - 1U ||
+      TimingHistogram::bucketIndex(0x7fffffff) !=
+      TimingHistogram::n_buckets - 1U ||
+      TimingHistogram::bucketHigh(TimingHistogram::n_buckets - 1U) != tmax) {
+    cerr << "range limits incorrect" << endl;
+    errors++;
+  }
+
+  // record a spread of samples, in two halves
+  TimingHistogram h1, h2, all;
+  vector<int32_t> start, run;
+  unsigned seed = 12345U;
+  for (unsigned ii = 0; ii < 10000; ii++) {
+    seed = seed * 1103515245U + 12345U;
+    const int32_t s = int32_t((seed >> 8) % 2000U) +
+      (ii % 1000 == 0 ? 50000 : 0);
+    seed = seed * 1103515245U + 12345U;
+    const int32_t r = int32_t((seed >> 8) % 300U) + 10;
+    start.push_back(s);
+    run.push_back(r);
+    (ii % 2 ? h1 : h2).record(s, r);
+    all.record(s, r);
+  }
+
+  // merged halves equal the complete histogram
+  h1.merge(h2);
+  if (!(h1 == all)) {
+    cerr << "merged histogram differs" << endl;
+    errors++;
+  }
+
+  // percentiles are the upper bound of the bucket with the exact value
+  for (double p: { 0.5, 0.9, 0.99, 0.999, 1.0 }) {
+    const int32_t es = exactPercentile(start, p);
+    const int32_t er = exactPercentile(run, p);
+    const int32_t hs = all.startPercentile(p);
+    const int32_t hr = all.runPercentile(p);
+    if (hs < es || hs > es + es / 16 || hs > all.max_start ||
+        hr < er || hr > er + er / 16 || hr > all.max_run) {
+      cerr << "percentile " << p << " start " << hs << " exact " << es
+           << " run " << hr << " exact " << er << endl;
+      errors++;
+    }
+  }
+  if (all.startPercentile(1.0) != all.max_start ||
+      all.max_start != *max_element(start.begin(), start.end()) ||
+      all.n_samples != 10000U) {
+    cerr << "maximum or count incorrect" << endl;
+    errors++;
+  }
+
+  // reset clears all
+  all.reset();
+  if (!(all == TimingHistogram()) || all.startPercentile(0.99) != 0) {
+    cerr << "reset incomplete" << endl;
+    errors++;
+  }
+
+  if (errors) {
+    cerr << "Errors: " << errors << endl;
+    return 1;
+  }
+  cout << "Timing histogram checked" << endl;
+  return 0;
+}
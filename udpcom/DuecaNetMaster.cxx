@@ -80,6 +80,11 @@ const ParameterTable* DuecaNetMaster::getParameterTable()
       (&_ThisClass_::socket_priority),
       "Set socket priority on send socket. Default 6. Suggestion\n"
       "6, or 7 with root access / CAP_NET_ADMIN capability, -1 to disable." },
+    { "receive-batch", new VarProbe<_ThisClass_,uint32_t>
+      (&_ThisClass_::receive_batch),
+      "Maximum number of UDP messages read with a single system call.\n"
+      "Default 1, set to the number of peers or more to reduce system calls\n"
+      "with many peers, or with broadcast/multicast." },
 
     { "if-address", new VarProbe<_ThisClass_,vstring>
       (&_ThisClass_::interface_address),
@@ -509,12 +514,11 @@ clientUnpackPayload(MessageBuffer::ptr_type buffer, unsigned id,
     fill_unpacker->acceptBuffer(buffer, current_tick);
   }
 
-  // last one, log cycle duration
+  // last one to arrive, log cycle duration
   if (w_logtiming){
     log_capacity[id]->histoLog(regularsize, buffer->fill, buffer->capacity);
-    if (id == npeers) {
-      int64_t cycle_tx = Ticker::single()->getUsecsSinceTick(current_tick);
-      log_timing->histoLog(cycle_tx, cycle_span);
+    if (last_peer_arrival >= 0) {
+      log_timing->histoLog(last_peer_arrival, cycle_span);
 
       if (log_timing->n_points == n_logpoints) {
         log_timing->net_permessage = net_permessage;
@@ -69,6 +69,11 @@ const ParameterTable* DuecaNetPeer::getParameterTable()
       (&_ThisClass_::socket_priority),
       "Set socket priority on send socket. Default 6. Suggestion\n"
       "6, or 7 with root access / CAP_NET_ADMIN capability, -1 to disable." },
+    { "receive-batch", new VarProbe<_ThisClass_,uint32_t>
+      (&_ThisClass_::receive_batch),
+      "Maximum number of UDP messages read with a single system call.\n"
+      "Default 1, set to the number of peers or more to reduce system calls\n"
+      "with many peers, or with broadcast/multicast." },
 
     { "if-address", new VarProbe<_ThisClass_,std::string>
       (&_ThisClass_::interface_address),
@@ -65,6 +65,7 @@ NetCommunicatorMaster::NetCommunicatorMaster() :
   net_permessage(10.0), // set up time
   net_tau1(0.0001),
   net_tau2(0.0001),
+  last_peer_arrival(-1),
   last_cycle_time(0),
   last_cycle_bytes(0),
   current_tick(0),
@@ -568,9 +569,10 @@ void NetCommunicatorMaster::doCycle(const TimeSpec &ts, Activity &activity)
     packed_cycle = message_cycle;
   }
 
-  // Receive the data from the peers; use select and a timeout
+  // Receive the data from the peers; blocks with a timeout
   // nreceived will be updated in the data unpack
   nreceived = 0;
+  last_peer_arrival = -1;
   while (nreceived < npeers) {
 
 #ifdef BUILD_TESTOPT
@@ -787,6 +789,13 @@ void NetCommunicatorMaster::unpackPeerData(MessageBuffer::ptr_type &buffer)
     // mark the buffer with the cycle number
     buffer->message_cycle = i_.cycle.cycleCount();
 
+    // note the time when the last expected message comes in
+    if (i_.cycle == message_cycle && nreceived + 1 == npeers) {
+      last_peer_arrival =
+        Ticker::single()->getUsecsSinceTick(current_tick);
+      DEB("cycle complete after " << last_peer_arrival);
+    }
+
     // at this point, decode the data if this has not yet been processed
     // for this peer, figure out the cycle count for the peer
     peer_cycles_type::iterator pp = peer_cycles.find(i_.peer_id);
@@ -136,6 +136,11 @@ protected:
   /** Time constant per message estimation */
   double net_tau2;
 
+  /** Arrival of the message completing the current cycle, in usecs
+      after the cycle's tick, -1 while messages are outstanding. Set
+      before that message is unpacked. */
+  int last_peer_arrival;
+
 private:
   /** previous cycle's time */
   int last_cycle_time;
@@ -32,6 +32,7 @@ PacketCommunicatorSpecification() :
   port_re_use(false),
   lowdelay(true),
   socket_priority(6),
+  receive_batch(1),
   server_key(""),
   server_crt(""),
   callback()
@@ -60,6 +60,10 @@ struct PacketCommunicatorSpecification
   /** Socket priority for sending */
   int                                 socket_priority;
 
+  /** Maximum number of messages read in one system call, for UDP
+      communication */
+  uint32_t                            receive_batch;
+
   /** Server key, if using ssl connection */
   std::string server_key;
 
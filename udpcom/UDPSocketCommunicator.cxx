@@ -14,6 +14,8 @@
 #define UDPSocketCommunicator_cxx
 
 #include <boost/lexical_cast.hpp>
+#include <vector>
+#include <cerrno>
 
 #include <dueca-conf.h>
 #define I_NET
@@ -24,12 +26,54 @@
 #include "NetCommunicator.hxx"
 #include <netinet/ip.h>
 #include <dueca-udp-config.h>
+#if defined(SYMBOL_EPOLL)
+#include <sys/epoll.h>
+#endif
 
 #define DEBPRINTLEVEL -1
 #include <debprint.h>
 
 DUECA_NS_START;
 
+#if defined(SYMBOL_RECVMMSG)
+/** Message buffers and headers for reading with recvmmsg */
+struct UDPSocketCommunicator::BatchReceive
+{
+  /** Message buffers, NULL when handed over */
+  std::vector<MessageBuffer::ptr_type> buffers;
+
+  /** Message headers */
+  std::vector<struct mmsghdr> hdr;
+
+  /** Data vectors, point to the buffers */
+  std::vector<struct iovec> iov;
+
+  /** Sender addresses */
+  std::vector<struct sockaddr_in> from;
+
+  /** Index of the next message to pass */
+  unsigned next;
+
+  /** Number of received messages */
+  unsigned count;
+
+  /** Constructor */
+  BatchReceive(unsigned n) :
+    buffers(n, NULL),
+    hdr(n),
+    iov(n),
+    from(n),
+    next(0U),
+    count(0U)
+  { }
+};
+#else
+struct UDPSocketCommunicator::BatchReceive
+{
+  // empty, no recvmmsg
+};
+#endif
+
 // helper to determine multicast
 static bool isMulticastAddress(in_addr_t s_addr)
 {
@@ -59,8 +103,10 @@ UDPSocketCommunicator::UDPSocketCommunicator(
   dataport(7001),
   comm_send(-1),
   comm_recv(-1),
+  poll_fd(-1),
   connection_mode(Undetermined),
-  default_timeout()
+  default_timeout(),
+  batch(NULL)
 {
   // decode the url, e.g. "udp://myhost.mynet:8432"
   if (spec.url.substr(0, 6) != "udp://") {
@@ -99,6 +145,20 @@ UDPSocketCommunicator::UDPSocketCommunicator(
     memset(&host_address, 0, sizeof(host_address));
     memset(&host_netmask, 0, sizeof(host_netmask));
     memset(&target_address, 0, sizeof(target_address));
+
+    // when requested, prepare for receiving multiple messages per call
+    if (spec.receive_batch > 1) {
+#if defined(SYMBOL_RECVMMSG)
+      batch = new BatchReceive(spec.receive_batch);
+#else
+      /* DUECA network.
+
+         Batched receive of UDP messages was requested, but recvmmsg
+         is not available on this system. Messages are received one
+         by one. */
+      W_NET("No recvmmsg, ignoring receive batch " << spec.receive_batch);
+#endif
+    }
   }
   catch (const std::exception &e) {
     /* DUECA network.
@@ -112,7 +172,18 @@ UDPSocketCommunicator::UDPSocketCommunicator(
   }
 }
 
-UDPSocketCommunicator::~UDPSocketCommunicator() { undoUDPConnection(); }
+UDPSocketCommunicator::~UDPSocketCommunicator()
+{
+  undoUDPConnection();
+#if defined(SYMBOL_RECVMMSG)
+  if (batch) {
+    for (auto &buf : batch->buffers) {
+      if (buf) returnBuffer(buf);
+    }
+  }
+#endif
+  delete batch;
+}
 
 void UDPSocketCommunicator::configureHostAddress()
 {
@@ -489,6 +560,30 @@ void UDPSocketCommunicator::configureUDPConnection(bool is_master)
     throw(connectionfails());
   }
 
+#if defined(SYMBOL_EPOLL) && defined(SYMBOL_EPOLL_PWAIT2)
+  // watch the receiving socket with epoll; level-triggered, since
+  // receive() takes one message at a time. Only with epoll_pwait2,
+  // since epoll_wait has a coarser timeout than select
+  poll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (poll_fd != -1) {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = comm_recv;
+    if (epoll_ctl(poll_fd, EPOLL_CTL_ADD, comm_recv, &ev) == -1) {
+      close(poll_fd);
+      poll_fd = -1;
+    }
+  }
+  if (poll_fd == -1) {
+    /* DUECA network.
+
+       Could not create an epoll instance for the receiving socket,
+       will use select instead. */
+    W_NET("Cannot use epoll for UDP reception: " << strerror(errno));
+  }
+#endif
+
   static const char *conmode[] = { "PointToPoint", "MultiCast", "BroadCast",
                                    "Undetermined" };
   /* DUECA network.
@@ -550,9 +645,48 @@ void UDPSocketCommunicator::undoUDPConnection()
   case PointToPoint:
     break;
   }
+  if (poll_fd != -1) {
+    close(poll_fd);
+  }
   close(comm_send);
   close(comm_recv);
-  comm_recv = comm_send = -1;
+  comm_recv = comm_send = poll_fd = -1;
+}
+
+int UDPSocketCommunicator::waitForData(const struct timeval &timeout)
+{
+  int res;
+#if defined(SYMBOL_EPOLL) && defined(SYMBOL_EPOLL_PWAIT2)
+  if (poll_fd != -1) {
+    struct epoll_event ev;
+    struct timespec to = { timeout.tv_sec, timeout.tv_usec * 1000 };
+    do {
+      res = epoll_pwait2(poll_fd, &ev, 1, &to, NULL);
+    } while (res == -1 && errno == EINTR);
+    if (res != -1 || errno != ENOSYS) {
+      return res;
+    }
+
+    /* DUECA network.
+
+       The kernel does not provide epoll_pwait2 (it needs 5.11 or
+       later), UDP reception waits with select instead. */
+    W_NET("No epoll_pwait2 in this kernel, using select");
+    close(poll_fd);
+    poll_fd = -1;
+  }
+#endif
+
+  // set-up for select; on Linux, select updates the timeout with the
+  // remaining time, for a retry after a signal
+  fd_set socks;
+  struct timeval to = timeout;
+  do {
+    FD_ZERO(&socks);
+    FD_SET(comm_recv, &socks);
+    res = select(comm_recv + 1, &socks, NULL, NULL, &to);
+  } while (res == -1 && errno == EINTR);
+  return res;
 }
 
 void UDPSocketCommunicator::send(MessageBuffer::ptr_type buffer)
@@ -594,11 +728,15 @@ bool UDPSocketCommunicator::SenderINET::operator==(const SenderINET &o) const
 
 void UDPSocketCommunicator::flush()
 {
-  // set-up for select
-  fd_set socks;
-  FD_ZERO(&socks);
-  FD_SET(comm_recv, &socks);
-  struct timeval timeout = { .tv_sec = 0, .tv_usec = 0 };
+#if defined(SYMBOL_RECVMMSG)
+  // forget messages from a previous batch, buffers are re-used
+  if (batch) {
+    batch->next = batch->count = 0U;
+  }
+#endif
+
+  // no waiting
+  const struct timeval timeout = { .tv_sec = 0, .tv_usec = 0 };
 
   // dummy spaces for receive
   MessageBuffer::ptr_type buffer = getBuffer();
@@ -608,11 +746,11 @@ void UDPSocketCommunicator::flush()
   } peer_ip;
   socklen_t peer_ip_len = sizeof(peer_ip.in);
 
-  // use select to check for data
-  int sres = select(comm_recv + 1, &socks, NULL, NULL, &timeout);
+  // check for data
+  int sres = waitForData(timeout);
 
   // read (a fraction of the data) while no timeout
-  while (sres) {
+  while (sres > 0) {
     ssize_t nbytes = recvfrom(comm_recv, buffer->buffer, buffer->capacity, 0,
                               &peer_ip.gen, &peer_ip_len);
 
@@ -632,40 +770,103 @@ void UDPSocketCommunicator::flush()
           << id << " claiming id: " << i_peer_id);
     }
 
-    sres = select(comm_recv + 1, &socks, NULL, NULL, &timeout);
+    sres = waitForData(timeout);
+  }
+  if (sres == -1) {
+    /* DUECA network.
+
+       Unexpected error when checking for UDP data to flush. */
+    W_NET("UDP wait error for flush: " << strerror(errno));
   }
   returnBuffer(buffer);
 }
 
-std::pair<int, ssize_t> UDPSocketCommunicator::receive()
+ssize_t UDPSocketCommunicator::nextFromBatch(MessageBuffer::ptr_type &buffer,
+                                             struct sockaddr_in &from)
 {
-  // set-up for select
-  fd_set socks;
-  FD_ZERO(&socks);
-  FD_SET(comm_recv, &socks);
-  struct timeval timeout = default_timeout;
+#if defined(SYMBOL_RECVMMSG)
+  if (batch->next == batch->count) {
 
-  // use select to check for data
-  int sres = select(comm_recv + 1, &socks, NULL, NULL, &timeout);
+    // prepare all slots; buffers not handed over are re-used
+    for (unsigned ii = 0; ii < batch->buffers.size(); ii++) {
+      if (batch->buffers[ii] == NULL) {
+        batch->buffers[ii] = getBuffer();
+      }
+      batch->iov[ii].iov_base = batch->buffers[ii]->buffer;
+      batch->iov[ii].iov_len = batch->buffers[ii]->capacity;
+      memset(&batch->hdr[ii], 0, sizeof(struct mmsghdr));
+      batch->hdr[ii].msg_hdr.msg_name = &batch->from[ii];
+      batch->hdr[ii].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+      batch->hdr[ii].msg_hdr.msg_iov = &batch->iov[ii];
+      batch->hdr[ii].msg_hdr.msg_iovlen = 1;
+    }
 
-  // timeout, no data
-  if (sres == 0) {
-    return std::make_pair(int(-1), ssize_t(0));
+    // socket is readable, take all that is waiting, up to the batch size
+    int nmsg = recvmmsg(comm_recv, batch->hdr.data(), batch->hdr.size(),
+                        MSG_WAITFORONE, NULL);
+    if (nmsg <= 0) {
+      buffer = NULL;
+      return -1;
+    }
+    DEB1("Node " << peer_id << " batch of " << nmsg << " messages");
+    batch->next = 0U;
+    batch->count = nmsg;
   }
 
-  // get a buffer
-  MessageBuffer::ptr_type buffer = getBuffer();
+  // hand over the next one
+  const unsigned ii = batch->next++;
+  buffer = batch->buffers[ii];
+  batch->buffers[ii] = NULL;
+  from = batch->from[ii];
+  return batch->hdr[ii].msg_len;
+#else
+  buffer = NULL;
+  return -1;
+#endif
+}
 
-  // preparation for getting the sender's address
+std::pair<int, ssize_t> UDPSocketCommunicator::receive()
+{
+  // no select when there are messages left from a previous batch
+#if defined(SYMBOL_RECVMMSG)
+  if (batch == NULL || batch->next == batch->count)
+#endif
+  {
+    // wait for data, timeout returns no data
+    const int sres = waitForData(default_timeout);
+    if (sres == -1) {
+      /* DUECA network.
+
+         Unexpected error when waiting for UDP data; handled as a
+         timeout. */
+      W_NET("UDP wait error: " << strerror(errno));
+    }
+    if (sres <= 0) {
+      return std::make_pair(int(-1), ssize_t(0));
+    }
+  }
+
+  // buffer and preparation for getting the sender's address
+  MessageBuffer::ptr_type buffer;
   union {
     struct sockaddr_in in;
     struct sockaddr gen;
   } peer_ip;
-  socklen_t peer_ip_len = sizeof(peer_ip.in);
+  ssize_t nbytes;
+
+  if (batch) {
+
+    // from a batch read with recvmmsg
+    nbytes = nextFromBatch(buffer, peer_ip.in);
+  }
+  else {
 
-  // get the actual data
-  ssize_t nbytes = recvfrom(comm_recv, buffer->buffer, buffer->capacity, 0,
-                            &peer_ip.gen, &peer_ip_len);
+    // get a buffer, and the actual data
+    buffer = getBuffer();
+    socklen_t peer_ip_len = sizeof(peer_ip.in);
+    nbytes = recvfrom(comm_recv, buffer->buffer, buffer->capacity, 0,
+                      &peer_ip.gen, &peer_ip_len);
+  }
 
   // check on OK?
   if (nbytes == -1) {
@@ -675,7 +876,7 @@ std::pair<int, ssize_t> UDPSocketCommunicator::receive()
        network. */
     W_NET("UDP receive error: " << strerror(errno));
 
-    returnBuffer(buffer);
+    if (buffer) returnBuffer(buffer);
     throw(packetcommunicationfailure(strerror(errno)));
   }
 
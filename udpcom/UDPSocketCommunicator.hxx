@@ -88,6 +88,10 @@ protected:
   /** Receiving socket for udp packages */
   int                                 comm_recv;
 
+  /** Epoll instance watching the receiving socket, -1 if not used.
+      Used with epoll_pwait2 only, select is used otherwise. */
+  int                                 poll_fd;
+
   /** Type of connection (deduced from target address), point-to-point,
       multicast or broadcast */
   enum ConnectionType {
@@ -128,6 +132,21 @@ protected:
   /** Map with peer ID's */
   std::map<SenderINET,int>            peers;
 
+  /** Storage for receiving messages in batches */
+  struct BatchReceive;
+
+  /** Batched receive, NULL if messages are received one by one */
+  BatchReceive                        *batch;
+
+  /** Get the next message from the batch, reading a new batch when
+      needed. The socket must be readable.
+
+      @param buffer  Buffer with the message, or NULL on error.
+      @param from    Sender address.
+      @returns       Number of bytes, or -1 on error. */
+  ssize_t nextFromBatch(MessageBuffer::ptr_type &buffer,
+                        struct sockaddr_in &from);
+
 protected:
   /** Constructor */
   UDPSocketCommunicator(const PacketCommunicatorSpecification& spec);
@@ -144,6 +163,13 @@ protected:
   /** undo udp connection */
   void undoUDPConnection();
 
+  /** Wait until the receiving socket has data.
+
+      @param timeout Maximum waiting time.
+      @returns       0 on timeout, -1 on error, positive when data is
+                     available. */
+  int waitForData(const struct timeval& timeout);
+
 public:
   /** Code and send new data, or re-send a previous message after
       failure */
@@ -66,7 +66,10 @@ SingleEntryRead::SingleEntryRead(const std::string &channelname,
           Channel::AnyTimeAspect, Channel::OneOrMoreEntries,
           Channel::JumpToMatchTime, 0.1, &do_valid),
   datatype(datatype),
-  inactive(true)
+  inactive(true),
+  last_frame(),
+  last_frame_time(0, 0),
+  last_frame_sets(0U)
 {
   do_valid.switchOn();
 }
@@ -104,20 +107,21 @@ SingleEntryRead::addConnection<std::shared_ptr<WssServer::Connection>>(
 template <typename C>
 void SingleEntryRead::passData(const TimeSpec &ts, C &connection)
 {
-  std::stringstream buffer;
   DEB("SingleEntryRead::passData " << ts);
 
   // Fix for initial triggering when not enough data in the channel,
   // cause not exactly clear @TODO investigate
+  frame_ptr frame;
   if (!inactive && r_token.haveVisibleSets()) {
-    DCOReader r(datatype.c_str(), r_token);
-    master->codeData(buffer, r);
+    frame = currentFrame();
   }
-  else {
+  if (!frame) {
     DEB("SingleEntryRead, no data for time step " << ts);
+    std::stringstream buffer;
     master->codeEmpty(buffer);
+    frame.reset(new SharedFrame(buffer.str()));
   }
-  sendOne(buffer.str(), "channel data", connection);
+  sendOne(*frame, "channel data", connection);
 }
 
 template void SingleEntryRead::passData<std::shared_ptr<WsServer::Connection>>(
@@ -125,6 +129,31 @@ template void SingleEntryRead::passData<std::shared_ptr<WsServer::Connection>>(
 template void SingleEntryRead::passData<std::shared_ptr<WssServer::Connection>>(
   const TimeSpec &ts, std::shared_ptr<WssServer::Connection> &connection);
 
+frame_ptr SingleEntryRead::currentFrame()
+{
+  // with several clients polling the same entry, the latest sample is
+  // likely already encoded
+  if (last_frame && r_token.getLatestDataTime() == last_frame_time &&
+      r_token.getNumVisibleSets() == last_frame_sets) {
+    DEB("SingleEntryRead, re-using frame for " << last_frame_time);
+    return last_frame;
+  }
+
+  std::stringstream buffer;
+  try {
+    DCOReader r(datatype.c_str(), r_token);
+    last_frame_time = r.timeSpec();
+    master->codeData(buffer, r);
+  }
+  catch (const NoDataAvailable &e) {
+    last_frame.reset();
+    return last_frame;
+  }
+  last_frame_sets = r_token.getNumVisibleSets();
+  last_frame.reset(new SharedFrame(buffer.str()));
+  return last_frame;
+}
+
 void SingleEntryRead::tokenValid(const TimeSpec &ts)
 {
   if (inactive) {
@@ -285,38 +314,91 @@ bool ConnectionList::removeConnection(
   return false;
 }
 
+SharedFrame::SharedFrame(std::string &&data) :
+  data(std::move(data)),
+  message(),
+  smessage()
+{}
+
+const std::shared_ptr<WsServer::OutMessage> &
+SharedFrame::getMessage(const std::shared_ptr<WsServer::Connection> &c) const
+{
+  if (!message) {
+    message = std::make_shared<WsServer::OutMessage>(data.size());
+    message->write(data.data(), data.size());
+  }
+  return message;
+}
+
+const std::shared_ptr<WssServer::OutMessage> &
+SharedFrame::getMessage(const std::shared_ptr<WssServer::Connection> &c) const
+{
+  if (!smessage) {
+    smessage = std::make_shared<WssServer::OutMessage>(data.size());
+    smessage->write(data.data(), data.size());
+  }
+  return smessage;
+}
+
 void ConnectionList::sendAll(const std::string &data, const char *desc)
 {
-  // send to all existing connections
+  sendAll(SharedFrame(std::string(data)), desc);
+}
+
+void ConnectionList::sendAll(const SharedFrame &frame, const char *desc)
+{
+  // all connections of a server type get the same message
   for (auto &cn : connections) {
-    sendOne(data, desc, cn);
+    sendOne(frame, desc, cn);
   }
   for (auto &cn : sconnections) {
-    sendOne(data, desc, cn);
+    sendOne(frame, desc, cn);
   }
 }
 
+/** Callback after sending, removes a failing connection */
+template <typename C> struct SendResult
+{
+  /** Connection */
+  C cn;
+
+  /** List to remove it from */
+  ConnectionList *list;
+
+  /** What was sent */
+  const char *desc;
+
+  /** Check the result */
+  void operator()(const SimpleWeb::error_code &ec) const
+  {
+    if (ec) {
+      /* DUECA websockets.
+
+         Error in a send action, will remove the connection from the
+         list of clients.
+      */
+      W_XTR("Error sending " << desc << ", " << ec.message()
+                             << " removing connenction form "
+                             << list->identification);
+      list->removeConnection(cn);
+    }
+  }
+};
+
 template <typename C>
 void ConnectionList::sendOne(const std::string &data, const char *desc,
                              const C &cn)
 {
   DEB("ConnectionList::sendOne " << desc << data);
-  cn->send(
-    data,
-    [cn, this, desc](const SimpleWeb::error_code &ec) {
-      if (ec) {
-        /* DUECA websockets.
+  cn->send(data, SendResult<C>{ cn, this, desc }, marker);
+}
 
-           Error in a send action, will remove the connection from the
-           list of clients.
-        */
-        W_XTR("Error sending " << desc << ", " << ec.message()
-                               << " removing connenction form "
-                               << this->identification);
-        this->removeConnection(cn);
-      }
-    },
-    marker);
+template <typename C>
+void ConnectionList::sendOne(const SharedFrame &frame, const char *desc,
+                             const C &cn)
+{
+  DEB("ConnectionList::sendOne " << desc << frame.str());
+  cn->send(frame.getMessage(cn), SendResult<C>{ cn, this, desc }, marker);
 }
 
 template void ConnectionList::sendOne<std::shared_ptr<WsServer::Connection>>(
@@ -325,6 +407,12 @@ template void ConnectionList::sendOne<std::shared_ptr<WsServer::Connection>>(
 template void ConnectionList::sendOne<std::shared_ptr<WssServer::Connection>>(
   const std::string &data, const char *desc,
   const std::shared_ptr<WssServer::Connection> &cn);
+template void ConnectionList::sendOne<std::shared_ptr<WsServer::Connection>>(
+  const SharedFrame &frame, const char *desc,
+  const std::shared_ptr<WsServer::Connection> &cn);
+template void ConnectionList::sendOne<std::shared_ptr<WssServer::Connection>>(
+  const SharedFrame &frame, const char *desc,
+  const std::shared_ptr<WssServer::Connection> &cn);
 
 void SingleEntryFollow::passData(const TimeSpec &ts)
 {
@@ -344,7 +432,7 @@ void SingleEntryFollow::passData(const TimeSpec &ts)
 
   std::stringstream buffer;
   master->codeData(buffer, r);
-  sendAll(buffer.str(), "channel data");
+  sendAll(SharedFrame(buffer.str()), "channel data");
 }
 
 void SingleEntryFollow::close(const char *reason, int status)
@@ -41,6 +41,46 @@ using WssServer = SimpleWeb::SocketServer<SimpleWeb::WSS>;
 class WebSocketsServerBase;
 template <typename Encoder, typename Decoder> class WebSocketsServer;
 
+/** Encoded message, shared by all connections it is sent to.
+
+    Channel data is encoded once (in JSON or msgpack, depending on the
+    server), and stored in a frame. For each server type, the frame
+    creates a single outgoing websocket message, which is then queued
+    on all connections of that type, without further encoding or
+    copying. The frame is immutable after construction.
+*/
+class SharedFrame
+{
+  /** Encoded data */
+  std::string data;
+
+  /** Outgoing message, non-secure server, created when needed */
+  mutable std::shared_ptr<WsServer::OutMessage> message;
+
+  /** Outgoing message, secure server, created when needed */
+  mutable std::shared_ptr<WssServer::OutMessage> smessage;
+
+public:
+  /** Constructor
+
+      @param data   Encoded data, moved into the frame */
+  SharedFrame(std::string &&data);
+
+  /** Access the encoded data */
+  inline const std::string &str() const { return data; }
+
+  /** Outgoing message for a connection on the non-secure server */
+  const std::shared_ptr<WsServer::OutMessage> &
+  getMessage(const std::shared_ptr<WsServer::Connection> &c) const;
+
+  /** Outgoing message for a connection on the secure server */
+  const std::shared_ptr<WssServer::OutMessage> &
+  getMessage(const std::shared_ptr<WssServer::Connection> &c) const;
+};
+
+/** Pointer to a shared frame */
+typedef std::shared_ptr<const SharedFrame> frame_ptr;
+
 /** Base class for maintaining a set of websocket connections to send
     data to.
 
@@ -102,10 +142,17 @@ struct ConnectionList
   /** Send some string or data to all connections on the endpoint */
   void sendAll(const std::string &data, const char *desc);
 
+  /** Send an encoded frame to all connections on the endpoint */
+  void sendAll(const SharedFrame &frame, const char *desc);
+
   /** Send some string or data to specified connection */
   template <typename C>
   void sendOne(const std::string &data, const char *desc, const C &c);
 
+  /** Send an encoded frame to specified connection */
+  template <typename C>
+  void sendOne(const SharedFrame &frame, const char *desc, const C &c);
+
   /** Close the connections */
   void close(const char *reason, int status = 1000);
 
@@ -145,6 +192,16 @@ struct SingleEntryRead : public ConnectionList
   /** Flag to remember init state. */
   bool inactive;
 
+  /** Last encoded data, re-used when several clients request the
+      same sample */
+  frame_ptr last_frame;
+
+  /** Time of the data in last_frame */
+  DataTimeSpec last_frame_time;
+
+  /** Number of visible sets after encoding last_frame */
+  unsigned last_frame_sets;
+
   /** Constructor, based on entry id
 
       @param channelname Name of the channel.
@@ -171,6 +228,11 @@ struct SingleEntryRead : public ConnectionList
   /** Code data */
   template <typename C> void passData(const TimeSpec &ts, C &connection);
 
+  /** Return the encoded latest data, re-using the previous encoding
+      when the channel has no new data. Returns an empty pointer if
+      there is no data. */
+  frame_ptr currentFrame();
+
 private:
   /** Callback invoked when the token is valid. */
   void tokenValid(const TimeSpec &ts);
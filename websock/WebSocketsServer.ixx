@@ -332,42 +332,20 @@ bool WebSocketsServer<Encoder, Decoder>::_complete(S &server)
       return;
     }
 
-    // room for response
-    std::stringstream buf;
-    Encoder writer(buf);
-    try {
-      // create the reader
-      DCOReader r(em->second->datatype.c_str(), em->second->r_token);
-      DataTimeSpec dtd = r.timeSpec();
-      writer.StartObject(2);
-      writer.Key("tick");
-      writer.Uint(dtd.getValidityStart());
-      writer.Key("data");
-      writer.dco(r);
-    }
-    catch (const NoDataAvailable &e) {
+    // encoded data, shared with other clients reading the same sample
+    frame_ptr frame = em->second->currentFrame();
+    if (!frame) {
       /* DUECA websockets.
 
          There is no current data on the requested stream.
       */
       D_XTR("No data on " << em->second->r_token.getName()
                           << " sending empty {}");
-      writer.StartObject(0);
+      std::stringstream buf;
+      this->codeEmpty(buf);
+      frame.reset(new SharedFrame(buf.str()));
     }
-    writer.EndObject();
-    connection->send(
-      buf.str(),
-      [](const SimpleWeb::error_code &ec) {
-        if (ec) {
-          /* DUECA websockets.
-
-             Unexpected error in sending a message to a client for
-             the "current" URL
-          */
-          W_XTR("Error sending message " << ec);
-        }
-      },
-      writer.OpCode());
+    em->second->sendOne(*frame, "current data", connection);
   };
 
   current.on_error = [](shared_ptr<typename S::Connection> connection,
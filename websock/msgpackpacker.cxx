@@ -14,6 +14,7 @@
 
 #ifdef DUECA_WEBSOCK_WITH_MSGPACK
 
+#include <dueca/DCOtoMsgpack.hxx>
 #include <dueca/debug.h>
 // need a version >= 3 for the websock-msgpack code
 
@@ -109,6 +110,12 @@ template <> void writeAny<std::string>(mwriter_t &writer, const boost::any &val)
   writer.pack_str(l);
   writer.pack_str_body(boost::any_cast<std::string>(val).c_str(), l);
 }
+template <> void writeAny<smartstring>(mwriter_t &writer, const boost::any &val)
+{
+  size_t l = boost::any_cast<smartstring>(val).size();
+  writer.pack_str(l);
+  writer.pack_str_body(boost::any_cast<smartstring>(val).c_str(), l);
+}
 
 void code_value(msgpack::packer<std::ostream> &writer, const boost::any &val)
 {
@@ -131,6 +138,8 @@ void code_value(msgpack::packer<std::ostream> &writer, const boost::any &val)
     wmap[TYPEID(float)] = avfunction(writeAny<float>);
     wmap[TYPEID(double)] = avfunction(writeAny<double>);
     wmap[TYPEID(std::string)] = avfunction(writeAny<std::string>);
+    wmap[TYPEID(smartstring)] = avfunction(writeAny<smartstring>);
+    wmap[TYPEID(Dstring<5>)] = avfunction(writeAnyDstring<5>);
     wmap[TYPEID(Dstring<8>)] = avfunction(writeAnyDstring<8>);
     wmap[TYPEID(Dstring<16>)] = avfunction(writeAnyDstring<16>);
     wmap[TYPEID(Dstring<32>)] = avfunction(writeAnyDstring<32>);
@@ -147,6 +156,7 @@ void code_value(msgpack::packer<std::ostream> &writer, const boost::any &val)
        Failure to serialize a part of DCO object to XML due to a bad
        any_cast. */
     E_XTR("cannot serialize to msgpack, bad cast " << e.what());
+    writer.pack_nil();
   }
   catch (const std::out_of_range &e) {
     /* DUECA XML.
@@ -155,18 +165,29 @@ void code_value(msgpack::packer<std::ostream> &writer, const boost::any &val)
        to XML. Use other datatypes in your DCO, or try to get the serialize
        expanded. */
     E_XTR("No mapping to serialize type '" << val.type().name());
+    writer.pack_nil();
   }
   catch (const std::exception &e) {
     /* DUECA XML.
 
        Generic failure to serialize a DCO object to XML. */
     E_XTR("Cannot serialize to msgpack " << e.what());
+    writer.pack_nil();
   }
 }
 
 void code_dco(msgpack::packer<std::ostream> &writer,
               const CommObjectReader &reader)
 {
+  // typed coding, when the class provides this
+  const DCOMsgpackMetaFunctor *coder =
+    dynamic_cast<const DCOMsgpackMetaFunctor *>(
+      reader.findMetaFunctor("tomsgpack"));
+  if (coder) {
+    coder->toMsgpack(writer, reader.getObject(), code_dco);
+    return;
+  }
+
   // pack this object as a map
   writer.pack_map(reader.getNumMembers());
 